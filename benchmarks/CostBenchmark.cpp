@@ -0,0 +1,119 @@
+#include "processor/Factorizer.hpp"
+#include "terms/Cost.hpp"
+#include "terms/GeneralTerm.hpp"
+#include "terms/Index.hpp"
+#include "terms/IndexSpaceMeta.hpp"
+#include "terms/Tensor.hpp"
+#include "utils/IndexSpaceResolver.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace ct = Contractor::Terms;
+namespace cu = Contractor::Utils;
+namespace cp = Contractor::Processor;
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Mimics the arithmetic performed for every node of the factorization search: the cost of a contraction is obtained
+ * as a product of index space sizes, added to the cost so far and compared against the best cost known so far.
+ *
+ * @returns The time needed per iteration in nanoseconds
+ */
+template< typename cost_t > double benchmarkArithmetic(std::size_t iterations, cost_t &checksum) {
+	constexpr std::array< unsigned int, 4 > sizes = { 10, 100, 200, 37 };
+
+	cost_t best = 0;
+	for (std::size_t i = 0; i < 6; ++i) {
+		best *= 1000;
+		best += 999;
+	}
+
+	const Clock::time_point start = Clock::now();
+
+	cost_t costSoFar = 0;
+	for (std::size_t i = 0; i < iterations; ++i) {
+		cost_t cost = 1;
+		for (std::size_t j = 0; j < 6; ++j) {
+			cost *= sizes[(i + j) % sizes.size()];
+		}
+
+		costSoFar += cost;
+
+		if (costSoFar > best) {
+			checksum += costSoFar;
+			costSoFar = 0;
+		}
+	}
+
+	const Clock::time_point end = Clock::now();
+
+	checksum += costSoFar;
+
+	return std::chrono::duration< double, std::nano >(end - start).count() / iterations;
+}
+
+int main(int argc, const char **argv) {
+	const std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 10000000;
+
+	ct::Cost nativeChecksum                      = 0;
+	ct::Cost::multiprecision_t multiprecisionSum = 0;
+
+	const double multiprecisionTime = benchmarkArithmetic(iterations, multiprecisionSum);
+	const double nativeTime         = benchmarkArithmetic(iterations, nativeChecksum);
+
+	if (nativeChecksum.toMultiprecision() != multiprecisionSum) {
+		std::cerr << "Mismatching results: " << nativeChecksum << " vs. " << multiprecisionSum << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "Cost arithmetic (" << iterations << " iterations):\n";
+	std::cout << "  multiprecision: " << multiprecisionTime << " ns/iteration\n";
+	std::cout << "  Cost:           " << nativeTime << " ns/iteration\n";
+	std::cout << "  speedup:        " << multiprecisionTime / nativeTime << "\n";
+
+	// Factorize a Term that requires a considerable amount of search nodes
+	cu::IndexSpaceResolver resolver({
+		ct::IndexSpaceMeta("virtual", 'P', 100, ct::Index::Spin::Both),
+		ct::IndexSpaceMeta("occupied", 'H', 10, ct::Index::Spin::Both),
+		ct::IndexSpaceMeta("external", 'Q', 200, ct::Index::Spin::None),
+	});
+
+	auto index = [&resolver](const std::string &space, ct::Index::id_t id) {
+		return ct::Index(resolver.resolve(space), id, ct::Index::Type::None, ct::Index::Spin::None);
+	};
+
+	const ct::Index a = index("virtual", 0);
+	const ct::Index b = index("virtual", 1);
+	const ct::Index c = index("virtual", 2);
+	const ct::Index i = index("occupied", 0);
+	const ct::Index j = index("occupied", 1);
+	const ct::Index k = index("occupied", 2);
+	const ct::Index q = index("external", 0);
+	const ct::Index r = index("external", 1);
+
+	ct::GeneralTerm term(ct::Tensor("O", { a, i }), 1.0,
+						 { ct::Tensor("A", { a, q }), ct::Tensor("B", { q, b, j }), ct::Tensor("C", { b, k, r }),
+						   ct::Tensor("D", { r, c, i }), ct::Tensor("E", { c, j }), ct::Tensor("F", { k }),
+						   ct::Tensor("G", { j, k }) });
+
+	constexpr std::size_t repetitions = 20;
+	cp::Factorizer factorizer(resolver);
+
+	const Clock::time_point start = Clock::now();
+	for (std::size_t n = 0; n < repetitions; ++n) {
+		factorizer.clearCache();
+		factorizer.factorize(term);
+	}
+	const Clock::time_point end = Clock::now();
+
+	std::cout << "Factorization of a Term with " << term.size() << " Tensors:\n";
+	std::cout << "  " << std::chrono::duration< double, std::milli >(end - start).count() / repetitions
+			  << " ms/factorization (" << factorizer.getLastSearchStatistics().expandedNodes << " expanded nodes)\n";
+
+	return EXIT_SUCCESS;
+}
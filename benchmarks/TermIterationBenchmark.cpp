@@ -0,0 +1,96 @@
+#include "terms/BinaryTerm.hpp"
+#include "terms/GeneralTerm.hpp"
+#include "terms/Index.hpp"
+#include "terms/IndexSpaceMeta.hpp"
+#include "terms/Tensor.hpp"
+#include "utils/IndexSpaceResolver.hpp"
+#include "utils/Iterable.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ct = Contractor::Terms;
+namespace cu = Contractor::Utils;
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Visits every Tensor of the given Terms the given amount of times by means of the provided function, which
+ * obtains the range to iterate over from a Term
+ *
+ * @returns The time needed per visited Tensor in nanoseconds
+ */
+template< typename range_getter_t >
+double benchmarkIteration(const std::vector< const ct::Term * > &terms, std::size_t iterations,
+						  range_getter_t &&getRange, std::size_t &checksum) {
+	std::size_t visited = 0;
+
+	const Clock::time_point start = Clock::now();
+
+	for (std::size_t i = 0; i < iterations; ++i) {
+		for (const ct::Term *currentTerm : terms) {
+			for (const ct::Tensor &currentTensor : getRange(*currentTerm)) {
+				checksum += currentTensor.getIndices().size();
+				++visited;
+			}
+		}
+	}
+
+	const Clock::time_point end = Clock::now();
+
+	return std::chrono::duration< double, std::nano >(end - start).count() / visited;
+}
+
+int main(int argc, const char **argv) {
+	const std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+	cu::IndexSpaceResolver resolver({
+		ct::IndexSpaceMeta("virtual", 'P', 100, ct::Index::Spin::Both),
+		ct::IndexSpaceMeta("occupied", 'H', 10, ct::Index::Spin::Both),
+	});
+
+	auto index = [&resolver](const std::string &space, ct::Index::id_t id) {
+		return ct::Index(resolver.resolve(space), id, ct::Index::Type::None, ct::Index::Spin::None);
+	};
+
+	const ct::Index a = index("virtual", 0);
+	const ct::Index b = index("virtual", 1);
+	const ct::Index i = index("occupied", 0);
+	const ct::Index j = index("occupied", 1);
+
+	const ct::GeneralTerm general(ct::Tensor("O", { a, i }), 1.0,
+								  { ct::Tensor("A", { a, b }), ct::Tensor("B", { b, j }), ct::Tensor("C", { j, i }),
+									ct::Tensor("D", { a, b, i, j }), ct::Tensor("E", { b, j, a, i }) });
+	const ct::BinaryTerm binary(ct::Tensor("O", { a, i }), 1.0, ct::Tensor("A", { a, b }), ct::Tensor("B", { b, i }));
+
+	std::size_t spanChecksum     = 0;
+	std::size_t iterableChecksum = 0;
+
+	for (const auto &[name, term] : { std::make_pair("GeneralTerm", static_cast< const ct::Term * >(&general)),
+									  std::make_pair("BinaryTerm", static_cast< const ct::Term * >(&binary)) }) {
+		const std::vector< const ct::Term * > terms = { term };
+
+		const double iterableTime = benchmarkIteration(
+			terms, iterations,
+			[](const ct::Term &term) { return Contractor::Iterable< const ct::Tensor >(term.getTensors()); },
+			iterableChecksum);
+		const double spanTime = benchmarkIteration(
+			terms, iterations, [](const ct::Term &term) { return term.getTensors(); }, spanChecksum);
+
+		std::cout << "Iterating over a " << name << " with " << term->size() << " Tensors (" << iterations
+				  << " iterations):\n";
+		std::cout << "  Iterable: " << iterableTime << " ns/Tensor\n";
+		std::cout << "  Span:     " << spanTime << " ns/Tensor\n";
+		std::cout << "  speedup:  " << iterableTime / spanTime << "\n";
+	}
+
+	if (spanChecksum != iterableChecksum) {
+		std::cerr << "Mismatching results: " << spanChecksum << " vs. " << iterableChecksum << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -30,6 +30,9 @@ else()
 	endif()
 endif()
 
+# Threads (used for parallelizing the factorization)
+find_package(Threads REQUIRED)
+
 # nlohmann-JSON
 FetchContent_Declare(
 	json
@@ -18,6 +18,8 @@ enum ExitCodes {
 	INVALID_TERM_SELECTED,
 	UNDEFINED_TENSOR_USED,
 	INVALID_TERM_PRODUCED,
+	INVALID_COMMANDLINE_OPTION_VALUE,
+	INFEASIBLE_FACTORIZATION,
 };
 // clang-format on
 
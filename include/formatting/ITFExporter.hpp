@@ -56,9 +56,9 @@ protected:
 	std::string getSpinString(const std::vector< std::reference_wrapper< const Terms::Index > > &indices);
 	char getIndexName(const Terms::Index &index) const;
 	std::string getIndexPatternString(const Terms::Tensor &tensor) const;
-	std::string getIndexPatternString(const std::vector< Terms::Index > &indices) const;
+	std::string getIndexPatternString(const Terms::IndexList &indices) const;
 	void writeTensorName(const std::string_view &name);
-	void writeIndexSequence(const std::vector< Terms::Index > &indices);
+	void writeIndexSequence(const Terms::IndexList &indices);
 	void writeIndexSequence(const std::vector< std::reference_wrapper< const Terms::Index > > &indices);
 };
 
@@ -18,6 +18,7 @@
 
 namespace Contractor::Terms {
 class Term;
+class CostPolynomial;
 class IndexSubstitution;
 class IndexSpaceMeta;
 class TensorDecomposition;
@@ -77,6 +78,7 @@ public:
 	void printTensorType(const Terms::Tensor &tensor, const Utils::IndexSpaceResolver &resolver);
 	void printSymmetries(const Terms::Tensor &tensor);
 	void printScaling(const Terms::Term::FormalScalingMap &scaling, const Utils::IndexSpaceResolver &resolver);
+	void printCost(const Terms::CostPolynomial &cost, const Utils::IndexSpaceResolver &resolver);
 
 	void printHeadline(const std::string_view headline);
 
@@ -2,10 +2,22 @@
 #define CONTRACTOR_PROCESSOR_FACTORIZER_HPP_
 
 #include "terms/BinaryTerm.hpp"
+#include "terms/CostPolynomial.hpp"
 #include "terms/GeneralTerm.hpp"
 #include "terms/Tensor.hpp"
 
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Contractor::Utils {
@@ -14,9 +26,105 @@ class IndexSpaceResolver;
 
 namespace Contractor::Processor {
 
+/**
+ * Exception thrown if a Term can't be factorized under the constraints imposed on the Factorizer
+ */
+class FactorizationException : public std::exception {
+public:
+	FactorizationException(const std::string_view msg, const Terms::GeneralTerm &term);
+
+	const char *what() const noexcept override;
+
+	/**
+	 * @returns The Term that couldn't be factorized
+	 */
+	const Terms::GeneralTerm &getTerm() const;
+
+protected:
+	std::string m_msg;
+	Terms::GeneralTerm m_term;
+};
+
 class Factorizer {
 public:
-	Factorizer(const Utils::IndexSpaceResolver &resolver);
+	/**
+	 * The different strategies that can be used in order to find the optimal factorization of a Term
+	 */
+	enum class Engine {
+		/**
+		 * Recursively tries every possible order of pairwise contractions
+		 */
+		Exhaustive,
+		/**
+		 * Determines the optimal cost for every subset of the Term's Tensors (memoized by bitmask) and only constructs
+		 * the winning sequence of contractions explicitly. This produces the same result as the exhaustive search.
+		 */
+		DynamicProgramming,
+	};
+
+	/**
+	 * The different criteria by which one of the Pareto-optimal factorizations of a Term can be chosen
+	 */
+	enum class Policy {
+		/**
+		 * Pick the factorization with the lowest cost (and the smallest biggest intermediate among those)
+		 */
+		MinimumCost,
+		/**
+		 * Pick the factorization with the smallest biggest intermediate (and the lowest cost among those)
+		 */
+		MinimumMemory,
+		/**
+		 * Pick the factorization for which the product of cost and biggest intermediate is minimal
+		 */
+		Balanced,
+	};
+
+	/**
+	 * A factorization that is not dominated by any other factorization of the same Term, i.e. every other
+	 * factorization has either a higher cost or a bigger biggest intermediate
+	 */
+	struct ParetoPoint {
+		std::vector< Terms::BinaryTerm > terms;
+		Terms::ContractionResult::cost_t cost;
+		Terms::ContractionResult::cost_t biggestIntermediate;
+		Terms::ContractionResult::cost_t reuseSavings;
+	};
+
+	/**
+	 * Statistics about the search performed in order to find the optimal factorization of a Term
+	 */
+	struct SearchStatistics {
+		/**
+		 * The amount of (partial) contraction sequences that have been explored. For the DynamicProgramming engine
+		 * this is the amount of evaluated subset splits.
+		 */
+		std::size_t expandedNodes = 0;
+		/**
+		 * The amount of contractions that have been discarded because they could not lead to a better factorization
+		 * than the best one known at that point
+		 */
+		std::size_t prunedNodes = 0;
+	};
+
+	/**
+	 * A lookup of a Term's signature in the cache of found factorizations
+	 */
+	struct CacheLookup {
+		std::string signature;
+		/**
+		 * The size point (see setSizePoints) whose Factorizer performed the lookup, starting at 1. 0 refers to this
+		 * Factorizer's own index space sizes.
+		 */
+		std::size_t sizePoint = 0;
+		bool hit              = false;
+		/**
+		 * The statistics of the search that has been performed because the lookup missed
+		 */
+		SearchStatistics statistics;
+	};
+
+	Factorizer(const Utils::IndexSpaceResolver &resolver, Engine engine = Engine::Exhaustive);
 
 	const std::vector< Terms::BinaryTerm > &factorize(const Terms::GeneralTerm &term,
 													  const std::vector< Terms::BinaryTerm > &previousTerms = {});
@@ -25,18 +133,470 @@ public:
 
 	Terms::ContractionResult::cost_t getLastBiggestIntermediateSize() const;
 
+	/**
+	 * @returns The cost of the last factorization as a polynomial in the sizes of the index spaces (not including the
+	 * cost of intermediates that are reused from previous Terms)
+	 */
+	const Terms::CostPolynomial &getLastCostPolynomial() const;
+
+	Engine getEngine() const;
+
+	void setEngine(Engine engine);
+
+	/**
+	 * @returns The amount of factorizations that could be taken from the cache (since the last call to clearCache)
+	 */
+	std::size_t getCacheHits() const;
+
+	/**
+	 * @returns The amount of factorizations that had to be searched for (since the last call to clearCache)
+	 */
+	std::size_t getCacheMisses() const;
+
+	/**
+	 * Forgets about all previously found factorizations
+	 */
+	void clearCache();
+
+	/**
+	 * Adds all cached factorizations of the given Factorizer that are not yet known to this one
+	 */
+	void mergeCache(const Factorizer &other);
+
+	/**
+	 * @returns The amount of cached factorizations
+	 */
+	std::size_t getCacheSize() const;
+
+	/**
+	 * Writes all cached factorizations along with the index spaces and the cost model (symmetry- and layout-awareness)
+	 * their cost has been determined with to the given stream
+	 */
+	void writeCache(std::ostream &stream) const;
+
+	/**
+	 * Reads cached factorizations as written by writeCache from the given stream and adds them to this Factorizer's
+	 * cache. Nothing is read if the cache has been created for different index spaces (or different sizes thereof) or
+	 * with a different cost model.
+	 *
+	 * @returns Whether the stream contained a cache usable with the current index spaces and cost model
+	 */
+	bool readCache(std::istream &stream);
+
+	std::size_t getJobs() const;
+
+	/**
+	 * Sets the amount of threads that may be used for the search of a single Term's factorization (only used by the
+	 * Exhaustive engine). The result does not depend on this setting but the search statistics might.
+	 */
+	void setJobs(std::size_t jobs);
+
+	/**
+	 * @returns Statistics about the search performed during the last factorization
+	 */
+	const SearchStatistics &getLastSearchStatistics() const;
+
+	/**
+	 * @returns The cache lookups performed during the last factorization (in the order in which they have happened).
+	 * The search statistics of the last factorization include those of the lookups that missed.
+	 */
+	const std::vector< CacheLookup > &getLastCacheLookups() const;
+
+	bool isReuseAware() const;
+
+	/**
+	 * Sets whether contractions producing an intermediate that one of the previous Terms (passed to factorize) computes
+	 * already are considered to be free. This can lead to factorizations that are more expensive on their own but that
+	 * share more intermediates with the previous Terms.
+	 */
+	void setReuseAware(bool reuseAware);
+
+	/**
+	 * @returns The cost that has not been accounted for in the last factorization because the respective intermediates
+	 * are computed by one of the previous Terms already (always zero unless the Factorizer is reuse-aware)
+	 */
+	Terms::ContractionResult::cost_t getLastReuseSavings() const;
+
+	Terms::ContractionResult::cost_t getMaxIntermediateSize() const;
+
+	/**
+	 * Sets the maximum amount of elements an intermediate may have. Factorizations producing a bigger intermediate are
+	 * discarded (the Term's result Tensor itself is exempt from this limit). By default, there is no such limit.
+	 */
+	void setMaxIntermediateSize(const Terms::ContractionResult::cost_t &maxSize);
+
+	/**
+	 * @returns Whether the size of intermediates is limited
+	 */
+	bool hasIntermediateSizeLimit() const;
+
+	Policy getPolicy() const;
+
+	/**
+	 * Sets the policy by which the returned factorization is chosen from the Pareto front of all factorizations (in
+	 * terms of cost and biggest intermediate). Any policy other than MinimumCost implies that the Pareto front is
+	 * determined for every factorized Term.
+	 */
+	void setPolicy(Policy policy);
+
+	bool isRecordingParetoFront() const;
+
+	/**
+	 * Sets whether the Pareto front of all factorizations (in terms of cost and biggest intermediate) shall be
+	 * determined for every factorized Term, even if the policy doesn't require it
+	 */
+	void setRecordParetoFront(bool record);
+
+	/**
+	 * @returns The Pareto-optimal factorizations of the last factorized Term, sorted by increasing cost (and thus by
+	 * decreasing size of the biggest intermediate). Empty unless the Pareto front has been determined.
+	 */
+	const std::vector< ParetoPoint > &getLastParetoFront() const;
+
+	/**
+	 * @returns The position of the returned factorization within the last Pareto front
+	 */
+	std::size_t getLastParetoChoice() const;
+
+	/**
+	 * @returns The amount of additional index space sizes at which factorizations are evaluated
+	 */
+	std::size_t getSizePointCount() const;
+
+	/**
+	 * Sets additional index space sizes (in the form of resolvers for the same index spaces as the one this
+	 * Factorizer has been created with) at which factorizations shall be evaluated. For every Term, the optimal
+	 * factorizations for all of these sizes (and for the sizes of this Factorizer's resolver) are determined and the
+	 * one whose cost exceeds the respective optimum by the smallest factor across all sizes is chosen. The
+	 * intermediate size limit only applies to the sizes of this Factorizer's resolver. Not used when determining the
+	 * Pareto front.
+	 */
+	void setSizePoints(std::vector< Utils::IndexSpaceResolver > sizePoints);
+
+	/**
+	 * @returns The biggest factor by which the cost of the last factorization exceeds the optimal cost at any of the
+	 * size points (1 if there are no additional size points)
+	 */
+	double getLastWorstCostRatio() const;
+
+	bool isSymmetryAware() const;
+
+	/**
+	 * Sets whether the cost of a contraction shall account for the permutational symmetry of the involved Tensors (see
+	 * Tensor::getSymmetryReducedCost), i.e. whether factorizations are optimized for a backend that only
+	 * computes symmetry-unique elements. Symmetry-aware factorizations always use the Exhaustive engine and ignore the
+	 * size points (whose evaluation relies on cost polynomials which can't express the symmetry reduction).
+	 */
+	void setSymmetryAware(bool symmetryAware);
+
+	/**
+	 * @returns The cost of the last factorization if the permutational symmetry of the involved Tensors is not exploited
+	 * (equals getLastFactorizationCost unless the Factorizer is symmetry-aware)
+	 */
+	Terms::ContractionResult::cost_t getLastDenseCost() const;
+
+	/**
+	 * @returns The cost of the last factorization if the permutational symmetry of the involved Tensors is exploited
+	 * (equals getLastFactorizationCost if the Factorizer is symmetry-aware)
+	 */
+	Terms::ContractionResult::cost_t getLastSymmetryReducedCost() const;
+
+	bool isLayoutAware() const;
+
+	/**
+	 * Sets whether factorizations shall be mapped onto GEMMs with as little explicit transposition as possible (see
+	 * getTransposeCost). If set, ties between equally expensive factorizations (with equally big intermediates) are
+	 * broken in favor of the one requiring less transposition and the Tensors' index sequences are chosen accordingly
+	 * (among the ones their symmetries allow). Layout-aware factorizations always use the Exhaustive engine.
+	 */
+	void setLayoutAware(bool layoutAware);
+
+	/**
+	 * @returns The amount of Tensor elements that have to be transposed in order to carry out the last factorization
+	 * by means of GEMMs
+	 */
+	Terms::ContractionResult::cost_t getLastTransposeCost() const;
+
 protected:
+	/**
+	 * Type used to represent a subset of the Tensors in a Term (the n-th bit refers to the n-th Tensor)
+	 */
+	using subset_t = std::uint32_t;
+
+	/**
+	 * A sequence of contractions in terms of positions in the list of remaining Tensors. The first Tensor in each
+	 * contraction is the left operand and the second one the right operand. Both are removed from the list and the
+	 * contraction's result is appended to it.
+	 */
+	using contraction_order_t = std::vector< std::pair< std::size_t, std::size_t > >;
+
+	/**
+	 * The outcome of a previous factorization of a Term with a given signature. The cost of the factorization is not
+	 * stored but recomputed whenever the factorization is replayed. The contraction order refers to the Term's Tensors
+	 * in their canonical order (see CanonicalLabelling::getOrder).
+	 */
+	struct CachedFactorization {
+		contraction_order_t order;
+	};
+
+	/**
+	 * Type used for storing the cached factorizations (by Term signature)
+	 */
+	using cache_t = std::unordered_map< std::string, CachedFactorization >;
+
+	/**
+	 * Version of the format produced by writeCache. Needs to be incremented whenever the format or the meaning of the
+	 * Term signatures or contraction orders changes.
+	 */
+	static constexpr unsigned int cacheFormatVersion = 5;
+
+	/**
+	 * The minimum amount of Tensors a Term has to contain in order for the search to be distributed across threads.
+	 * For smaller Terms, the overhead of doing so outweighs the benefits.
+	 */
+	static constexpr std::size_t minTensorsForConcurrentSearch = 4;
+
+	/**
+	 * The best cost found so far by any of the threads taking part in a concurrent search
+	 */
+	struct SharedBound {
+		std::mutex mutex;
+		Terms::ContractionResult::cost_t cost;
+	};
+
+	/**
+	 * The quantities by which the quality of a (partial) factorization is judged
+	 */
+	struct SubsetCost {
+		Terms::ContractionResult::cost_t cost                = 0;
+		Terms::ContractionResult::cost_t biggestIntermediate = 0;
+
+		friend bool operator==(const SubsetCost &lhs, const SubsetCost &rhs) {
+			return lhs.cost == rhs.cost && lhs.biggestIntermediate == rhs.biggestIntermediate;
+		}
+
+		friend bool operator<(const SubsetCost &lhs, const SubsetCost &rhs) {
+			return lhs.cost < rhs.cost || (lhs.cost == rhs.cost && lhs.biggestIntermediate < rhs.biggestIntermediate);
+		}
+	};
+
 	const Utils::IndexSpaceResolver &m_resolver;
+	Engine m_engine;
+	std::size_t m_jobs = 1;
 	Terms::ContractionResult::cost_t m_bestCost                = 0;
 	Terms::ContractionResult::cost_t m_biggestIntermediateSize = 0;
 	std::vector< Terms::BinaryTerm > m_bestFactorization;
+	contraction_order_t m_bestOrder;
+	contraction_order_t m_currentOrder;
+	cache_t m_cache;
+	std::size_t m_cacheHits   = 0;
+	std::size_t m_cacheMisses = 0;
+	SearchStatistics m_statistics;
+	std::vector< CacheLookup > m_cacheLookups;
+	/**
+	 * Whether the current best cost has been obtained from a greedy factorization (and not by the exhaustive search)
+	 */
+	bool m_incumbentIsSeed = false;
+	/**
+	 * The bound shared with the other threads, if this Factorizer takes part in a concurrent search
+	 */
+	SharedBound *m_sharedBound = nullptr;
+	bool m_reuseAware          = false;
+	/**
+	 * The previous Terms whose results may be reused by the current factorization (only populated if the Factorizer is
+	 * reuse-aware)
+	 */
+	std::vector< const Terms::BinaryTerm * > m_reusableTerms;
+	Terms::ContractionResult::cost_t m_currentReuseSavings = 0;
+	Terms::ContractionResult::cost_t m_bestReuseSavings    = 0;
+	Terms::ContractionResult::cost_t m_maxIntermediateSize =
+		std::numeric_limits< Terms::ContractionResult::cost_t >::max();
+	Policy m_policy            = Policy::MinimumCost;
+	bool m_recordParetoFront   = false;
+	std::vector< ParetoPoint > m_paretoFront;
+	std::size_t m_paretoChoice = 0;
+	Terms::CostPolynomial m_bestCostPolynomial;
+	/**
+	 * The additional index space sizes (shared between all copies of this Factorizer)
+	 */
+	std::shared_ptr< const std::vector< Utils::IndexSpaceResolver > > m_sizePoints;
+	/**
+	 * The Factorizers searching for the optimal factorization at the additional size points (one per point)
+	 */
+	std::vector< Factorizer > m_pointFactorizers;
+	double m_worstCostRatio = 1;
+	bool m_symmetryAware    = false;
+	Terms::ContractionResult::cost_t m_bestDenseCost           = 0;
+	Terms::ContractionResult::cost_t m_bestSymmetryReducedCost = 0;
+	bool m_layoutAware = false;
+	Terms::ContractionResult::cost_t m_bestTransposeCost = 0;
+
+	/**
+	 * The result indices that remain when contracting all Tensors in the respective subset with one another (indexed by
+	 * subset_t). Only populated while the DynamicProgramming engine is running.
+	 */
+	std::vector< Terms::Tensor::index_list_t > m_subsetIndices;
+	/**
+	 * Memo of the best way of contracting a given list of (already contracted) blocks of Tensors down to a single one
+	 */
+	std::map< std::vector< subset_t >, SubsetCost > m_completionMemo;
+
+	/**
+	 * Finds the optimal factorization of the given Term (respecting the current intermediate size limit) and stores it
+	 * as the best factorization
+	 */
+	void findOptimalFactorization(const Terms::GeneralTerm &term,
+								  const std::vector< Terms::BinaryTerm > &previousTerms);
+
+	/**
+	 * Determines the Pareto front of all factorizations of the given Term by repeatedly searching for the optimal
+	 * factorization while only admitting intermediates that are smaller than the biggest one of the previous optimum
+	 */
+	void findParetoFront(const Terms::GeneralTerm &term, const std::vector< Terms::BinaryTerm > &previousTerms);
+
+	/**
+	 * @returns The position of the factorization within the current Pareto front that the policy chooses
+	 */
+	std::size_t choosePoint() const;
+
+	/**
+	 * Determines the optimal factorization of the given Term for every size point and stores the one that performs
+	 * best across all size points as the best factorization
+	 */
+	void findRobustFactorization(const Terms::GeneralTerm &term,
+								 const std::vector< Terms::BinaryTerm > &previousTerms);
+
+	/**
+	 * @returns The cost of carrying out the given factorization as a polynomial in the index space sizes. Terms
+	 * computing the same intermediate as one of the reusable Terms are not accounted for. Their cost is added to
+	 * reuseSavings (if given) instead.
+	 */
+	Terms::CostPolynomial getCostPolynomial(const std::vector< Terms::BinaryTerm > &terms,
+											Terms::CostPolynomial *reuseSavings = nullptr) const;
+
+	/**
+	 * @returns The cost of carrying out the given factorization if the permutational symmetry of the involved Tensors
+	 * is exploited. Terms computing the same intermediate as one of the reusable Terms are not accounted for.
+	 */
+	Terms::ContractionResult::cost_t getSymmetryReducedCost(const std::vector< Terms::BinaryTerm > &terms) const;
+
+	/**
+	 * @returns The cost of the given contraction of the left with the right Tensor according to the cost model in use
+	 */
+	Terms::ContractionResult::cost_t getCost(const Terms::Tensor &left, const Terms::Tensor &right,
+											 const Terms::ContractionResult &result) const;
+
+	/**
+	 * Brings the index sequences of the Tensors in the given factorization into their final form (canonical, unless
+	 * the Factorizer is layout-aware)
+	 */
+	void finalizeIndexSequences(std::vector< Terms::BinaryTerm > &terms) const;
+
+	/**
+	 * @returns The amount of Tensor elements that have to be transposed in order to carry out the given factorization
+	 * by means of GEMMs
+	 */
+	Terms::ContractionResult::cost_t getTotalTransposeCost(const std::vector< Terms::BinaryTerm > &terms) const;
 
 	bool doFactorize(const Terms::ContractionResult::cost_t &costSoFar,
 					 const Terms::ContractionResult::cost_t &biggestIntermediate, std::vector< Terms::Tensor > &tensors,
 					 std::vector< Terms::BinaryTerm > &factorizedTerms, const Terms::GeneralTerm &term,
 					 const std::vector< Terms::BinaryTerm > &previousTerms);
+
+	/**
+	 * Performs the same search as doFactorize but distributes the different choices for the first contraction across
+	 * multiple threads
+	 */
+	bool doFactorizeConcurrently(std::vector< Terms::Tensor > &tensors, const Terms::GeneralTerm &term,
+								 const std::vector< Terms::BinaryTerm > &previousTerms);
+
+	/**
+	 * Contracts the i-th (as the left operand) with the j-th of the given Tensors and continues the search from there
+	 * (unless the resulting path can be pruned)
+	 *
+	 * @returns Whether a better factorization than the best one known so far has been found
+	 */
+	bool tryContraction(std::size_t i, std::size_t j, const Terms::ContractionResult::cost_t &costSoFar,
+						const Terms::ContractionResult::cost_t &biggestIntermediate,
+						std::vector< Terms::Tensor > &tensors, std::vector< Terms::BinaryTerm > &factorizedTerms,
+						const Terms::GeneralTerm &term, const std::vector< Terms::BinaryTerm > &previousTerms);
+
+	/**
+	 * Carries out the given sequence of contractions on the Tensors of the given Term and stores the result as the best
+	 * factorization along with its cost and the size of its biggest intermediate
+	 */
+	void replayFactorization(const contraction_order_t &order, const Terms::GeneralTerm &term,
+							 const std::vector< Terms::BinaryTerm > &previousTerms);
+
+	/**
+	 * @returns Whether the given sequence of contractions can be carried out on a Term with the given amount of Tensors
+	 * and leaves only a single Tensor behind
+	 */
+	static bool isValidOrder(const contraction_order_t &order, std::size_t tensorCount);
+
+	void doFactorizeDynamically(const Terms::GeneralTerm &term, const std::vector< Terms::BinaryTerm > &previousTerms);
+
+	/**
+	 * @returns The cost and biggest intermediate of the cheapest way of contracting the given blocks down to a single
+	 * Tensor
+	 */
+	const SubsetCost &getOptimalCompletion(const std::vector< subset_t > &blocks);
+
+	/**
+	 * @returns The cost of contracting the Tensor representing the left subset with the one representing the right
+	 * subset
+	 */
+	Terms::ContractionResult::cost_t getContractionCost(subset_t left, subset_t right) const;
+
+	/**
+	 * @returns The cost that a (partial) factorization must not exceed in order to be worth exploring further
+	 */
+	Terms::ContractionResult::cost_t getPruningBound() const;
+
+	/**
+	 * @returns A lower bound for the cost of contracting the given Tensors (plus the additional one) down to a single
+	 * Tensor
+	 */
+	Terms::ContractionResult::cost_t getLowerBound(const std::vector< Terms::Tensor > &tensors,
+												   const Terms::Tensor &additionalTensor) const;
+
+	/**
+	 * @returns The cost and biggest intermediate of the factorization obtained by always performing the cheapest
+	 * contraction next (that doesn't exceed the intermediate size limit). If there is no such factorization, the
+	 * returned cost is the maximum representable value.
+	 */
+	SubsetCost getGreedyFactorizationCost(std::vector< Terms::Tensor > tensors) const;
+
+	/**
+	 * @returns The amount of elements in a Tensor carrying the given indices
+	 */
+	Terms::ContractionResult::cost_t getElementCount(const Terms::Tensor::index_list_t &indices) const;
+
+	/**
+	 * Creates the BinaryTerm representing the contraction of the given Tensors (whose result is described by the
+	 * given ContractionResult) and makes sure that the result Tensor's name does not clash with any of the Terms
+	 * produced so far. If the produced Term computes the same intermediate as one of the reusable Terms, it adopts
+	 * that Term's result Tensor instead and reusesPreviousTerm (if given) is set to true.
+	 */
+	Terms::BinaryTerm createContractionTerm(Terms::ContractionResult &result, const Terms::Tensor &left,
+											const Terms::Tensor &right, bool isLastContraction,
+											const std::vector< Terms::BinaryTerm > &factorizedTerms,
+											const std::vector< Terms::BinaryTerm > &previousTerms,
+											bool *reusesPreviousTerm = nullptr) const;
+
+	/**
+	 * Turns the last of the given Terms into the one producing the original Term's result
+	 */
+	void finalizeFactorization(std::vector< Terms::BinaryTerm > &factorizedTerms,
+							   const Terms::GeneralTerm &term) const;
 };
 
+std::ostream &operator<<(std::ostream &stream, Factorizer::Engine engine);
+std::istream &operator>>(std::istream &stream, Factorizer::Engine &engine);
+
+std::ostream &operator<<(std::ostream &stream, Factorizer::Policy policy);
+std::istream &operator>>(std::istream &stream, Factorizer::Policy &policy);
+
 }; // namespace Contractor::Processor
 
 #endif // CONTRACTOR_PROCESSOR_FACTORIZER_HPP_
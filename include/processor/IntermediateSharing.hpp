@@ -0,0 +1,44 @@
+#ifndef CONTRACTOR_PROCESSOR_INTERMEDIATESHARING_HPP_
+#define CONTRACTOR_PROCESSOR_INTERMEDIATESHARING_HPP_
+
+#include "processor/PrinterWrapper.hpp"
+#include "terms/BinaryTerm.hpp"
+#include "terms/Tensor.hpp"
+#include "terms/TermGroup.hpp"
+
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace Contractor::Utils {
+class IndexSpaceResolver;
+};
+
+namespace Contractor::Processor {
+
+/**
+ * @returns The amount of operations required for carrying out the given Term
+ */
+Terms::ContractionResult::cost_t getOperationCount(const Terms::BinaryTerm &term,
+												   const Utils::IndexSpaceResolver &resolver);
+
+/**
+ * Finds intermediates that are calculated in multiple TermGroups (up to index renaming, a prefactor and a permutation
+ * of the result's indices, e.g. X'[ji] = - X[ij]) and removes all but the first calculation of each such intermediate.
+ * The later groups are rewritten to use the intermediate calculated in the earlier group instead.
+ *
+ * @param groups The TermGroups to process
+ * @param resolver The resolver used to determine the cost of the eliminated calculations
+ * @param isIntermediate Predicate that tells whether a Tensor with the given name is an intermediate (as opposed to
+ * base or result Tensors which must not be touched)
+ * @param printer The printer to report the performed eliminations to
+ * @returns The amount of operations saved by the performed eliminations
+ */
+Terms::ContractionResult::cost_t shareIntermediates(std::vector< Terms::BinaryTermGroup > &groups,
+													const Utils::IndexSpaceResolver &resolver,
+													const std::function< bool(std::string_view) > &isIntermediate,
+													PrinterWrapper printer = {});
+
+}; // namespace Contractor::Processor
+
+#endif // CONTRACTOR_PROCESSOR_INTERMEDIATESHARING_HPP_
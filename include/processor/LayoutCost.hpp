@@ -0,0 +1,47 @@
+#ifndef CONTRACTOR_PROCESSOR_LAYOUTCOST_HPP_
+#define CONTRACTOR_PROCESSOR_LAYOUTCOST_HPP_
+
+#include "terms/BinaryTerm.hpp"
+#include "terms/Tensor.hpp"
+
+namespace Contractor::Utils {
+class IndexSpaceResolver;
+};
+
+namespace Contractor::Processor {
+
+/**
+ * Estimates how much data has to be permuted explicitly in order to carry out the given Term as a matrix-matrix
+ * multiplication (GEMM). A contraction maps onto a GEMM (possibly with transposed operands) without any additional
+ * work, if the left Tensor's indices consist of a block of result indices and a block of contracted indices, the right
+ * Tensor's indices consist of a block of contracted indices and a block of result indices and the result Tensor's
+ * indices consist of the left and the right block of result indices (blocks may appear in any order but the indices
+ * within them have to be in the same order wherever they appear). Every Tensor not fitting this scheme has to be
+ * transposed before (or after) the GEMM. For Terms consisting of a single Tensor, a transposition is needed if the
+ * result indices are not in the same order as in that Tensor.
+ *
+ * @returns The (minimal) amount of Tensor elements that have to be transposed
+ */
+Terms::ContractionResult::cost_t getTransposeCost(const Terms::BinaryTerm &term,
+												  const Utils::IndexSpaceResolver &resolver);
+
+/**
+ * @returns The transposition cost (see above) of computing a Tensor with the given result indices from a single Tensor
+ * with the given operand indices
+ */
+Terms::ContractionResult::cost_t getTransposeCost(const Terms::Tensor::index_list_t &resultIndices,
+												  const Terms::Tensor::index_list_t &operandIndices,
+												  const Utils::IndexSpaceResolver &resolver);
+
+/**
+ * @returns The transposition cost (see above) of computing a Tensor with the given result indices by contracting
+ * Tensors with the given left and right indices
+ */
+Terms::ContractionResult::cost_t getTransposeCost(const Terms::Tensor::index_list_t &resultIndices,
+												  const Terms::Tensor::index_list_t &leftIndices,
+												  const Terms::Tensor::index_list_t &rightIndices,
+												  const Utils::IndexSpaceResolver &resolver);
+
+}; // namespace Contractor::Processor
+
+#endif // CONTRACTOR_PROCESSOR_LAYOUTCOST_HPP_
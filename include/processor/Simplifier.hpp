@@ -2,19 +2,30 @@
 #define CONTRACTOR_PROCESSOR_SIMPLIFIER_HPP_
 
 #include "processor/PrinterWrapper.hpp"
+#include "terms/BinaryTerm.hpp"
+#include "terms/CanonicalLabelling.hpp"
 #include "terms/CompositeTerm.hpp"
+#include "terms/IndexSubstitution.hpp"
+#include "terms/Tensor.hpp"
 #include "terms/TensorSubstitution.hpp"
 #include "terms/Term.hpp"
 #include "terms/TermGroup.hpp"
-#include "utils/SortUtils.hpp"
 
 #include <algorithm>
 #include <functional>
+#include <map>
 #include <numeric>
+#include <optional>
 #include <sstream>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
+namespace Contractor::Utils {
+class IndexSpaceResolver;
+};
+
 namespace Contractor::Processor {
 
 namespace details {
@@ -71,12 +82,269 @@ namespace details {
 	static void sumCompatible(Terms::Term &original, Terms::Term &duplicate) {
 		original.setPrefactor(original.getPrefactor() + duplicate.getPrefactor());
 	}
+
+	/**
+	 * Rewrites Terms that are equivalent to an earlier Term in the given list (according to their canonical labelling)
+	 * but that are not written in the exact same way, such that they use the same Tensors as that earlier Term.
+	 *
+	 * @returns Whether any Term has been rewritten
+	 */
+	template< typename term_t > bool unifyEquivalentTerms(std::vector< term_t > &terms, PrinterWrapper &printer) {
+		bool changed = false;
+
+		// Equivalent Terms have the same result and involve the same Tensors. This is used to avoid determining the
+		// canonical labelling of Terms that can't be equivalent to any other Term anyway.
+		auto getTensorHash = [](const term_t &term) {
+			std::size_t hash = term.getResult().getHash();
+			for (const Terms::Tensor &currentTensor : term.getTensors()) {
+				hash += currentTensor.getInternedName().hash();
+			}
+
+			return hash;
+		};
+
+		std::unordered_map< std::size_t, std::size_t > bucketIDs;
+		std::vector< std::vector< std::size_t > > buckets;
+		for (std::size_t i = 0; i < terms.size(); ++i) {
+			auto [it, inserted] = bucketIDs.insert({ getTensorHash(terms[i]), buckets.size() });
+
+			if (inserted) {
+				buckets.emplace_back();
+			}
+
+			buckets[it->second].push_back(i);
+		}
+
+		for (const std::vector< std::size_t > &indices : buckets) {
+			if (indices.size() < 2) {
+				continue;
+			}
+
+			// Terms with the same key (and the same result Tensor) are equivalent. For every key, the first Term is
+			// kept and the later ones are rewritten to use the same Tensors.
+			std::vector< Terms::CanonicalLabelling > labellings;
+			std::map< Terms::CanonicalLabelling::key_t, std::vector< std::size_t > > representatives;
+			labellings.reserve(indices.size());
+
+			for (std::size_t i = 0; i < indices.size(); ++i) {
+				term_t &currentTerm = terms[indices[i]];
+
+				labellings.emplace_back(currentTerm);
+
+				// The key doesn't contain the names of the result Tensor and of its indices
+				std::vector< std::size_t > &candidates = representatives[labellings[i].getKey()];
+				auto representativeIt = std::find_if(candidates.begin(), candidates.end(), [&](std::size_t other) {
+					return terms[indices[other]].getResult() == currentTerm.getResult();
+				});
+
+				if (representativeIt == candidates.end()) {
+					candidates.push_back(i);
+					continue;
+				}
+
+				const term_t &otherTerm = terms[indices[*representativeIt]];
+
+				if (compatible_term{}(otherTerm, currentTerm)) {
+					// Terms that are written in the exact same way will be summed up anyway
+					continue;
+				}
+
+				// Both Terms are equal to the same canonical form (apart from the factors introduced by bringing them
+				// into that form, which are either 1 or -1)
+				term_t rewritten = otherTerm;
+				rewritten.setPrefactor(currentTerm.getPrefactor() * labellings[i].getFactor()
+									   * labellings[*representativeIt].getFactor());
+
+				printer << "Term " << currentTerm << " is equivalent to\n     " << rewritten << "\n";
+
+				currentTerm = std::move(rewritten);
+				changed     = true;
+			}
+		}
+
+		return changed;
+	}
 }; // namespace details
 
 bool canonicalizeIndexIDs(Terms::Term &term);
 
 bool canonicalizeIndexSequences(Terms::Term &term);
 
+/**
+ * Chooses the index sequences of the given Term's Tensors such that carrying out the Term as a GEMM requires the least
+ * amount of transposition (see getTransposeCost), considering all sequences that the Tensors' symmetries allow. Ties
+ * are resolved in favor of the canonical sequences.
+ *
+ * @param keepResultSequence Whether the index sequence of the Term's result Tensor must not be changed. This is needed
+ * for Terms that produce a result that is referenced elsewhere under its given index sequence.
+ * @returns Whether the Term has been modified
+ */
+bool canonicalizeIndexSequences(Terms::BinaryTerm &term, const Utils::IndexSpaceResolver &resolver,
+								bool keepResultSequence = false);
+
+/**
+ * Searches for a relation between the given composites that only holds if the indices of the composite's result Tensor
+ * are permuted, e.g. X[ijak] = - X'[jiak]. Only indices of the same space, type and spin are exchanged.
+ *
+ * @returns The substitution that expresses the (permuted) result Tensor of composite in terms of the result Tensor
+ * of other or nothing, if there is no such relation
+ */
+template< typename term_t >
+std::optional< Terms::TensorSubstitution > findPermutedRelation(const Terms::CompositeTerm< term_t > &composite,
+																const Terms::CompositeTerm< term_t > &other) {
+	const Terms::Tensor &result                = composite.getResult();
+	const Terms::Tensor &otherResult           = other.getResult();
+	const Terms::Tensor::index_list_t &indices = result.getIndices();
+
+	if (composite.size() != other.size() || indices.size() < 2 || indices.size() != otherResult.getIndices().size()
+		|| !std::is_permutation(indices.begin(), indices.end(), otherResult.getIndices().begin())) {
+		return {};
+	}
+
+	// Renaming indices never changes which Tensors are involved. Thus we can rule out most composites without having
+	// to try any permutation.
+	auto getTensorNames = [](const Terms::CompositeTerm< term_t > &current) {
+		std::vector< std::string_view > names;
+		for (const term_t &currentTerm : current) {
+			for (const Terms::Tensor &currentTensor : currentTerm.getTensors()) {
+				names.push_back(currentTensor.getName());
+			}
+		}
+		std::sort(names.begin(), names.end());
+
+		return names;
+	};
+
+	if (getTensorNames(composite) != getTensorNames(other)) {
+		return {};
+	}
+
+	// Only indices of the same space, type and spin can be exchanged. Every position is assigned to the group of such
+	// indices it belongs to (identified by the group's first position).
+	std::vector< std::size_t > groups(indices.size());
+	for (std::size_t i = 0; i < indices.size(); ++i) {
+		groups[i] = i;
+
+		for (std::size_t j = 0; j < i; ++j) {
+			if (indices[i].getSpace() == indices[j].getSpace() && indices[i].getType() == indices[j].getType()
+				&& indices[i].getSpin() == indices[j].getSpin()) {
+				groups[i] = groups[j];
+				break;
+			}
+		}
+	}
+
+	// Advances to the next permutation (in lexicographical order) that only exchanges positions within the same group
+	auto nextPermutation = [&groups](std::vector< std::size_t > &positions) {
+		for (std::size_t k = positions.size(); k-- > 0;) {
+			// Find the smallest of the values to the right of k that belong to k's group and are bigger than the current
+			// value at k
+			std::size_t replacement = positions.size();
+			for (std::size_t l = k + 1; l < positions.size(); ++l) {
+				if (groups[l] == groups[k] && positions[l] > positions[k]
+					&& (replacement == positions.size() || positions[l] < positions[replacement])) {
+					replacement = l;
+				}
+			}
+
+			if (replacement == positions.size()) {
+				continue;
+			}
+
+			std::swap(positions[k], positions[replacement]);
+
+			// Use the smallest possible order for everything to the right of k
+			for (std::size_t l = k + 1; l < positions.size(); ++l) {
+				for (std::size_t m = l + 1; m < positions.size(); ++m) {
+					if (groups[m] == groups[l] && positions[m] < positions[l]) {
+						std::swap(positions[l], positions[m]);
+					}
+				}
+			}
+
+			return true;
+		}
+
+		return false;
+	};
+
+	std::vector< std::size_t > positions(indices.size());
+	std::iota(positions.begin(), positions.end(), 0);
+
+	// The identity is skipped as that is already covered by CompositeTerm::isRelatedTo
+	while (nextPermutation(positions)) {
+		Terms::IndexSubstitution::substitution_list renamings;
+
+		for (std::size_t i = 0; i < positions.size(); ++i) {
+			const Terms::Index &original    = indices[i];
+			const Terms::Index &replacement = indices[positions[i]];
+
+			if (original != replacement) {
+				renamings.push_back({ original, replacement });
+			}
+		}
+
+		const Terms::IndexSubstitution renaming(std::move(renamings), 1, false);
+
+		Terms::Tensor permutedResult = result;
+		renaming.apply(permutedResult);
+
+		if (permutedResult.refersToSameElement(otherResult)) {
+			// Relating a Tensor to a permutation of itself is not something a TensorSubstitution can express
+			continue;
+		}
+
+		// Express the composite's Terms as contributions to the other result Tensor with the permuted indices
+		std::vector< term_t > renamedTerms;
+		renamedTerms.reserve(composite.size());
+
+		for (const term_t &currentTerm : composite) {
+			term_t renamedTerm = currentTerm;
+			renamedTerm.setResult(otherResult);
+
+			for (Terms::Tensor &currentTensor : renamedTerm.accessTensors()) {
+				renaming.apply(currentTensor);
+			}
+
+			canonicalizeIndexSequences(renamedTerm);
+			canonicalizeIndexIDs(renamedTerm);
+			canonicalizeIndexSequences(renamedTerm);
+
+			renamedTerms.push_back(std::move(renamedTerm));
+		}
+
+		const Terms::CompositeTerm< term_t > renamedComposite(std::move(renamedTerms));
+
+		if (renamedComposite.isRelatedTo(other)) {
+			return Terms::TensorSubstitution(std::move(permutedResult), otherResult,
+											 renamedComposite.getRelation(other).getFactor());
+		}
+	}
+
+	return {};
+}
+
+/**
+ * @returns A key that is the same for composites that are related to one another, either directly or with the indices
+ * of their result Tensors permuted (see findPermutedRelation). It consists of the sorted keys of the canonical
+ * labellings of the composite's Terms, which depend neither on the prefactors nor on the names of the indices nor on
+ * the index sequence of the result Tensor.
+ */
+template< typename term_t >
+std::vector< Terms::CanonicalLabelling::key_t > getRelationKey(const Terms::CompositeTerm< term_t > &composite) {
+	Terms::CanonicalLabelling::Options options;
+	options.resultPositions = false;
+
+	std::vector< Terms::CanonicalLabelling::key_t > key;
+	for (const term_t &currentTerm : composite) {
+		key.push_back(Terms::CanonicalLabelling(currentTerm, options).getKey());
+	}
+
+	std::sort(key.begin(), key.end());
+
+	return key;
+}
+
 template< typename term_t >
 bool simplify(std::vector< term_t > &terms, bool independentTerms = true, PrinterWrapper printer = {}) {
 	bool changed = false;
@@ -116,6 +384,12 @@ bool simplify(std::vector< term_t > &terms, bool independentTerms = true, Printe
 		}
 	}
 
+	if (!independentTerms && details::unifyEquivalentTerms(terms, printer)) {
+		// The index canonicalization above doesn't find all Terms that are equivalent, so equivalent Terms that
+		// are still written differently are rewritten based on their canonical labelling
+		changed = true;
+	}
+
 	// sort terms so that equal terms end up next to one another
 	std::sort(terms.begin(), terms.end());
 
@@ -163,81 +437,135 @@ bool simplify(std::vector< Terms::CompositeTerm< term_t > > &composites, Printer
 		}
 	}
 
-	// Find composite Terms that can be expressed in terms of another one and thus are not needed
-	// Note that the algorithm as implemented here does not guarantee that the elements which are
-	// not removed will remain in the same order as they had in the original vector. Therefore we
-	// will keep track of an element's original position explicitly in order to restore this order
-	// again once we are done.
-	auto outerIt = composites.begin();
-	auto end     = composites.end();
+	// Find composite Terms that can be expressed in terms of another one and thus are not needed. Of two related
+	// composites, the one that comes first is kept. Related composites have the same relation key, so only composites
+	// with the same key are compared.
+	using relation_key_t = std::vector< Terms::CanonicalLabelling::key_t >;
+
+	std::vector< relation_key_t > relationKeys(composites.size());
+	std::map< relation_key_t, std::vector< std::size_t > > buckets;
+	for (std::size_t i = 0; i < composites.size(); ++i) {
+		relationKeys[i] = getRelationKey(composites[i]);
+		buckets[relationKeys[i]].push_back(i);
+	}
+
+	std::vector< bool > removed(composites.size(), false);
+	// The composites that have to be compared against the others. Initially that are all of them, afterwards only the
+	// ones that have been modified by the substitutions found in the previous round.
+	std::vector< bool > pending(composites.size(), true);
 
-	std::vector< std::size_t > originalPositions(composites.size());
-	std::iota(originalPositions.begin(), originalPositions.end(), 0);
+	while (std::find(pending.begin(), pending.end(), true) != pending.end()) {
+		std::vector< Terms::TensorSubstitution > substitutions;
+		for (std::size_t i = 0; i < composites.size(); ++i) {
+			if (!pending[i] || removed[i]) {
+				continue;
+			}
 
-	auto outerPosIt = originalPositions.begin();
-	auto posEnd     = originalPositions.end();
+			std::vector< std::size_t > &bucket = buckets[relationKeys[i]];
 
-	std::vector< Terms::TensorSubstitution > substitutions;
-	for (auto outerIt = composites.begin(); outerIt != end; ++outerIt) {
-		auto innerIt    = outerIt + 1;
-		auto innerPosIt = outerPosIt + 1;
+			std::size_t k = 0;
+			while (k < bucket.size()) {
+				const std::size_t j = bucket[k];
+
+				if (j == i || (pending[j] && j < i)) {
+					// Pending composites that come before the current one have been compared to it already
+					k++;
+					continue;
+				}
+
+				const std::size_t keptPos    = std::min(i, j);
+				const std::size_t removedPos = std::max(i, j);
+
+				const Terms::CompositeTerm< term_t > &kept      = composites[keptPos];
+				const Terms::CompositeTerm< term_t > &discarded = composites[removedPos];
+
+				const bool directlyRelated = discarded.isRelatedTo(kept);
+				std::optional< Terms::TensorSubstitution > permutedRelation =
+					directlyRelated ? std::nullopt : findPermutedRelation(discarded, kept);
+
+				if (!directlyRelated && !permutedRelation) {
+					k++;
+					continue;
+				}
 
-		while (innerIt != end) {
-			if (innerIt->isRelatedTo(*outerIt)) {
 				// These Terms are related. This means that the result of one can be expressed by the result of the
-				// other times a factor. Therefore we'll discard the inner Term and only keep the outer one. Also we'll
-				// have to remember what this relation is, so that we'll be able to perform the correct adjustments.
-				//
-				// "Discarding" in this context means writing this term to the end of the list and then pretending
-				// that the list really is one element shorter
-				if (*outerIt != *innerIt) {
+				// other times a factor (possibly with its indices permuted). Therefore we'll discard the later
+				// composite and only keep the earlier one. Also we'll have to remember what this relation is, so that
+				// we'll be able to perform the correct adjustments.
+				if (permutedRelation) {
+					printer << "Found a relation such that " << *permutedRelation << "\n";
+
+					substitutions.push_back(std::move(*permutedRelation));
+				} else if (kept != discarded) {
 					// We only bother substituting if there actually is a difference in these two Tensors. If they
 					// are the same already, we can simply discard the second one.
-					Terms::TensorSubstitution sub = innerIt->getRelation(*outerIt);
+					Terms::TensorSubstitution sub = discarded.getRelation(kept);
 
 					printer << "Found a relation such that " << sub << "\n";
 
 					substitutions.push_back(std::move(sub));
 				} else {
-					printer << "Eliminated duplicate of " << *outerIt << "\n";
+					printer << "Eliminated duplicate of " << kept << "\n";
 				}
 
-				end--;
-				posEnd--;
-				std::swap(*innerIt, *end);
-				std::swap(*innerPosIt, *posEnd);
+				removed[removedPos] = true;
+				bucket.erase(std::find(bucket.begin(), bucket.end(), removedPos));
 
 				changed = true;
-			} else {
-				innerIt++;
-				innerPosIt++;
+
+				if (removedPos == i) {
+					break;
+				}
 			}
 		}
 
-		outerPosIt++;
-	}
-
-	// Actually get rid of the terms that are no longer needed
-	composites.erase(end, composites.end());
-	originalPositions.erase(posEnd, originalPositions.end());
+		std::fill(pending.begin(), pending.end(), false);
 
-	// Restore original order between the remaining elements
-	Utils::sort_by(composites, originalPositions);
+		// Substitute the Tensors whose composites we have discarded. As long as we performed some substitutions, it
+		// could be that by doing this we allowed for further simplifications to be performed, but only for the
+		// composites that have actually been modified.
+		for (std::size_t i = 0; i < composites.size(); ++i) {
+			if (removed[i]) {
+				continue;
+			}
 
-	// Substitute the Tensors whose terms we have discarded
-	if (!substitutions.empty()) {
-		for (Terms::CompositeTerm< term_t > &currentComposite : composites) {
-			for (Terms::Term &currentTerm : currentComposite) {
+			bool substituted = false;
+			for (Terms::Term &currentTerm : composites[i]) {
 				for (const Terms::TensorSubstitution &currentSub : substitutions) {
-					currentSub.apply(currentTerm, false);
+					if (currentSub.apply(currentTerm, false)) {
+						substituted = true;
+					}
 				}
 			}
+
+			if (!substituted) {
+				continue;
+			}
+
+			simplify(composites[i].accessTerms(), false, printer);
+
+			std::vector< std::size_t > &oldBucket = buckets[relationKeys[i]];
+			oldBucket.erase(std::find(oldBucket.begin(), oldBucket.end(), i));
+
+			relationKeys[i]                       = getRelationKey(composites[i]);
+			std::vector< std::size_t > &newBucket = buckets[relationKeys[i]];
+			newBucket.insert(std::upper_bound(newBucket.begin(), newBucket.end(), i), i);
+
+			pending[i] = true;
 		}
+	}
 
-		// As long as we performed some substitutions, it could be that by doing this we
-		// allowed for further simplifications to be performed.
-		simplify(composites, printer);
+	// Actually get rid of the composites that are no longer needed
+	std::size_t nextPos = 0;
+	for (std::size_t i = 0; i < composites.size(); ++i) {
+		if (!removed[i]) {
+			if (nextPos != i) {
+				composites[nextPos] = std::move(composites[i]);
+			}
+			nextPos++;
+		}
 	}
+	composites.erase(composites.begin() + nextPos, composites.end());
 
 	return changed;
 }
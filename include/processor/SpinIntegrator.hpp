@@ -14,8 +14,8 @@ class Tensor;
 namespace Contractor::Processor {
 
 struct IndexGroup {
-	std::vector< Terms::Index > creator;
-	std::vector< Terms::Index > annihilator;
+	Terms::IndexList creator;
+	Terms::IndexList annihilator;
 };
 
 /**
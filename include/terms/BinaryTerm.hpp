@@ -3,6 +3,8 @@
 
 #include "terms/Term.hpp"
 
+#include <array>
+
 namespace Contractor::Terms {
 
 /**
@@ -35,11 +37,13 @@ public:
 	virtual void sort() override;
 
 protected:
-	Tensor m_left;
-	Tensor m_right;
+	/**
+	 * The left and the right Tensor (in that order)
+	 */
+	std::array< Tensor, 2 > m_tensors;
 
-	Tensor &get(std::size_t index) override;
-	const Tensor &get(std::size_t index) const override;
+	Span< Tensor > accessTensorStorage() override;
+	Span< const Tensor > getTensorStorage() const override;
 };
 
 }; // namespace Contractor::Terms
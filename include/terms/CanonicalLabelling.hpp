@@ -0,0 +1,131 @@
+#ifndef CONTRACTOR_TERMS_CANONICALLABELLING_HPP_
+#define CONTRACTOR_TERMS_CANONICALLABELLING_HPP_
+
+#include "terms/Index.hpp"
+#include "terms/Tensor.hpp"
+#include "terms/Term.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Contractor::Terms {
+
+/**
+ * The canonical labelling of the tensor network described by a Term. In this network the Tensors are the vertices
+ * (labelled by their name and symmetry) and the contracted indices are the edges between them. The indices of the
+ * result Tensor are the network's external legs.
+ *
+ * The labelling chooses an order of the Tensors, an index sequence for every Tensor (among the ones its symmetry
+ * allows) and names for the contracted indices, such that the encoding of the resulting network (its key) is
+ * lexicographically minimal. Thus Terms that only differ in the order of their Tensors, in the names of their
+ * contracted indices and in symmetry-equivalent index sequences end up with the same key and with the same canonical
+ * form. In the spirit of individualization-refinement algorithms (nauty, bliss) only those choices that lead to the
+ * smallest partial encoding are followed, which keeps the search small for the Terms encountered in practice. The
+ * index sequences of a Tensor are built slot by slot along the stabilizer chain of its symmetry, so that its symmetry
+ * group doesn't have to be enumerated either.
+ *
+ * The key describes the vertices exactly (the name of a Tensor is encoded verbatim and its symmetry by a description
+ * that doesn't depend on the generators it has been created from), so Terms with the same key and the same result
+ * Tensor are equivalent.
+ */
+class CanonicalLabelling {
+public:
+	/**
+	 * The type of a single entry in the key
+	 */
+	using key_entry_t = std::uint64_t;
+	using key_t       = std::vector< key_entry_t >;
+
+	/**
+	 * The properties of the network that are taken into account by the labelling
+	 */
+	struct Options {
+		/**
+		 * Whether Tensors are told apart by their names
+		 */
+		bool names = true;
+		/**
+		 * Whether Tensors are told apart by their symmetries
+		 */
+		bool symmetry = true;
+		/**
+		 * Whether the index sequence of a Tensor may be replaced by any other one its symmetry allows. This requires
+		 * the symmetry to be taken into account.
+		 */
+		bool symmetricSequences = true;
+		/**
+		 * Whether the external indices are labelled by their position in the result Tensor. Otherwise they are
+		 * labelled in the order of their first appearance (like the contracted ones), so that Terms that only differ
+		 * in the index sequence of their result Tensor have the same key.
+		 */
+		bool resultPositions = true;
+	};
+
+	/**
+	 * Determines the canonical labelling of the given Term
+	 */
+	explicit CanonicalLabelling(const Term &term);
+	/**
+	 * Determines the canonical labelling of the given Term taking only the given properties into account
+	 */
+	CanonicalLabelling(const Term &term, const Options &options);
+
+	/**
+	 * @returns The key of the labelled Term. Equivalent Terms have the same key. The prefactor and the name of the
+	 * result Tensor are not part of the key, but the structure of the result Tensor's indices is.
+	 */
+	const key_t &getKey() const;
+
+	/**
+	 * @returns A hash of the key
+	 */
+	std::size_t getHash() const;
+
+	/**
+	 * @returns The factor arising from bringing the Tensors into the canonical index sequences
+	 */
+	int getFactor() const;
+
+	/**
+	 * @returns For every position in the canonical order, the position (in the labelled Term) of the Tensor that comes
+	 * at that position
+	 */
+	const std::vector< std::size_t > &getOrder() const;
+
+	/**
+	 * Brings the given Term into its canonical form. The given Term has to be the one this labelling has been
+	 * determined for. Equivalent Terms have the same canonical form (apart from their prefactor).
+	 */
+	void apply(Term &term) const;
+
+protected:
+	key_t m_key;
+	/**
+	 * The position of the Tensor (in the original Term) that comes at the respective position in the canonical order
+	 */
+	std::vector< std::size_t > m_order;
+	/**
+	 * The canonical index sequence of every Tensor (in canonical order)
+	 */
+	std::vector< IndexList > m_sequences;
+	/**
+	 * The canonical label of every contracted index (in the order of their first appearance in the canonical form)
+	 */
+	std::vector< Index > m_contractedIndices;
+	int m_factor = 1;
+};
+
+}; // namespace Contractor::Terms
+
+// Provide template specialization of std::hash for the CanonicalLabelling class
+namespace std {
+template<> struct hash< Contractor::Terms::CanonicalLabelling > {
+	std::size_t operator()(const Contractor::Terms::CanonicalLabelling &labelling) const {
+		return labelling.getHash();
+	}
+};
+}; // namespace std
+
+#endif // CONTRACTOR_TERMS_CANONICALLABELLING_HPP_
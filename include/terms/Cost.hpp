@@ -0,0 +1,291 @@
+#ifndef CONTRACTOR_TERMS_COST_HPP_
+#define CONTRACTOR_TERMS_COST_HPP_
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Contractor::Terms {
+
+/**
+ * Unsigned integer type used for representing the cost of (sequences of) contractions. Values are stored as native
+ * 128-bit integers (64-bit ones on compilers that don't provide a 128-bit type, e.g. MSVC) which makes the arithmetic
+ * in the factorization search cheap. Only values that don't fit into that range are stored as a multiprecision integer
+ * instead.
+ */
+class Cost {
+public:
+#ifdef NDEBUG
+	using multiprecision_t = boost::multiprecision::uint512_t;
+#else
+	// The checked version does perform (overflow) checks and throws exceptions
+	// if there is something odd going on with this number (e.g. overflows).
+	using multiprecision_t = boost::multiprecision::checked_uint512_t;
+#endif
+#ifdef __SIZEOF_INT128__
+	using native_t = unsigned __int128;
+#else
+	using native_t = std::uint64_t;
+#endif
+
+	/**
+	 * The amount of bits in the native representation
+	 */
+	static constexpr unsigned int nativeBits = sizeof(native_t) * CHAR_BIT;
+
+	Cost() = default;
+
+	template< typename T, typename = std::enable_if_t< std::is_integral_v< T > > > Cost(T value) {
+		if constexpr (std::is_signed_v< T >) {
+			if (value < 0) {
+				throw std::range_error("Attempt to create a negative Cost");
+			}
+		}
+
+		m_native = static_cast< native_t >(value);
+	}
+
+	explicit Cost(const multiprecision_t &value);
+
+	/**
+	 * Parses the given decimal representation
+	 *
+	 * @throws std::runtime_error if the given string does not represent a number
+	 */
+	explicit Cost(std::string_view value);
+
+	Cost(const Cost &other)
+		: m_native(other.m_native),
+		  m_multiprecision(other.m_multiprecision ? std::make_unique< multiprecision_t >(*other.m_multiprecision)
+												  : nullptr) {}
+	Cost(Cost &&other) noexcept = default;
+
+	Cost &operator=(const Cost &other) {
+		if (!other.m_multiprecision) {
+			m_native = other.m_native;
+			m_multiprecision.reset();
+		} else if (this != &other) {
+			m_native         = 0;
+			m_multiprecision = std::make_unique< multiprecision_t >(*other.m_multiprecision);
+		}
+
+		return *this;
+	}
+	Cost &operator=(Cost &&other) noexcept = default;
+
+	Cost &operator+=(const Cost &other) {
+		native_t result;
+		if (!m_multiprecision && !other.m_multiprecision && !addOverflows(m_native, other.m_native, result)) {
+			m_native = result;
+			return *this;
+		}
+
+		return addSlow(other);
+	}
+
+	Cost &operator-=(const Cost &other) {
+		if (!m_multiprecision && !other.m_multiprecision && m_native >= other.m_native) {
+			m_native -= other.m_native;
+			return *this;
+		}
+
+		return subtractSlow(other);
+	}
+
+	Cost &operator*=(const Cost &other) {
+		native_t result;
+		if (!m_multiprecision && !other.m_multiprecision && !multiplyOverflows(m_native, other.m_native, result)) {
+			m_native = result;
+			return *this;
+		}
+
+		return multiplySlow(other);
+	}
+
+	/**
+	 * Multiplication by a (non-negative) built-in integer which is cheaper than multiplying by an arbitrary Cost
+	 */
+	template< typename T, typename = std::enable_if_t< std::is_integral_v< T > && sizeof(T) <= sizeof(std::uint64_t) > >
+	Cost &operator*=(T factor) {
+		if constexpr (std::is_signed_v< T >) {
+			if (factor < 0) {
+				return *this *= Cost(factor);
+			}
+		}
+
+		const std::uint64_t unsignedFactor = static_cast< std::uint64_t >(factor);
+#ifdef __SIZEOF_INT128__
+		// A product of a 128-bit and a 64-bit number can only overflow if the upper half of the former is non-zero
+		if (!m_multiprecision && (m_native >> 64) == 0) {
+			m_native *= unsignedFactor;
+			return *this;
+		}
+#else
+		native_t result;
+		if (!m_multiprecision && !multiplyOverflows(m_native, unsignedFactor, result)) {
+			m_native = result;
+			return *this;
+		}
+#endif
+
+		return multiplySlow(Cost(unsignedFactor));
+	}
+
+	/**
+	 * Integer division (rounding towards zero)
+	 *
+	 * @throws std::overflow_error if other is zero
+	 */
+	Cost &operator/=(const Cost &other) {
+		if (!m_multiprecision && !other.m_multiprecision && other.m_native != 0) {
+			m_native /= other.m_native;
+			return *this;
+		}
+
+		return divideSlow(other);
+	}
+
+	friend Cost operator+(Cost lhs, const Cost &rhs) { return lhs += rhs; }
+	friend Cost operator-(Cost lhs, const Cost &rhs) { return lhs -= rhs; }
+	friend Cost operator*(Cost lhs, const Cost &rhs) { return lhs *= rhs; }
+	friend Cost operator/(Cost lhs, const Cost &rhs) { return lhs /= rhs; }
+
+	friend bool operator==(const Cost &lhs, const Cost &rhs) {
+		if (!lhs.m_multiprecision && !rhs.m_multiprecision) {
+			return lhs.m_native == rhs.m_native;
+		}
+
+		// Values that fit into the native representation always use it
+		return lhs.m_multiprecision && rhs.m_multiprecision && *lhs.m_multiprecision == *rhs.m_multiprecision;
+	}
+
+	friend bool operator<(const Cost &lhs, const Cost &rhs) {
+		if (!lhs.m_multiprecision && !rhs.m_multiprecision) {
+			return lhs.m_native < rhs.m_native;
+		}
+
+		// Every value that requires the multiprecision representation is bigger than all others
+		if (!lhs.m_multiprecision || !rhs.m_multiprecision) {
+			return !lhs.m_multiprecision;
+		}
+
+		return *lhs.m_multiprecision < *rhs.m_multiprecision;
+	}
+
+	friend bool operator!=(const Cost &lhs, const Cost &rhs) { return !(lhs == rhs); }
+	friend bool operator>(const Cost &lhs, const Cost &rhs) { return rhs < lhs; }
+	friend bool operator<=(const Cost &lhs, const Cost &rhs) { return !(rhs < lhs); }
+	friend bool operator>=(const Cost &lhs, const Cost &rhs) { return !(lhs < rhs); }
+
+	friend Cost pow(const Cost &base, unsigned int exponent) {
+		Cost result = 1;
+		for (unsigned int i = 0; i < exponent; ++i) {
+			result *= base;
+		}
+
+		return result;
+	}
+
+	friend std::ostream &operator<<(std::ostream &stream, const Cost &cost) { return stream << cost.str(); }
+
+	/**
+	 * @returns Whether this value is stored as a native integer (as opposed to a multiprecision one)
+	 */
+	bool isNative() const { return !m_multiprecision; }
+
+	/**
+	 * @returns The decimal representation of this value
+	 */
+	std::string str() const;
+
+	template< typename T > T convert_to() const {
+		if (m_multiprecision) {
+			return m_multiprecision->convert_to< T >();
+		}
+
+		return static_cast< T >(m_native);
+	}
+
+	multiprecision_t toMultiprecision() const;
+
+protected:
+	native_t m_native = 0;
+	/**
+	 * The value of this Cost if (and only if) it doesn't fit into the native representation
+	 */
+	std::unique_ptr< multiprecision_t > m_multiprecision;
+
+	/**
+	 * Sets this Cost to the given value (choosing the native representation if possible)
+	 */
+	Cost &assign(const multiprecision_t &value);
+
+	/**
+	 * Stores lhs + rhs in result (wrapping around on overflow)
+	 *
+	 * @returns Whether the addition overflowed
+	 */
+	static bool addOverflows(native_t lhs, native_t rhs, native_t &result) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_add_overflow(lhs, rhs, &result);
+#else
+		result = lhs + rhs;
+		return result < lhs;
+#endif
+	}
+
+	/**
+	 * Stores lhs * rhs in result (wrapping around on overflow)
+	 *
+	 * @returns Whether the multiplication overflowed
+	 */
+	static bool multiplyOverflows(native_t lhs, native_t rhs, native_t &result) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_mul_overflow(lhs, rhs, &result);
+#else
+		result = lhs * rhs;
+		return lhs != 0 && result / lhs != rhs;
+#endif
+	}
+
+	// The slow paths of the arithmetic operators are kept out of line to keep the fast paths small
+	Cost &addSlow(const Cost &other);
+	Cost &subtractSlow(const Cost &other);
+	Cost &multiplySlow(const Cost &other);
+	Cost &divideSlow(const Cost &other);
+};
+
+}; // namespace Contractor::Terms
+
+namespace std {
+template<> class numeric_limits< Contractor::Terms::Cost > {
+public:
+	static constexpr bool is_specialized = true;
+	static constexpr bool is_signed      = false;
+	static constexpr bool is_integer     = true;
+	static constexpr bool is_exact       = true;
+	static constexpr bool is_bounded     = true;
+	static constexpr bool is_modulo      = false;
+	static constexpr int radix           = 2;
+	static constexpr int digits          = numeric_limits< Contractor::Terms::Cost::multiprecision_t >::digits;
+	static constexpr int digits10        = numeric_limits< Contractor::Terms::Cost::multiprecision_t >::digits10;
+	static constexpr int min_exponent    = 0;
+	static constexpr int max_exponent    = 0;
+
+	static Contractor::Terms::Cost min() { return 0; }
+	static Contractor::Terms::Cost lowest() { return 0; }
+	static Contractor::Terms::Cost max() {
+		return Contractor::Terms::Cost(numeric_limits< Contractor::Terms::Cost::multiprecision_t >::max());
+	}
+};
+}; // namespace std
+
+#endif // CONTRACTOR_TERMS_COST_HPP_
@@ -0,0 +1,96 @@
+#ifndef CONTRACTOR_TERMS_COSTPOLYNOMIAL_HPP_
+#define CONTRACTOR_TERMS_COSTPOLYNOMIAL_HPP_
+
+#include "terms/IndexSpace.hpp"
+#include "terms/Tensor.hpp"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace Contractor::Utils {
+class IndexSpaceResolver;
+};
+
+namespace Contractor::Terms {
+
+/**
+ * A class representing a cost as a polynomial in the sizes of the different index spaces (e.g.
+ * 2 N_P^4 N_H^2 + N_P^3 N_H^3) instead of as a number obtained for one specific set of sizes
+ */
+class CostPolynomial {
+public:
+	/**
+	 * Type used for the cost obtained by evaluating the polynomial
+	 */
+	using cost_t = ContractionResult::cost_t;
+	/**
+	 * Type used for storing the exponents of a single monomial (indexed by IndexSpace ID). There are never any trailing
+	 * zeros.
+	 */
+	using exponent_list_t = std::vector< unsigned int >;
+	/**
+	 * Type used for storing the monomials along with their coefficients
+	 */
+	using monomial_map_t = std::map< exponent_list_t, cost_t >;
+	/**
+	 * Type used for specifying the size of every index space (indexed by IndexSpace ID)
+	 */
+	using size_point_t = std::vector< cost_t >;
+
+	/**
+	 * Creates the zero polynomial
+	 */
+	CostPolynomial() = default;
+
+	/**
+	 * Creates a polynomial consisting of a single monomial with the given exponents (as e.g. obtained from
+	 * Term::getFormalScaling or ContractionResult::spaceExponents)
+	 */
+	explicit CostPolynomial(const std::unordered_map< IndexSpace, unsigned int > &exponents,
+							const cost_t &coefficient = 1);
+
+	friend bool operator==(const CostPolynomial &lhs, const CostPolynomial &rhs);
+	friend bool operator!=(const CostPolynomial &lhs, const CostPolynomial &rhs);
+
+	CostPolynomial &operator+=(const CostPolynomial &other);
+	friend CostPolynomial operator+(CostPolynomial lhs, const CostPolynomial &rhs);
+
+	/**
+	 * @returns The monomials of this polynomial along with their (non-zero) coefficients
+	 */
+	const monomial_map_t &getMonomials() const;
+
+	/**
+	 * @returns Whether this is the zero polynomial
+	 */
+	bool isZero() const;
+
+	/**
+	 * @returns The highest total degree of any of the monomials
+	 */
+	unsigned int getDegree() const;
+
+	/**
+	 * @returns The cost obtained for the given sizes of the index spaces. Spaces without a specified size are
+	 * considered to have size zero.
+	 */
+	cost_t evaluate(const size_point_t &sizes) const;
+
+	/**
+	 * @returns The cost obtained for the sizes of the index spaces known to the given resolver
+	 */
+	cost_t evaluate(const Utils::IndexSpaceResolver &resolver) const;
+
+	/**
+	 * @returns The size point corresponding to the sizes of the index spaces known to the given resolver
+	 */
+	static size_point_t getSizePoint(const Utils::IndexSpaceResolver &resolver);
+
+protected:
+	monomial_map_t m_monomials;
+};
+
+}; // namespace Contractor::Terms
+
+#endif // CONTRACTOR_TERMS_COSTPOLYNOMIAL_HPP_
@@ -64,8 +64,8 @@ public:
 protected:
 	tensor_list_t m_tensors;
 
-	Tensor &get(std::size_t index) override;
-	const Tensor &get(std::size_t index) const override;
+	Span< Tensor > accessTensorStorage() override;
+	Span< const Tensor > getTensorStorage() const override;
 };
 
 }; // namespace Contractor::Terms
@@ -3,14 +3,20 @@
 
 #include "terms/IndexSpace.hpp"
 
+#include <boost/container/small_vector.hpp>
+
 #include <cstdint>
 #include <ostream>
+#include <stdexcept>
 
 namespace Contractor::Terms {
 
 /**
  * A class representing an Index. An index exists within a given IndexSpace and within that space
  * it is enumerated by its ID (differentiating different indices within the same space).
+ *
+ * All attributes of an Index are packed into a single 32-bit word (from most to least significant: type, space, spin
+ * and ID) such that comparing, ordering and hashing indices boils down to (masked) integer operations.
  */
 class Index {
 public:
@@ -21,40 +27,22 @@ public:
 	struct index_has_same_name {
 		constexpr bool operator()(const Index &lhs, const Index &rhs) const {
 			// An index' "name" is determined only by its index space and its ID
-			return lhs.getID() == rhs.getID() && lhs.getSpace() == rhs.getSpace();
+			return ((lhs.m_bits ^ rhs.m_bits) & nameMask) == 0;
 		}
 	};
 
 	struct type_and_spin_insensitive_hasher {
-		std::size_t operator()(const Index &index) const {
-			return std::hash< Contractor::Terms::IndexSpace >{}(index.getSpace())
-				   ^ (std::hash< Contractor::Terms::Index::id_t >{}(index.getID()) << 1);
-		}
+		std::size_t operator()(const Index &index) const { return index.m_bits & nameMask; }
 	};
 
 	struct type_insensitive_hasher {
-		std::size_t operator()(const Index &index) const {
-			type_and_spin_insensitive_hasher hasher;
-
-			return hasher(index) ^ (std::hash< Contractor::Terms::Index::Spin >{}(index.getSpin()) << 1);
-		}
+		std::size_t operator()(const Index &index) const { return index.m_bits & ~typeMask; }
 	};
 
 	struct less_than_type_space_spin_id {
 		constexpr bool operator()(const Index &lhs, const Index &rhs) const {
-			if (lhs.getType() != rhs.getType()) {
-				return lhs.getType() < rhs.getType();
-			}
-
-			if (lhs.getSpace() != rhs.getSpace()) {
-				return lhs.getSpace() < rhs.getSpace();
-			}
-
-			if (lhs.getSpin() != rhs.getSpin()) {
-				return lhs.getSpin() < rhs.getSpin();
-			}
-
-			return lhs.getID() < rhs.getID();
+			// The packed representation orders the attributes by significance in exactly this order
+			return lhs.m_bits < rhs.m_bits;
 		};
 	};
 
@@ -63,6 +51,11 @@ public:
 	 */
 	using id_t = unsigned int;
 
+	/**
+	 * The biggest ID an Index can have (limited by the width of the ID in the packed representation)
+	 */
+	static constexpr id_t maxID = 0xFFFF;
+
 	/**
 	 * An enum holding different Index types
 	 */
@@ -79,10 +72,13 @@ public:
 
 	/**
 	 * Instantiates an Index in the given space with the given ID
+	 *
+	 * @throws std::out_of_range if the space's ID or the given ID exceed the range of the packed representation
 	 */
 	constexpr explicit Index(const IndexSpace &space = IndexSpace(), id_t id = 0, Type type = Type::None,
 							 Spin spin = Spin::None)
-		: m_space(space), m_id(id), m_type(type), m_spin(spin){};
+		: m_bits(pack(type, typeShift, typeMask) | pack(space.getID(), spaceShift, spaceMask)
+				 | pack(spin, spinShift, spinMask) | pack(id, idShift, idMask)){};
 
 	constexpr Index(const Index &other) = default;
 	constexpr Index(Index &&other)      = default;
@@ -94,15 +90,13 @@ public:
 	 * attributes except their type.
 	 */
 	static constexpr bool isSame(const Index &lhs, const Index &rhs) {
-		return lhs.m_space == rhs.m_space && lhs.m_id == rhs.m_id && lhs.m_spin == rhs.m_spin;
+		return ((lhs.m_bits ^ rhs.m_bits) & ~typeMask) == 0;
 	}
 
 	/**
 	 * @returns Whether two indices are identical. That is they are the same and their type is the same as well.
 	 */
-	friend constexpr bool operator==(const Index &lhs, const Index &rhs) {
-		return isSame(lhs, rhs) && lhs.m_type == rhs.m_type;
-	}
+	friend constexpr bool operator==(const Index &lhs, const Index &rhs) { return lhs.m_bits == rhs.m_bits; }
 
 	friend constexpr bool operator!=(const Index &lhs, const Index &rhs) { return !(lhs == rhs); }
 
@@ -131,9 +125,9 @@ public:
 	}
 
 	friend std::ostream &operator<<(std::ostream &out, const Index &index) {
-		out << index.m_space.getID() << "-" << index.m_id;
+		out << index.getSpace().getID() << "-" << index.getID();
 
-		switch (index.m_type) {
+		switch (index.getType()) {
 			case Type::None:
 				out << "N";
 				break;
@@ -144,7 +138,7 @@ public:
 				out << "A";
 				break;
 		}
-		out << index.m_spin;
+		out << index.getSpin();
 
 		return out;
 	}
@@ -152,55 +146,94 @@ public:
 	/**
 	 * @returns This Index's ID
 	 */
-	constexpr id_t getID() const { return m_id; }
+	constexpr id_t getID() const { return unpack< id_t >(idShift, idMask); }
 	/**
 	 * Sets the ID of this index to the given value
 	 *
 	 * @param id The new ID to use
 	 */
-	void setID(id_t id) { m_id = id; }
+	void setID(id_t id) { m_bits = (m_bits & ~idMask) | pack(id, idShift, idMask); }
 
 	/**
 	 * @returns This Index's IndexSpace
 	 */
-	constexpr IndexSpace getSpace() const { return m_space; }
+	constexpr IndexSpace getSpace() const { return IndexSpace(unpack< IndexSpace::id_t >(spaceShift, spaceMask)); }
 	/**
 	 * Sets the index space of this index
 	 *
 	 * @param space The new IndexSpace to use
 	 */
-	void setSpace(const IndexSpace &space) { m_space = space; }
+	void setSpace(const IndexSpace &space) {
+		m_bits = (m_bits & ~spaceMask) | pack(space.getID(), spaceShift, spaceMask);
+	}
 
 	/**
 	 * @returns The spin state of this Index
 	 */
-	constexpr Spin getSpin() const { return m_spin; }
+	constexpr Spin getSpin() const { return unpack< Spin >(spinShift, spinMask); }
 	/**
 	 * Sets the spin of this index
 	 *
 	 * @param spin The new spin to use
 	 */
-	void setSpin(Spin spin) { m_spin = spin; }
+	void setSpin(Spin spin) { m_bits = (m_bits & ~spinMask) | pack(spin, spinShift, spinMask); }
 
 	/**
 	 * @returns The Type of this index (e.g. creator or annihilator)
 	 */
-	constexpr Type getType() const { return m_type; }
+	constexpr Type getType() const { return unpack< Type >(typeShift, typeMask); }
 	/**
 	 * Sets the Type of this Index
 	 *
 	 * @param type The new Type to use
 	 */
-	void setType(Type type) { m_type = type; }
-
+	void setType(Type type) { m_bits = (m_bits & ~typeMask) | pack(type, typeShift, typeMask); }
 
 protected:
-	IndexSpace m_space;
-	id_t m_id;
-	Type m_type;
-	Spin m_spin;
+	using bits_t = std::uint32_t;
+
+	static constexpr unsigned int idShift    = 0;
+	static constexpr unsigned int spinShift  = 16;
+	static constexpr unsigned int spaceShift = 18;
+	static constexpr unsigned int typeShift  = 30;
+
+	static constexpr bits_t idMask    = bits_t(maxID) << idShift;
+	static constexpr bits_t spinMask  = bits_t(0x3) << spinShift;
+	static constexpr bits_t spaceMask = bits_t(0xFFF) << spaceShift;
+	static constexpr bits_t typeMask  = bits_t(0x3) << typeShift;
+	/**
+	 * The bits that determine an Index's "name" (its space and its ID)
+	 */
+	static constexpr bits_t nameMask = spaceMask | idMask;
+
+	bits_t m_bits;
+
+	/**
+	 * @returns The given value shifted into the bits selected by the given mask
+	 *
+	 * @throws std::out_of_range if the value doesn't fit into these bits
+	 */
+	template< typename T > static constexpr bits_t pack(T value, unsigned int shift, bits_t mask) {
+		if (static_cast< bits_t >(value) > (mask >> shift)) {
+			throw std::out_of_range("Index attribute exceeds the range of the packed Index representation");
+		}
+
+		return static_cast< bits_t >(value) << shift;
+	}
+
+	template< typename T > constexpr T unpack(unsigned int shift, bits_t mask) const {
+		return static_cast< T >((m_bits & mask) >> shift);
+	}
 };
 
+static_assert(sizeof(Index) == sizeof(std::uint32_t), "Indices are expected to be packed into 32 bits");
+
+/**
+ * Type used for storing sequences of indices. Up to 8 indices (which covers all Tensors we have to deal with) are
+ * stored inline so that copying such a sequence doesn't require any heap allocations.
+ */
+using IndexList = boost::container::small_vector< Index, 8 >;
+
 }; // namespace Contractor::Terms
 
 // Provide template specialization of std::hash for the Index class
@@ -51,6 +51,10 @@ public:
 	 * indices the associated space runs over.
 	 */
 	unsigned int getSize() const;
+	/**
+	 * Changes the size of this space (without changing the associated IndexSpace)
+	 */
+	void setSize(size_t size);
 	/**
 	 * @returns An instance of the associated IndexSpace
 	 */
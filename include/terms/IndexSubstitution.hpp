@@ -49,7 +49,7 @@ public:
 	 * @param factor The factor to associate with the produced operation
 	 * @returns The produced substitution object
 	 */
-	static IndexSubstitution createCyclicPermutation(const std::vector< Index > &indices, factor_t factor = 1);
+	static IndexSubstitution createCyclicPermutation(const IndexList &indices, factor_t factor = 1);
 
 	/**
 	 * @returns The identity operation (no-op)
@@ -118,7 +118,7 @@ public:
 	 * @param indices The list of indices to work on
 	 * @returns The prefactor resulting from the performed index substitution
 	 */
-	factor_t apply(std::vector< Index > &indices) const;
+	factor_t apply(IndexList &indices) const;
 
 	/**
 	 * Applies the substitutions to the given IndexSubstitution (in-place).
@@ -146,7 +146,7 @@ public:
 	 * @param indices The list of indices to check
 	 * @returns Whether this substitution applies to the given Tensor
 	 */
-	bool appliesTo(const std::vector< Index > &indices) const;
+	bool appliesTo(const IndexList &indices) const;
 
 	/**
 	 * @returns Whether this substitution is the identity operation (no-op)
@@ -3,26 +3,29 @@
 
 #include "terms/Index.hpp"
 #include "terms/IndexSubstitution.hpp"
+#include "terms/SlotPermutation.hpp"
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <ostream>
 #include <vector>
 
-#include <boost/range/join.hpp>
-
 namespace Contractor::Terms {
 
-/*
- * NOTE: For a more performant solution (especially for larger groups) the
- * Schreier-Sims-Algorithm for generating a base and a strong generating set
- * (used as a representation for the group) should be used instead.
- * However as we are only expecting to treat small-ish groups with this class
- * and given that the Schreier-Sims-Algorithm involves heavy group theory
- * that I don't understand yet, we'll settle on the brute-force method here.
- */
-
 /**
  * A class representing a permutation group (A group in the mathematical sense that consists of
  * permutation operations).
+ *
+ * Once a root sequence is set, the group is represented by a StabilizerChain acting on the positions of that sequence
+ * (with the factor of -1 being encoded as the exchange of two additional positions). Thus membership tests, the
+ * group's size and the canonical representation are obtained without enumerating the group's elements. Groups without
+ * a root sequence or with generators that are not a mere permutation of the root sequence (e.g. if the latter
+ * contains an index multiple times) fall back to generating all elements explicitly.
+ *
+ * As the positional representation doesn't depend on the actual indices, it is shared (as an immutable object) among
+ * all groups with the same symmetry pattern, which makes copying groups (and thus Tensors) cheap.
  */
 class PermutationGroup {
 public:
@@ -31,10 +34,10 @@ public:
 	 * the initial sequence into the stored one using only the allowed permutation operations.
 	 */
 	struct Element {
-		std::vector< Index > indexSequence;
+		IndexList indexSequence;
 		int factor = 1.0f;
 
-		Element(const std::vector< Index > &seq = {}, int factor = 1.0f) : indexSequence(seq), factor(factor) {}
+		Element(const IndexList &seq = {}, int factor = 1.0f) : indexSequence(seq), factor(factor) {}
 		Element(const Element &other) = default;
 		Element(Element &&other)      = default;
 
@@ -45,7 +48,7 @@ public:
 			return lhs.indexSequence == rhs.indexSequence;
 		};
 
-		friend bool operator!=(const Element &lhs, const Element &rhs) { return lhs != rhs; }
+		friend bool operator!=(const Element &lhs, const Element &rhs) { return !(lhs == rhs); }
 
 		friend bool operator<(const Element &lhs, const Element &rhs) { return lhs.indexSequence < rhs.indexSequence; }
 	};
@@ -78,20 +81,40 @@ public:
 	void addGenerator(IndexSubstitution &&generator, bool regenerate = true);
 
 	/**
-	 * @returns A list of generator operations of this group
+	 * @returns A list of generator operations of this group (starting with the identity). Note that this list is
+	 * created on every call.
 	 */
-	const std::vector< IndexSubstitution > &getGenerators() const;
+	std::vector< IndexSubstitution > getGenerators() const;
 	/**
 	 * @returns A list of operations of this group that are not the generators but that result
-	 * by chainging and combining the generators.
+	 * by chainging and combining the generators. Note that this list is created on every call.
+	 */
+	std::vector< IndexSubstitution > getAdditionalSymmetryOperations() const;
+
+	/**
+	 * @returns The (sorted) list of permutations of the index sequence that can be reached by applying the
+	 * permutation operations contained in this group. Note that this list is created on every call.
 	 */
-	const std::vector< IndexSubstitution > &getAdditionalSymmetryOperations() const;
+	std::vector< Element > getIndexPermutations() const;
 
 	/**
-	 * @returns The list of permutations of the index sequence that can be reached by applying the
-	 * permutation operations contained in this group.
+	 * @returns The elements of this group whose index sequences are lexicographically smallest with respect to the
+	 * values assigned to their indices by the given function. Unless the group has to be generated explicitly, these
+	 * are found slot by slot via the stabilizer chain, without enumerating the entire group.
+	 *
+	 * @param value Function returning the value of the index in the given slot of the given sequence. It must only
+	 * depend on the indices in the slots up to (and including) the given one.
 	 */
-	const std::vector< Element > &getIndexPermutations() const;
+	std::vector< Element >
+		getMinimalElements(const std::function< std::uint64_t(const IndexList &, std::size_t) > &value) const;
+
+	/**
+	 * @returns A list of permutations of the slots of the root sequence that describes this group independently of the
+	 * generators it has been created from. As the permutations of the slots of any sequence that can be reached from
+	 * the root sequence form the same group, the description doesn't depend on which of these sequences is the root.
+	 * If the group can't be represented as permutations of the root sequence, an empty optional is returned.
+	 */
+	std::optional< std::vector< SlotPermutation > > getSlotDescription() const;
 
 	/**
 	 * Set the initial index sequence this group shall act on
@@ -108,7 +131,12 @@ public:
 	 * @returns Whether the given index sequence can be reached from the root sequence set on this group
 	 * by only using the permutation operations contained in this group.
 	 */
-	bool contains(const std::vector< Index > &indexSequence) const;
+	bool contains(const IndexList &indexSequence) const;
+	/**
+	 * @returns The factor that is associated with turning the root sequence into the given one or an empty optional,
+	 * if the given sequence can't be reached from the root sequence
+	 */
+	std::optional< int > getFactor(const IndexList &indexSequence) const;
 
 	/**
 	 * @returns The size of this group (amount of permutation operations contained in it)
@@ -120,7 +148,7 @@ public:
 	 * has been chosen for this group, provided that the different root sequences can be converted into one another
 	 * using only the allowed permutation operations on them.
 	 */
-	const std::vector< Index > &getCanonicalRepresentation() const;
+	const IndexList &getCanonicalRepresentation() const;
 	/**
 	 * The factor that is associated with turning the set root sequence into the "canonical" one
 	 */
@@ -132,11 +160,42 @@ public:
 	void regenerateGroup();
 
 protected:
-	std::vector< Element > m_permutations;
+	/**
+	 * The generators (as permutations of positions) along with the group they span. Patterns are interned, so that
+	 * there only exists a single instance for every distinct list of generators.
+	 */
+	struct Pattern;
+
+	std::optional< Element > m_root;
+	Element m_canonical;
+	/**
+	 * The group acting on the positions of the root sequence or nullptr, if the group can't be represented that way
+	 */
+	std::shared_ptr< const Pattern > m_pattern;
+	/**
+	 * The explicitly generated operations and permutations used in case no pattern can be used
+	 */
 	std::vector< IndexSubstitution > m_generators = { IndexSubstitution::identity() };
 	std::vector< IndexSubstitution > m_additionalElements;
+	std::vector< Element > m_permutations;
 
 	void generateSymmetryOperations(const IndexSubstitution &preceidingOperation = IndexSubstitution::identity());
+
+	/**
+	 * @returns The pattern with the given generators
+	 */
+	static std::shared_ptr< const Pattern > getPattern(std::size_t rank,
+													   const std::vector< SlotPermutation > &generators);
+
+	/**
+	 * Represents the group spanned by the given generators by a pattern. If that is not possible, the group falls
+	 * back to using the given generators explicitly.
+	 */
+	void setGenerators(std::vector< IndexSubstitution > generators);
+	/**
+	 * @returns The element obtained by permuting the root sequence according to the given permutation
+	 */
+	Element toElement(const SlotPermutation &permutation) const;
 };
 
 }; // namespace Contractor::Terms
@@ -145,11 +204,12 @@ protected:
 namespace std {
 template<> struct hash< Contractor::Terms::PermutationGroup > {
 	std::size_t operator()(const Contractor::Terms::PermutationGroup &group) const {
-		std::size_t hash = 0;
+		// Equal groups are of the same size and act on the same set of index sequences (and thus have the same
+		// canonical representation)
+		std::size_t hash = std::hash< std::size_t >{}(group.size());
 
-		auto it = boost::join(group.getGenerators(), group.getAdditionalSymmetryOperations());
-		for (auto i = it.begin(); i != it.end(); ++i) {
-			hash += std::hash< Contractor::Terms::IndexSubstitution >{}(*i);
+		for (const Contractor::Terms::Index &currentIndex : group.getCanonicalRepresentation()) {
+			hash = hash * 31 + std::hash< Contractor::Terms::Index >{}(currentIndex);
 		}
 
 		return hash;
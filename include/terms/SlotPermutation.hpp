@@ -0,0 +1,129 @@
+#ifndef CONTRACTOR_TERMS_SLOTPERMUTATION_HPP_
+#define CONTRACTOR_TERMS_SLOTPERMUTATION_HPP_
+
+#include "terms/Index.hpp"
+#include "terms/IndexSubstitution.hpp"
+
+#include <boost/container/small_vector.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+
+namespace Contractor::Terms {
+
+/**
+ * A permutation of the slots (positions) of an index sequence along with a sign. In contrast to an IndexSubstitution
+ * this doesn't refer to any concrete indices, so that composition, inversion, comparison and hashing are all simple
+ * operations on an array of the size of the sequence.
+ *
+ * A SlotPermutation p acts on a sequence by replacing the index in the i-th slot with the one that was in slot p(i)
+ * before. With respect to a given reference sequence, IndexSubstitutions that merely permute the indices in that
+ * sequence can be converted into SlotPermutations and back (see fromSubstitution and toSubstitution).
+ */
+class SlotPermutation {
+public:
+	using slot_t      = std::uint16_t;
+	using slot_list_t = boost::container::small_vector< slot_t, 12 >;
+
+	/**
+	 * Creates the identity on the given amount of slots
+	 */
+	explicit SlotPermutation(std::size_t rank = 0, int sign = 1);
+	/**
+	 * Creates the permutation that maps the i-th slot onto images[i]
+	 */
+	explicit SlotPermutation(slot_list_t images, int sign = 1);
+
+	/**
+	 * Converts the given substitution into a permutation of the slots of the given reference sequence
+	 *
+	 * @returns The respective SlotPermutation or an empty optional, if the substitution doesn't correspond to a
+	 * permutation of the reference sequence (e.g. because it doesn't apply to it, because the sequence contains an
+	 * index more than once or because the substitution's factor is neither 1 nor -1)
+	 */
+	static std::optional< SlotPermutation > fromSubstitution(const IndexSubstitution &substitution,
+															 const IndexList &reference);
+
+	/**
+	 * @returns The IndexSubstitution that has the same effect on the given reference sequence as this permutation
+	 */
+	IndexSubstitution toSubstitution(const IndexList &reference) const;
+
+	friend bool operator==(const SlotPermutation &lhs, const SlotPermutation &rhs) {
+		return lhs.m_sign == rhs.m_sign && lhs.m_images == rhs.m_images;
+	}
+	friend bool operator!=(const SlotPermutation &lhs, const SlotPermutation &rhs) { return !(lhs == rhs); }
+
+	/**
+	 * @returns The product lhs * rhs (applying rhs first). This is compatible with the product of
+	 * IndexSubstitutions, so that converting the product of two substitutions gives the product of the converted
+	 * substitutions.
+	 */
+	friend SlotPermutation operator*(const SlotPermutation &lhs, const SlotPermutation &rhs);
+
+	friend std::ostream &operator<<(std::ostream &stream, const SlotPermutation &permutation);
+
+	/**
+	 * @returns The inverse of this permutation
+	 */
+	SlotPermutation inverse() const;
+
+	/**
+	 * Applies this permutation to the given sequence (in-place). As for IndexSubstitutions, the type of the index in
+	 * every slot is preserved. Applying p and then q is equivalent to applying p * q.
+	 *
+	 * @returns The sign of this permutation
+	 */
+	int apply(IndexList &indices) const;
+
+	/**
+	 * @returns The slot the given slot is mapped onto
+	 */
+	slot_t operator[](std::size_t slot) const { return m_images[slot]; }
+
+	/**
+	 * @returns The images of all slots
+	 */
+	const slot_list_t &getImages() const;
+
+	/**
+	 * @returns The sign (1 or -1) associated with this permutation
+	 */
+	int getSign() const;
+
+	/**
+	 * @returns The amount of slots this permutation acts on
+	 */
+	std::size_t getRank() const;
+
+	/**
+	 * @returns Whether this permutation leaves every slot unchanged and has a positive sign
+	 */
+	bool isIdentity() const;
+
+protected:
+	slot_list_t m_images;
+	int m_sign;
+};
+
+}; // namespace Contractor::Terms
+
+// Provide template specialization of std::hash for the SlotPermutation class
+namespace std {
+template<> struct hash< Contractor::Terms::SlotPermutation > {
+	std::size_t operator()(const Contractor::Terms::SlotPermutation &permutation) const {
+		std::size_t hash = permutation.getSign() < 0 ? 1 : 0;
+
+		for (Contractor::Terms::SlotPermutation::slot_t currentImage : permutation.getImages()) {
+			hash = hash * 31 + currentImage;
+		}
+
+		return hash;
+	}
+};
+}; // namespace std
+
+#endif // CONTRACTOR_TERMS_SLOTPERMUTATION_HPP_
@@ -0,0 +1,155 @@
+#ifndef CONTRACTOR_TERMS_STABILIZERCHAIN_HPP_
+#define CONTRACTOR_TERMS_STABILIZERCHAIN_HPP_
+
+#include <boost/container/small_vector.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Contractor::Terms {
+
+/**
+ * A permutation group on the points 0, ..., degree - 1 represented by a base and a strong generating set (BSGS) as
+ * obtained by the Schreier-Sims algorithm. The base always consists of all points in ascending order which makes it
+ * possible to find the lexicographically smallest image of a sequence under the group's action.
+ *
+ * In contrast to enumerating all elements of the group, this representation requires only polynomial time and space
+ * (in terms of the degree) for membership tests and for obtaining the group's order.
+ */
+class StabilizerChain {
+public:
+	using point_t = std::uint16_t;
+	/**
+	 * A permutation p stored as the list of images: p(i) = p[i]
+	 */
+	using permutation_t = boost::container::small_vector< point_t, 12 >;
+
+	/**
+	 * @returns The identity permutation on the given amount of points
+	 */
+	static permutation_t identity(std::size_t degree);
+	/**
+	 * @returns The product lhs * rhs (applying rhs first)
+	 */
+	static permutation_t multiply(const permutation_t &lhs, const permutation_t &rhs);
+	/**
+	 * @returns The inverse of the given permutation
+	 */
+	static permutation_t invert(const permutation_t &permutation);
+
+	/**
+	 * Creates the trivial group on the given amount of points
+	 */
+	explicit StabilizerChain(std::size_t degree = 0);
+
+	/**
+	 * Extends the group by the given permutation
+	 *
+	 * @returns Whether the group has changed (it doesn't, if the permutation is already contained in it)
+	 */
+	bool addGenerator(const permutation_t &permutation);
+
+	/**
+	 * @returns Whether the given permutation is an element of this group
+	 */
+	bool contains(const permutation_t &permutation) const;
+
+	/**
+	 * @returns The order of this group (the amount of elements in it)
+	 */
+	std::size_t order() const;
+
+	/**
+	 * @returns The amount of points this group acts on
+	 */
+	std::size_t getDegree() const;
+
+	/**
+	 * Finds the element g of this group that yields the smallest sequence (g(0), g(1), ...) with respect to the
+	 * given ordering of points. If points are compared via the values of a sequence at these positions, this is the
+	 * group element producing the lexicographically smallest permutation of that sequence. The ordering has to be
+	 * strict and total for the result to be unique.
+	 */
+	permutation_t findMinimalElement(const std::function< bool(point_t, point_t) > &less) const;
+	/**
+	 * Finds all elements g of this group that yield the smallest sequence (value(g, 0), value(g, 1), ...). In contrast
+	 * to findMinimalElement, the value of a point may depend on the images of the positions before it, so ties can't
+	 * be resolved up-front. Instead, all elements that are minimal so far are followed from one base point to the
+	 * next, which only requires enumerating the entire group if all of its elements yield the same values.
+	 *
+	 * @param value Function returning the value of the image of the given position under the given element. It must
+	 * only depend on the images of the positions up to (and including) the given one.
+	 */
+	std::vector< permutation_t >
+		findMinimalElements(const std::function< std::uint64_t(const permutation_t &, std::size_t) > &value) const;
+
+	/**
+	 * @returns For every base point, the smallest element (in the sense of findMinimalElement with the natural
+	 * ordering of points) of every coset of the stabilizer of that base point within the stabilizer of the previous
+	 * ones, except for the identity. In contrast to the strong generators, these only depend on the group itself and
+	 * not on the way it has been generated. The returned elements are sorted, which makes the list a canonical
+	 * description of this group.
+	 */
+	std::vector< permutation_t > getCanonicalTransversals() const;
+
+	/**
+	 * Calls the given function for every element of this group
+	 */
+	void forEachElement(const std::function< void(const permutation_t &) > &callback) const;
+
+protected:
+	struct Level {
+		/**
+		 * The points (other than the base point of this level) in the orbit of the base point in the order in which
+		 * they have been reached
+		 */
+		std::vector< point_t > orbit;
+		/**
+		 * For every point p in the orbit a permutation u with u(basePoint) = p. The base point itself is implicitly
+		 * mapped onto itself by the identity.
+		 */
+		std::vector< permutation_t > transversal;
+	};
+
+	std::size_t m_degree;
+	/**
+	 * The strong generators along with the index of the first base point that they don't fix. The generators of
+	 * the stabilizer of the first i base points are all generators with a depth of at least i.
+	 */
+	std::vector< std::pair< permutation_t, std::size_t > > m_strongGenerators;
+	/**
+	 * The levels of the stabilizer chain. All levels beyond the stored ones are trivial (the base point's orbit
+	 * consists of only that point), which avoids any allocations for small (in particular trivial) groups.
+	 */
+	std::vector< Level > m_levels;
+
+	void computeOrbit(std::size_t level);
+	/**
+	 * @returns The element g * h (with h from the stabilizer of the base points before the given level) that yields
+	 * the smallest sequence (g * h(0), g * h(1), ...) with respect to the given ordering of points
+	 */
+	permutation_t minimize(permutation_t element, std::size_t startLevel,
+						   const std::function< bool(point_t, point_t) > &less) const;
+	/**
+	 * @returns The transversal element mapping the base point of the given level onto the given point or nullptr, if
+	 * the point is not in the base point's orbit. For the base point itself, the given identity is returned.
+	 */
+	const permutation_t *findTransversal(std::size_t level, point_t point, const permutation_t &identity) const;
+	/**
+	 * Reduces the given permutation by the transversals of the levels starting at the given one
+	 *
+	 * @returns The level at which the reduction stopped (the degree, if the permutation has been reduced to the
+	 * identity)
+	 */
+	std::size_t sift(permutation_t &permutation, std::size_t startLevel) const;
+	/**
+	 * Adds Schreier generators to the strong generating set until it is complete
+	 */
+	void complete(std::size_t startLevel);
+};
+
+}; // namespace Contractor::Terms
+
+#endif // CONTRACTOR_TERMS_STABILIZERCHAIN_HPP_
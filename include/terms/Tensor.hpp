@@ -1,13 +1,13 @@
 #ifndef CONTRACTOR_TERMS_TENSOR_HPP_
 #define CONTRACTOR_TERMS_TENSOR_HPP_
 
+#include "terms/Cost.hpp"
 #include "terms/Index.hpp"
 #include "terms/IndexSubstitution.hpp"
 #include "terms/PermutationGroup.hpp"
+#include "terms/TensorName.hpp"
 #include "utils/IterableView.hpp"
 
-#include <boost/multiprecision/cpp_int.hpp>
-
 #include <limits.h>
 #include <ostream>
 #include <string>
@@ -39,14 +39,16 @@ public:
 	/**
 	 * Type that is used for storing the list of attached indices
 	 */
-	using index_list_t = std::vector< Index >;
+	using index_list_t = IndexList;
 
 	struct has_same_name {
-		bool operator()(const Tensor &left, const Tensor &right) const { return left.getName() == right.getName(); }
+		bool operator()(const Tensor &left, const Tensor &right) const {
+			return left.getInternedName() == right.getInternedName();
+		}
 	};
 
 	struct tensor_name_hash {
-		std::size_t operator()(const Tensor &tensor) const { return std::hash< std::string_view >{}(tensor.getName()); }
+		std::size_t operator()(const Tensor &tensor) const { return tensor.getInternedName().hash(); }
 	};
 
 	struct is_same_tensor_element {
@@ -54,23 +56,35 @@ public:
 	};
 
 	struct tensor_element_hash {
-		std::size_t operator()(const Tensor &tensor) const {
-			std::size_t hash = 0;
-			for (std::size_t i = 0; i < tensor.getIndices().size(); ++i) {
-				// Include the position of the index in order to ensure that a different index sequence will result
-				// in a different hash value. In order for symmetry-equivalent tensors to arrive at the same hash,
-				// we use the "canonical" index sequence for this Tensor
-				const Index &currentIndex = tensor.getSymmetry().getCanonicalRepresentation()[i];
-				// We only care about an Index's space and spin as the explicit name is not important for the tensor
-				// element
-				hash += (std::hash< IndexSpace >{}(currentIndex.getSpace()) << 0)
-						^ (std::hash< Index::Spin >{}(currentIndex.getSpin()) << 1) ^ std::hash< std::size_t >{}(i);
-			}
-
-			hash ^= std::hash< std::string_view >{}(tensor.getName()) << 1;
-
-			return hash;
+		std::size_t operator()(const Tensor &tensor) const { return tensor.getElementHash(); }
+	};
+
+	/**
+	 * Provides mutable access to the symmetry of a Tensor. The Tensor's hashes are recomputed once the access ends,
+	 * which (unless the access is stored in a variable) is at the end of the expression that requested it.
+	 */
+	class SymmetryAccess {
+	public:
+		explicit SymmetryAccess(Tensor &tensor) : m_tensor(tensor) {}
+		SymmetryAccess(const SymmetryAccess &other) = delete;
+		SymmetryAccess &operator=(const SymmetryAccess &other) = delete;
+		~SymmetryAccess() { m_tensor.updateHashes(); }
+
+		void addGenerator(const IndexSubstitution &generator, bool regenerate = true) {
+			m_tensor.m_symmetry.addGenerator(generator, regenerate);
+		}
+		void addGenerator(IndexSubstitution &&generator, bool regenerate = true) {
+			m_tensor.m_symmetry.addGenerator(std::move(generator), regenerate);
+		}
+		void setRootSequence(const PermutationGroup::Element &rootSequence) {
+			m_tensor.m_symmetry.setRootSequence(rootSequence);
 		}
+		void regenerateGroup() { m_tensor.m_symmetry.regenerateGroup(); }
+
+		const PermutationGroup &get() const { return m_tensor.m_symmetry; }
+
+	protected:
+		Tensor &m_tensor;
 	};
 
 
@@ -107,23 +121,44 @@ public:
 	 */
 	const index_list_t &getIndices() const;
 	/**
-	 * @returns The list of indices of this Tensor
+	 * Replaces the indices of this Tensor along with the symmetry acting on them
 	 */
-	index_list_t &getIndices();
+	void setIndices(index_list_t indices, PermutationGroup symmetry);
 
 	/**
 	 * @returns This Tensor's name
 	 */
 	const std::string_view getName() const;
+	/**
+	 * @returns This Tensor's name in its interned form, which is cheap to compare and to hash
+	 */
+	const TensorName &getInternedName() const;
 
 	void setName(const std::string_view &name);
+	void setName(const TensorName &name);
 
 	const PermutationGroup &getSymmetry() const;
 
-	PermutationGroup &accessSymmetry();
+	/**
+	 * @returns Mutable access to this Tensor's symmetry
+	 */
+	SymmetryAccess accessSymmetry();
 
 	void setSymmetry(const PermutationGroup &symmetry);
 
+	/**
+	 * @returns The hash of this Tensor (as used by std::hash). Equal Tensors have the same hash. The hash is computed
+	 * whenever this Tensor is modified, so that obtaining it doesn't modify the Tensor.
+	 */
+	std::size_t getHash() const;
+
+	/**
+	 * @returns The hash of the element this Tensor refers to (as used by tensor_element_hash). Tensors that refer to
+	 * the same element have the same element hash. The hash is computed whenever this Tensor is modified, so that
+	 * obtaining it doesn't modify the Tensor.
+	 */
+	std::size_t getElementHash() const;
+
 	/**
 	 * @returns The total spin S property of this Tensor.
 	 * If this is the highest possible value representable with an int, then this means
@@ -218,6 +253,16 @@ public:
 	 */
 	ContractionResult contract(const Tensor &other, const Utils::IndexSpaceResolver &resolver) const;
 
+	/**
+	 * @param other The Tensor this one has been contracted with
+	 * @param result The result of that contraction (as obtained from contract)
+	 * @returns The cost of the contraction if the permutational symmetry of the involved Tensors is exploited. That is,
+	 * only the symmetry-unique elements of the result are computed and summations over contracted indices that both
+	 * operands are (anti)symmetric with respect to are only carried out once. Equals the contraction's cost if there is
+	 * no such symmetry.
+	 */
+	Cost getSymmetryReducedCost(const Tensor &other, const ContractionResult &result) const;
+
 	/**
 	 * Brings the indices of this Tensor into "canonical" order. That means the indices are sorted
 	 * in such a way that creator indices come before annihilator ones which come before other indices.
@@ -239,25 +284,40 @@ public:
 	 */
 	int canonicalizeIndices();
 
+	/**
+	 * Replaces the indices in this Tensor by the given sequence which has to be reachable from the current one by means
+	 * of this Tensor's index symmetry
+	 *
+	 * @returns The factor that is associated with this transformation
+	 * @throws std::invalid_argument if the given sequence is not reachable from the current one
+	 */
+	int setIndexSequence(const index_list_t &sequence);
+
 protected:
 	index_list_t m_indices;
-	std::string m_name;
+	TensorName m_name;
 	PermutationGroup m_symmetry;
 	int m_S        = std::numeric_limits< int >::max();
 	int m_doubleMs = 0;
+	/**
+	 * The values of getHash and getElementHash as of the last modification of this Tensor
+	 */
+	std::size_t m_hash        = 0;
+	std::size_t m_elementHash = 0;
+
+	std::size_t computeHash() const;
+	std::size_t computeElementHash() const;
+	/**
+	 * Recomputes the hashes of this Tensor. Has to be called by every function that modifies this Tensor.
+	 */
+	void updateHashes();
 };
 
 /**
  * Struct holding the result of a contraction
  */
 struct ContractionResult {
-#ifdef NDEBUG
-	using cost_t = boost::multiprecision::uint512_t;
-#else
-	// The checked version does perform (overflow) checks and throws exceptions
-	// if there is something odd going on with this number (e.g. overflows).
-	using cost_t = boost::multiprecision::checked_uint512_t;
-#endif
+	using cost_t = Cost;
 
 	/**
 	 * The Tensor representing the contracted result
@@ -283,21 +343,7 @@ struct ContractionResult {
 // Provide template specialization of std::hash for the Tensor class
 namespace std {
 template<> struct hash< Contractor::Terms::Tensor > {
-	std::size_t operator()(const Contractor::Terms::Tensor &tensor) const {
-		std::size_t hash = 0;
-		for (std::size_t i = 0; i < tensor.getIndices().size(); ++i) {
-			// Include the position of the index in order to ensure that a different index sequence will result
-			// in a different hash value. In order for symmetry-equivalent tensors to arrive at the same hash,
-			// we use the "canonical" index sequence for this Tensor
-			hash += std::hash< Contractor::Terms::Index >{}(tensor.getSymmetry().getCanonicalRepresentation()[i])
-					^ std::hash< std::size_t >{}(i);
-		}
-
-		hash ^= std::hash< std::string_view >{}(tensor.getName()) << 1;
-		hash ^= std::hash< Contractor::Terms::PermutationGroup >{}(tensor.getSymmetry()) << 2;
-
-		return hash;
-	}
+	std::size_t operator()(const Contractor::Terms::Tensor &tensor) const { return tensor.getHash(); }
 };
 }; // namespace std
 
@@ -0,0 +1,101 @@
+#ifndef CONTRACTOR_TERMS_TENSORNAME_HPP_
+#define CONTRACTOR_TERMS_TENSORNAME_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace Contractor::Terms {
+
+/**
+ * The name of a Tensor. Names are interned in a global (thread-safe) table, so that every distinct name is stored
+ * exactly once and a TensorName merely refers to its entry in that table. Thus copying, comparing and hashing names
+ * doesn't involve any string operations. Entries are never removed from the table and therefore the views returned
+ * by str() remain valid for the entire lifetime of the program.
+ */
+class TensorName {
+public:
+	/**
+	 * Creates a TensorName for the given name (adding it to the table of names, if it doesn't exist yet)
+	 */
+	explicit TensorName(std::string_view name = {});
+
+	TensorName(const TensorName &other) = default;
+	/**
+	 * Like a moved-from string, a moved-from name is empty
+	 */
+	TensorName(TensorName &&other) noexcept : m_entry(std::exchange(other.m_entry, getEmptyEntry())) {}
+	TensorName &operator=(const TensorName &other) = default;
+	TensorName &operator=(TensorName &&other) noexcept {
+		m_entry = std::exchange(other.m_entry, getEmptyEntry());
+
+		return *this;
+	}
+
+	/**
+	 * @returns The name of the result of contracting Tensors with the given names. That is the two names joined by an
+	 * underscore with the alphabetically smaller name coming first (making the result independent of the order of the
+	 * arguments). Joined names are cached, so the string concatenation is performed only once for every pair of names.
+	 */
+	static TensorName join(const TensorName &lhs, const TensorName &rhs);
+
+	friend bool operator==(const TensorName &lhs, const TensorName &rhs) { return lhs.m_entry == rhs.m_entry; }
+	friend bool operator!=(const TensorName &lhs, const TensorName &rhs) { return lhs.m_entry != rhs.m_entry; }
+	friend bool operator<(const TensorName &lhs, const TensorName &rhs) {
+		// Names are ordered alphabetically in order to not depend on the order in which they have been interned
+		return lhs.m_entry != rhs.m_entry && lhs.str() < rhs.str();
+	}
+
+	friend std::ostream &operator<<(std::ostream &out, const TensorName &name) { return out << name.str(); }
+
+	/**
+	 * @returns The string representation of this name
+	 */
+	std::string_view str() const { return m_entry->name; }
+
+	/**
+	 * @returns The hash of this name, which is the same as the one of the corresponding std::string_view
+	 */
+	std::size_t hash() const { return m_entry->hash; }
+
+protected:
+	struct Entry {
+		std::string name;
+		std::size_t hash;
+
+		explicit Entry(std::string_view name) : name(name), hash(std::hash< std::string_view >{}(name)) {}
+	};
+
+	struct Table;
+
+	const Entry *m_entry;
+
+	explicit TensorName(const Entry *entry) : m_entry(entry) {}
+
+	/**
+	 * @returns The table holding all names
+	 */
+	static Table &getTable();
+	/**
+	 * @returns The entry of the empty name
+	 */
+	static const Entry *getEmptyEntry();
+	/**
+	 * @returns The (unique) entry for the given name
+	 */
+	static const Entry *intern(std::string_view name);
+};
+
+}; // namespace Contractor::Terms
+
+// Provide template specialization of std::hash for the TensorName class
+namespace std {
+template<> struct hash< Contractor::Terms::TensorName > {
+	std::size_t operator()(const Contractor::Terms::TensorName &name) const { return name.hash(); }
+};
+}; // namespace std
+
+#endif // CONTRACTOR_TERMS_TENSORNAME_HPP_
@@ -2,7 +2,7 @@
 #define CONTRACTOR_TERMS_TERM_HPP_
 
 #include "terms/Tensor.hpp"
-#include "utils/Iterable.hpp"
+#include "utils/Span.hpp"
 
 #include <cstdint>
 #include <ostream>
@@ -108,16 +108,16 @@ public:
 	 */
 	virtual std::size_t size() const = 0;
 	/**
-	 * @returns An object that can be iterated over in order to visit the different Tensors contained
-	 * in this term
+	 * @returns A view of the different Tensors contained in this term. The view is invalidated by any operation
+	 * that changes the amount of Tensors in this Term.
 	 */
-	Iterable< const Tensor > getTensors() const;
+	Span< const Tensor > getTensors() const;
 
 	/**
-	 * @returns An object that can be iterated over in order to visit the different Tensors contained
-	 * in this term
+	 * @returns A mutable view of the different Tensors contained in this term. The view is invalidated by any
+	 * operation that changes the amount of Tensors in this Term.
 	 */
-	Iterable< Tensor > accessTensors();
+	Span< Tensor > accessTensors();
 
 	/**
 	 * @param other The Term to compare with
@@ -169,16 +169,16 @@ protected:
 	factor_t m_prefactor;
 
 	/**
-	 * @returns A reference to the Tensor at the given index. This helper function is used for making
-	 * iterating over Terms possible.
+	 * @returns A view of the (contiguous) storage of the Tensors in this Term. This helper function is used for
+	 * making iterating over Terms possible.
 	 */
-	virtual Tensor &get(std::size_t index) = 0;
+	virtual Span< Tensor > accessTensorStorage() = 0;
 
 	/**
-	 * @returns A reference to the Tensor at the given index. This helper function is used for making
-	 * iterating over Terms possible.
+	 * @returns A view of the (contiguous) storage of the Tensors in this Term. This helper function is used for
+	 * making iterating over Terms possible.
 	 */
-	virtual const Tensor &get(std::size_t index) const = 0;
+	virtual Span< const Tensor > getTensorStorage() const = 0;
 };
 
 
@@ -1,6 +1,8 @@
 #ifndef CONTRACTOR_UTILS_ITERABLE_HPP_
 #define CONTRACTOR_UTILS_ITERABLE_HPP_
 
+#include "utils/Span.hpp"
+
 #include <functional>
 #include <iterator>
 #include <type_traits>
@@ -32,6 +34,10 @@ namespace Contractor {
  * the underlaying container (usually just its memory address). This is needed
  * because function pointers (or std::function to be more precise) can't be
  * compared with one another.
+ *
+ * Note that every access through an Iterable involves calling a std::function.
+ * Objects with contiguous storage should rather be exposed as a Span, which
+ * Iterable can still be constructed from for compatibility.
  */
 
 template< typename T > struct iterator_impl {
@@ -98,6 +104,9 @@ template< typename T > struct Iterable {
 	Iterable(std::size_t start, std::size_t end, typename iterator_impl< T >::access_function_t &func, const void *id)
 		: m_begin(start, func, id), m_end(end, func, id) {}
 
+	Iterable(Span< T > span)
+		: m_begin(0, makeSpanAccess(span), span.data()), m_end(span.size(), makeSpanAccess(span), span.data()) {}
+
 	iterator begin() { return m_begin; }
 	iterator end() { return m_end; }
 
@@ -110,6 +119,10 @@ template< typename T > struct Iterable {
 protected:
 	iterator m_begin;
 	iterator m_end;
+
+	static typename iterator::access_function_t makeSpanAccess(Span< T > span) {
+		return [span](std::size_t index) -> T & { return span[index]; };
+	}
 };
 
 }; // namespace Contractor
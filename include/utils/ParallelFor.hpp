@@ -0,0 +1,28 @@
+#ifndef CONTRACTOR_UTILS_PARALLELFOR_HPP_
+#define CONTRACTOR_UTILS_PARALLELFOR_HPP_
+
+#include <cstddef>
+#include <functional>
+
+namespace Contractor::Utils {
+
+/**
+ * Calls the given function for every index in [0, count). The calls are distributed over (at most) the given amount of
+ * threads. Every thread picks up the next index that has not been processed yet, once it has finished with its
+ * previous one, so that expensive and cheap work items balance out automatically. If jobs is <= 1, all calls happen
+ * on the calling thread (in order).
+ *
+ * If any of the calls throws, the remaining indices are skipped and the first exception is rethrown on the calling
+ * thread once all threads have finished.
+ *
+ * @param count The amount of work items
+ * @param jobs The maximum amount of threads to use
+ * @param function The function to invoke for every work item. It receives the index of the work item and the index
+ * of the thread (in [0, jobs)) it is being executed on.
+ */
+void parallelFor(std::size_t count, std::size_t jobs,
+				 const std::function< void(std::size_t index, std::size_t threadIndex) > &function);
+
+}; // namespace Contractor::Utils
+
+#endif // CONTRACTOR_UTILS_PARALLELFOR_HPP_
@@ -0,0 +1,57 @@
+#ifndef CONTRACTOR_UTILS_SPAN_HPP_
+#define CONTRACTOR_UTILS_SPAN_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace Contractor {
+
+/**
+ * A light-weight, non-owning view of a contiguous sequence of objects (essentially a pointer and a size). In contrast
+ * to Iterable, iterating over a Span doesn't involve any indirect calls, as its iterators are plain pointers.
+ *
+ * A Span remains valid only as long as the underlying storage is neither destroyed nor reallocated.
+ */
+template< typename T > class Span {
+public:
+	using element_type   = T;
+	using value_type     = std::remove_cv_t< T >;
+	using iterator       = T *;
+	using const_iterator = const T *;
+
+	constexpr Span() = default;
+	constexpr Span(T *data, std::size_t size) : m_data(data), m_size(size) {}
+
+	/**
+	 * Implicit conversion of a mutable Span into a Span of const objects
+	 */
+	template< typename U, typename = std::enable_if_t< std::is_same_v< const U, T > && !std::is_same_v< U, T > > >
+	constexpr Span(const Span< U > &other) : m_data(other.data()), m_size(other.size()) {}
+
+	constexpr iterator begin() const { return m_data; }
+	constexpr iterator end() const { return m_data + m_size; }
+
+	constexpr const_iterator cbegin() const { return m_data; }
+	constexpr const_iterator cend() const { return m_data + m_size; }
+
+	constexpr T &operator[](std::size_t index) const {
+		assert(index < m_size);
+		return m_data[index];
+	}
+
+	constexpr T &front() const { return (*this)[0]; }
+	constexpr T &back() const { return (*this)[m_size - 1]; }
+
+	constexpr T *data() const { return m_data; }
+	constexpr std::size_t size() const { return m_size; }
+	constexpr bool empty() const { return m_size == 0; }
+
+protected:
+	T *m_data          = nullptr;
+	std::size_t m_size = 0;
+};
+
+}; // namespace Contractor
+
+#endif // CONTRACTOR_UTILS_SPAN_HPP_
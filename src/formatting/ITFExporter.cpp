@@ -166,7 +166,7 @@ bool isIndexPattern(const ct::Tensor::index_list_t &indices, const std::vector<
 	return true;
 }
 
-std::vector< ct::Index > getITFCanonicalIndexSequence(const std::vector< ct::PermutationGroup::Element > &sequences,
+ct::IndexList getITFCanonicalIndexSequence(const std::vector< ct::PermutationGroup::Element > &sequences,
 													  const cu::IndexSpaceResolver &resolver) {
 	auto canonicalElementIt = std::min_element(
 		sequences.begin(), sequences.end(),
@@ -230,7 +230,7 @@ bool ITFExporter::writeSpecialTensor(const ct::Tensor &tensor) {
 		std::string printName;
 		std::vector< std::reference_wrapper< const ct::Index > > targetIndices;
 
-		const std::vector< ct::Index > referenceSequence =
+		const ct::IndexList referenceSequence =
 			getITFCanonicalIndexSequence(indexGroup.getIndexPermutations(), m_resolver);
 
 		// Note that once we take symmetry into account, there are only the two unique possible cases of
@@ -332,7 +332,7 @@ std::string ITFExporter::getIndexPatternString(const ct::Tensor &tensor) const {
 	return getIndexPatternString(tensor.getIndices());
 }
 
-std::string ITFExporter::getIndexPatternString(const std::vector< ct::Index > &indices) const {
+std::string ITFExporter::getIndexPatternString(const ct::IndexList &indices) const {
 	std::string pattern;
 
 	std::size_t size = indices.size();
@@ -399,7 +399,7 @@ void ITFExporter::writeTensorName(const std::string_view &name) {
 	}
 }
 
-void ITFExporter::writeIndexSequence(const std::vector< ct::Index > &indices) {
+void ITFExporter::writeIndexSequence(const ct::IndexList &indices) {
 	std::vector< std::reference_wrapper< const ct::Index > > refIndices(indices.begin(), indices.end());
 
 	writeIndexSequence(refIndices);
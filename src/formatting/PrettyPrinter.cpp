@@ -1,4 +1,5 @@
 #include "formatting/PrettyPrinter.hpp"
+#include "terms/CostPolynomial.hpp"
 #include "terms/Index.hpp"
 #include "terms/IndexSubstitution.hpp"
 #include "terms/PermutationGroup.hpp"
@@ -8,6 +9,7 @@
 #include "terms/TensorSubstitution.hpp"
 #include "utils/IndexSpaceResolver.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 
@@ -298,9 +300,9 @@ void PrettyPrinter::print(const Terms::TensorRename &rename) {
 void PrettyPrinter::printTensorType(const Terms::Tensor &tensor, const Utils::IndexSpaceResolver &resolver) {
 	assert(m_stream != nullptr);
 
-	std::vector< Terms::Index > creatorIndices;
-	std::vector< Terms::Index > annihilatorIndices;
-	std::vector< Terms::Index > otherIndices;
+	Terms::IndexList creatorIndices;
+	Terms::IndexList annihilatorIndices;
+	Terms::IndexList otherIndices;
 
 	for (const Terms::Index &currentIndex : tensor.getIndices()) {
 		switch (currentIndex.getType()) {
@@ -382,6 +384,61 @@ void PrettyPrinter::printScaling(const Terms::Term::FormalScalingMap &scaling,
 	}
 }
 
+void PrettyPrinter::printCost(const Terms::CostPolynomial &cost, const Utils::IndexSpaceResolver &resolver) {
+	if (cost.isZero()) {
+		*m_stream << "0";
+		return;
+	}
+
+	// Print the monomials with the highest total degree first
+	using monomial_t = Terms::CostPolynomial::monomial_map_t::value_type;
+	std::vector< const monomial_t * > monomials;
+	for (const monomial_t &current : cost.getMonomials()) {
+		monomials.push_back(&current);
+	}
+
+	auto degree = [](const monomial_t *monomial) {
+		unsigned int sum = 0;
+		for (unsigned int current : monomial->first) {
+			sum += current;
+		}
+
+		return sum;
+	};
+
+	std::stable_sort(monomials.begin(), monomials.end(), [&degree](const monomial_t *lhs, const monomial_t *rhs) {
+		return degree(lhs) > degree(rhs) || (degree(lhs) == degree(rhs) && lhs->first > rhs->first);
+	});
+
+	for (std::size_t i = 0; i < monomials.size(); ++i) {
+		if (i > 0) {
+			*m_stream << " + ";
+		}
+
+		const Terms::CostPolynomial::exponent_list_t &exponents = monomials[i]->first;
+		bool printedFactor                                        = false;
+
+		if (monomials[i]->second != 1 || degree(monomials[i]) == 0) {
+			*m_stream << monomials[i]->second;
+			printedFactor = true;
+		}
+
+		for (std::size_t id = 0; id < exponents.size(); ++id) {
+			if (exponents[id] == 0) {
+				continue;
+			}
+
+			if (printedFactor) {
+				*m_stream << " ";
+			}
+
+			const Terms::IndexSpace space(static_cast< Terms::IndexSpace::id_t >(id));
+			*m_stream << "N_" << resolver.getMeta(space).getLabel() << "^" << exponents[id];
+			printedFactor = true;
+		}
+	}
+}
+
 void PrettyPrinter::printHeadline(const std::string_view headline) {
 	// Print the headline
 	*m_stream << headline << "\n";
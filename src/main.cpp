@@ -7,17 +7,20 @@
 #include "parser/SymmetryListParser.hpp"
 #include "parser/TensorRenameParser.hpp"
 #include "processor/Factorizer.hpp"
+#include "processor/IntermediateSharing.hpp"
 #include "processor/Simplifier.hpp"
 #include "processor/SpinIntegrator.hpp"
 #include "processor/SpinSummation.hpp"
 #include "processor/Symmetrizer.hpp"
 #include "terms/BinaryTerm.cpp"
 #include "terms/CompositeTerm.hpp"
+#include "terms/CostPolynomial.hpp"
 #include "terms/GeneralTerm.hpp"
 #include "terms/IndexSubstitution.hpp"
 #include "terms/TensorRename.hpp"
 #include "terms/TermGroup.hpp"
 #include "utils/IndexSpaceResolver.hpp"
+#include "utils/ParallelFor.hpp"
 
 #include <boost/algorithm/string.hpp>
 #include <boost/program_options/errors.hpp>
@@ -25,10 +28,14 @@
 #include <boost/program_options/parsers.hpp>
 #include <boost/program_options/variables_map.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -51,6 +58,18 @@ struct CommandLineArguments {
 	bool restrictedOrbitals;
 	bool useKext;
 	std::vector< unsigned int > selectedTerms;
+	cpr::Factorizer::Engine factorizationEngine;
+	unsigned int jobs;
+	unsigned int searchJobs;
+	std::filesystem::path factorizationCacheFile;
+	bool shareIntermediates;
+	bool reuseAwareFactorization;
+	std::string maxIntermediateSize;
+	cpr::Factorizer::Policy factorizationPolicy;
+	bool printParetoFront;
+	std::string sizeRange;
+	bool symmetryAwareCost;
+	bool layoutAwareFactorization;
 };
 
 template< typename term_t > bool is_empty(const ct::CompositeTerm< term_t > &composite) {
@@ -87,6 +106,30 @@ int processCommandLine(int argc, const char **argv, CommandLineArguments &args)
 		 "The name of the \"CODE_BLOCK\" to use when exporting to ITF")
 		("kext", boost::program_options::value<bool>(&args.useKext)->default_value(false)->zero_tokens(),
 		 "Replace contributions containing 4-virtual-2-electron integrals with K4E")
+		("share-intermediates", boost::program_options::value<bool>(&args.shareIntermediates)->default_value(false)->zero_tokens(),
+		 "Calculate intermediates that are needed by multiple term groups only once and reuse them in all later groups")
+		("factorization-engine", boost::program_options::value<cpr::Factorizer::Engine>(&args.factorizationEngine)->default_value(cpr::Factorizer::Engine::Exhaustive),
+		 "The algorithm used for finding the optimal factorization of the terms. Either \"exhaustive\" (try every contraction order) or \"dp\" (dynamic programming over subsets of Tensors). Both produce the same result.")
+		("jobs,j", boost::program_options::value<unsigned int>(&args.jobs)->default_value(1),
+		 "The amount of threads to use for factorizing terms concurrently. 0 means one thread per available CPU core. The output does not depend on this setting.")
+		("factorization-cache", boost::program_options::value<std::filesystem::path>(&args.factorizationCacheFile)->default_value(""),
+		 "Path to a file in which found factorizations are stored for reuse in subsequent runs. The file is created if it doesn't exist yet. Cached factorizations are discarded if the index spaces or the cost model (--symmetry-aware-cost, --layout-aware-factorization) change.")
+		("search-jobs", boost::program_options::value<unsigned int>(&args.searchJobs)->default_value(1),
+		 "The amount of threads to use for searching the optimal factorization of a single (big) term (exhaustive engine only). 0 means one thread per available CPU core. The factorization does not depend on this setting (the reported search statistics might).")
+		("max-intermediate-size", boost::program_options::value<std::string>(&args.maxIntermediateSize)->default_value(""),
+		 "The maximum amount of elements an intermediate may have. Either a plain number or a product of index space sizes (referred to by label or name, optionally prefixed with \"N_\"), e.g. \"N_P^3*N_H\". Factorizations producing bigger intermediates are not considered.")
+		("reuse-aware-factorization", boost::program_options::value<bool>(&args.reuseAwareFactorization)->default_value(false)->zero_tokens(),
+		 "When factorizing a term, consider contractions that produce an intermediate already computed by a previous term of the same composite as free. Implies the exhaustive engine for such terms and bypasses the factorization cache for them.")
+		("factorization-policy", boost::program_options::value<cpr::Factorizer::Policy>(&args.factorizationPolicy)->default_value(cpr::Factorizer::Policy::MinimumCost),
+		 "Which of the Pareto-optimal factorizations (in terms of cost and biggest intermediate) to use for every term. Either \"cost\" (lowest cost), \"memory\" (smallest biggest intermediate) or \"balanced\" (lowest product of the two). Any policy other than \"cost\" requires determining the entire Pareto front.")
+		("pareto-front", boost::program_options::value<bool>(&args.printParetoFront)->default_value(false)->zero_tokens(),
+		 "Determine and print the Pareto front of cost vs. biggest intermediate for every factorized term")
+		("size-range", boost::program_options::value<std::string>(&args.sizeRange)->default_value(""),
+		 "Comma-separated ranges of index space sizes (referred to by label or name) for which factorizations shall stay close to optimal, e.g. \"H=5:50,P=50:1000\". Factorizations are evaluated at the smallest, the largest and the geometric mean of every range (and all combinations thereof) and the one whose cost exceeds the respective optimum by the smallest factor is chosen. Can't be combined with --pareto-front or a factorization policy other than \"cost\".")
+		("symmetry-aware-cost", boost::program_options::value<bool>(&args.symmetryAwareCost)->default_value(false)->zero_tokens(),
+		 "Credit the permutational symmetry of the contracted tensors and of their results when estimating the cost of a contraction (as for a backend that only computes symmetry-unique elements). Both the dense and the symmetry-reduced operation counts are reported. Implies the exhaustive engine and can't be combined with --size-range.")
+		("layout-aware-factorization", boost::program_options::value<bool>(&args.layoutAwareFactorization)->default_value(false)->zero_tokens(),
+		 "Among equally expensive factorizations and among the index orders allowed by the tensors' symmetries, prefer the ones that map onto GEMMs with the least amount of explicit transposition. The estimated amount of transposed elements is reported. Implies the exhaustive engine.")
 	;
 	// clang-format on
 
@@ -106,6 +149,9 @@ int processCommandLine(int argc, const char **argv, CommandLineArguments &args)
 	} catch (const boost::program_options::required_option &e) {
 		std::cerr << e.what() << std::endl;
 		return Contractor::ExitCodes::MISSING_COMMANDLINE_OPTION;
+	} catch (const boost::program_options::validation_error &e) {
+		std::cerr << e.what() << std::endl;
+		return Contractor::ExitCodes::INVALID_COMMANDLINE_OPTION_VALUE;
 	}
 
 	// Verify that the file paths actually exist (empty path means optional)
@@ -200,6 +246,156 @@ bool isFourVirtualTwoElectronIntegral(const ct::Tensor &tensor, const cu::IndexS
 	return true;
 }
 
+/**
+ * Parses a size that is given either as a plain number or as a product of index space sizes (and numbers), e.g.
+ * "2*N_P^3*occupied"
+ *
+ * @throws std::invalid_argument if the given expression can't be parsed
+ */
+ct::ContractionResult::cost_t parseSize(const std::string &expression, const cu::IndexSpaceResolver &resolver) {
+	std::vector< std::string > factors;
+	boost::split(factors, expression, boost::is_any_of("*"));
+
+	// std::isdigit must not be called with negative values (which is what non-ASCII chars may end up as)
+	auto isDigit = [](unsigned char c) { return std::isdigit(c) != 0; };
+
+	ct::ContractionResult::cost_t size = 1;
+
+	for (std::string &currentFactor : factors) {
+		boost::trim(currentFactor);
+
+		std::vector< std::string > parts;
+		boost::split(parts, currentFactor, boost::is_any_of("^"));
+
+		if (parts.size() > 2 || parts[0].empty()) {
+			throw std::invalid_argument("Invalid factor \"" + currentFactor + "\"");
+		}
+
+		unsigned long exponent = 1;
+		if (parts.size() == 2) {
+			boost::trim(parts[1]);
+
+			if (parts[1].empty() || !std::all_of(parts[1].begin(), parts[1].end(), isDigit)) {
+				throw std::invalid_argument("Invalid exponent in \"" + currentFactor + "\"");
+			}
+
+			exponent = std::stoul(parts[1]);
+		}
+
+		std::string &base = parts[0];
+		boost::trim(base);
+
+		ct::ContractionResult::cost_t baseValue;
+		if (std::all_of(base.begin(), base.end(), isDigit)) {
+			baseValue = ct::ContractionResult::cost_t(base);
+		} else {
+			if (boost::starts_with(base, "N_")) {
+				base.erase(0, 2);
+			}
+
+			try {
+				const ct::IndexSpace space = base.size() == 1 ? resolver.resolve(base[0]) : resolver.resolve(base);
+
+				baseValue = resolver.getMeta(space).getSize();
+			} catch (const cu::ResolveException &e) {
+				throw std::invalid_argument("Unknown index space \"" + base + "\"");
+			}
+		}
+
+		for (unsigned long i = 0; i < exponent; ++i) {
+			size *= baseValue;
+		}
+	}
+
+	return size;
+}
+
+std::vector< cu::IndexSpaceResolver > parseSizeRange(const std::string &specification,
+													  const cu::IndexSpaceResolver &resolver) {
+	std::vector< std::string > ranges;
+	boost::split(ranges, specification, boost::is_any_of(","));
+
+	// Start with only the nominal sizes and add the values of every range one after another
+	std::vector< cu::IndexSpaceResolver::meta_list_t > points = { resolver.getMetaList() };
+
+	for (std::string &currentRange : ranges) {
+		boost::trim(currentRange);
+
+		std::vector< std::string > parts;
+		boost::split(parts, currentRange, boost::is_any_of("=:"));
+
+		if (parts.size() != 3) {
+			throw std::invalid_argument("Invalid range \"" + currentRange + "\" (expected <space>=<min>:<max>)");
+		}
+
+		for (std::string &currentPart : parts) {
+			boost::trim(currentPart);
+		}
+
+		std::string &spaceName = parts[0];
+		if (boost::starts_with(spaceName, "N_")) {
+			spaceName.erase(0, 2);
+		}
+
+		ct::IndexSpace space;
+		try {
+			space = spaceName.size() == 1 ? resolver.resolve(spaceName[0]) : resolver.resolve(spaceName);
+		} catch (const cu::ResolveException &e) {
+			throw std::invalid_argument("Unknown index space \"" + spaceName + "\"");
+		}
+
+		for (std::size_t i = 1; i < parts.size(); ++i) {
+			// See parseSize for why the chars are converted to unsigned char
+			const bool isNumber = std::all_of(parts[i].begin(), parts[i].end(),
+											  [](unsigned char c) { return std::isdigit(c) != 0; });
+
+			if (parts[i].empty() || parts[i].size() > 9 || !isNumber) {
+				throw std::invalid_argument("Invalid size \"" + parts[i] + "\" in range \"" + currentRange + "\"");
+			}
+		}
+
+		const ct::IndexSpaceMeta::size_t min = static_cast< ct::IndexSpaceMeta::size_t >(std::stoul(parts[1]));
+		const ct::IndexSpaceMeta::size_t max = static_cast< ct::IndexSpaceMeta::size_t >(std::stoul(parts[2]));
+
+		if (min == 0 || min > max) {
+			throw std::invalid_argument("Invalid range \"" + currentRange + "\" (sizes must be positive and ordered)");
+		}
+
+		std::vector< ct::IndexSpaceMeta::size_t > values = { min };
+		const ct::IndexSpaceMeta::size_t mean =
+			static_cast< ct::IndexSpaceMeta::size_t >(std::lround(std::sqrt(static_cast< double >(min) * max)));
+		for (ct::IndexSpaceMeta::size_t currentValue : { mean, max }) {
+			if (currentValue != values.back()) {
+				values.push_back(currentValue);
+			}
+		}
+
+		std::vector< cu::IndexSpaceResolver::meta_list_t > extendedPoints;
+		for (const cu::IndexSpaceResolver::meta_list_t &currentPoint : points) {
+			for (ct::IndexSpaceMeta::size_t currentValue : values) {
+				cu::IndexSpaceResolver::meta_list_t extended = currentPoint;
+
+				for (ct::IndexSpaceMeta &currentMeta : extended) {
+					if (currentMeta.getSpace() == space) {
+						currentMeta.setSize(currentValue);
+					}
+				}
+
+				extendedPoints.push_back(std::move(extended));
+			}
+		}
+
+		points = std::move(extendedPoints);
+	}
+
+	std::vector< cu::IndexSpaceResolver > resolvers;
+	for (cu::IndexSpaceResolver::meta_list_t &currentPoint : points) {
+		resolvers.emplace_back(std::move(currentPoint));
+	}
+
+	return resolvers;
+}
+
 int main(int argc, const char **argv) {
 	// First parse the command line arguments
 	CommandLineArguments args;
@@ -551,25 +747,151 @@ int main(int argc, const char **argv) {
 
 	// Factorize terms
 	printer.printHeadline("Factorization");
-	cpr::Factorizer factorizer(resolver);
-	ct::ContractionResult::cost_t totalCost = 0;
-	std::size_t totalScalingExponent        = 0;
+	ct::ContractionResult::cost_t totalCost          = 0;
+	ct::ContractionResult::cost_t totalReuseSavings  = 0;
+	ct::ContractionResult::cost_t totalDenseCost     = 0;
+	ct::ContractionResult::cost_t totalReducedCost   = 0;
+	ct::ContractionResult::cost_t totalTransposeCost = 0;
+	ct::CostPolynomial totalCostPolynomial;
+	std::size_t totalScalingExponent                 = 0;
+	std::size_t totalExpandedNodes                   = 0;
+	std::size_t totalPrunedNodes                     = 0;
+
+	// The factorization of the Terms within a composite depends on the Terms produced for the previous Terms in that
+	// composite (intermediate names must not clash). Different composites are completely independent of each other
+	// though, which is why these can be factorized concurrently. The results are printed in the original order
+	// afterwards so that the output does not depend on the amount of jobs used.
+	struct FactorizationResult {
+		std::vector< ct::BinaryTerm > terms;
+		ct::ContractionResult::cost_t cost;
+		ct::ContractionResult::cost_t biggestIntermediateSize;
+		ct::ContractionResult::cost_t reuseSavings;
+		ct::ContractionResult::cost_t denseCost;
+		ct::ContractionResult::cost_t symmetryReducedCost;
+		ct::ContractionResult::cost_t transposeCost;
+		cpr::Factorizer::SearchStatistics statistics;
+		std::vector< cpr::Factorizer::ParetoPoint > paretoFront;
+		std::size_t paretoChoice;
+		ct::CostPolynomial costPolynomial;
+		double worstCostRatio;
+	};
+
+	std::vector< const ct::GeneralCompositeTerm * > composites;
+	for (const ct::GeneralTermGroup &currentGroup : termGroups) {
+		for (const ct::GeneralCompositeTerm &currentComposite : currentGroup) {
+			composites.push_back(&currentComposite);
+		}
+	}
+
+	const std::size_t jobs = args.jobs > 0 ? args.jobs : std::max(std::thread::hardware_concurrency(), 1u);
+	// Every thread uses its own Factorizer as these keep state during the factorization
+	cpr::Factorizer prototypeFactorizer(resolver, args.factorizationEngine);
+	prototypeFactorizer.setJobs(args.searchJobs > 0 ? args.searchJobs : std::max(std::thread::hardware_concurrency(), 1u));
+	prototypeFactorizer.setReuseAware(args.reuseAwareFactorization);
+	prototypeFactorizer.setPolicy(args.factorizationPolicy);
+	prototypeFactorizer.setRecordParetoFront(args.printParetoFront);
+	prototypeFactorizer.setSymmetryAware(args.symmetryAwareCost);
+	prototypeFactorizer.setLayoutAware(args.layoutAwareFactorization);
+
+	if (!args.maxIntermediateSize.empty()) {
+		try {
+			prototypeFactorizer.setMaxIntermediateSize(parseSize(args.maxIntermediateSize, resolver));
+		} catch (const std::invalid_argument &e) {
+			std::cerr << "[ERROR]: Invalid value \"" << args.maxIntermediateSize
+					  << "\" for --max-intermediate-size: " << e.what() << std::endl;
+			return Contractor::ExitCodes::INVALID_COMMANDLINE_OPTION_VALUE;
+		}
+
+		printer << "Intermediates are limited to " << prototypeFactorizer.getMaxIntermediateSize() << " elements\n\n";
+	}
+
+	if (!args.sizeRange.empty()) {
+		if (args.printParetoFront || args.factorizationPolicy != cpr::Factorizer::Policy::MinimumCost) {
+			std::cerr << "[ERROR]: --size-range can't be combined with --pareto-front or --factorization-policy"
+					  << std::endl;
+			return Contractor::ExitCodes::INVALID_COMMANDLINE_OPTION_VALUE;
+		}
+		if (args.symmetryAwareCost) {
+			std::cerr << "[ERROR]: --size-range can't be combined with --symmetry-aware-cost" << std::endl;
+			return Contractor::ExitCodes::INVALID_COMMANDLINE_OPTION_VALUE;
+		}
+
+		try {
+			prototypeFactorizer.setSizePoints(parseSizeRange(args.sizeRange, resolver));
+		} catch (const std::invalid_argument &e) {
+			std::cerr << "[ERROR]: Invalid value \"" << args.sizeRange << "\" for --size-range: " << e.what()
+					  << std::endl;
+			return Contractor::ExitCodes::INVALID_COMMANDLINE_OPTION_VALUE;
+		}
+
+		printer << "Factorizations are evaluated at " << prototypeFactorizer.getSizePointCount()
+				<< " additional combinations of index space sizes\n\n";
+	}
+
+	if (!args.factorizationCacheFile.empty() && std::filesystem::exists(args.factorizationCacheFile)) {
+		std::ifstream cacheStream(args.factorizationCacheFile);
+
+		if (prototypeFactorizer.readCache(cacheStream)) {
+			printer << "Loaded " << prototypeFactorizer.getCacheSize() << " cached factorizations from "
+					<< args.factorizationCacheFile.string() << "\n\n";
+		} else {
+			printer << "Discarding outdated factorization cache " << args.factorizationCacheFile.string() << "\n\n";
+		}
+	}
+
+	std::vector< cpr::Factorizer > factorizers(std::max< std::size_t >(std::min(jobs, composites.size()), 1),
+											   prototypeFactorizer);
+	std::vector< std::vector< FactorizationResult > > compositeResults(composites.size());
+
+	try {
+		cu::parallelFor(composites.size(), factorizers.size(), [&](std::size_t index, std::size_t threadIndex) {
+			cpr::Factorizer &factorizer = factorizers[threadIndex];
+			std::vector< ct::BinaryTerm > producedTerms;
+
+			for (const ct::GeneralTerm &currentGeneral : *composites[index]) {
+				FactorizationResult result;
+				result.terms                   = factorizer.factorize(currentGeneral, producedTerms);
+				result.cost                    = factorizer.getLastFactorizationCost();
+				result.biggestIntermediateSize = factorizer.getLastBiggestIntermediateSize();
+				result.reuseSavings            = factorizer.getLastReuseSavings();
+				result.denseCost               = factorizer.getLastDenseCost();
+				result.symmetryReducedCost     = factorizer.getLastSymmetryReducedCost();
+				result.transposeCost           = factorizer.getLastTransposeCost();
+				result.statistics              = factorizer.getLastSearchStatistics();
+				result.paretoFront             = factorizer.getLastParetoFront();
+				result.paretoChoice            = factorizer.getLastParetoChoice();
+				result.costPolynomial          = factorizer.getLastCostPolynomial();
+				result.worstCostRatio          = factorizer.getLastWorstCostRatio();
+
+				producedTerms.insert(producedTerms.end(), result.terms.begin(), result.terms.end());
+
+				compositeResults[index].push_back(std::move(result));
+			}
+		});
+	} catch (const cpr::FactorizationException &e) {
+		cf::PrettyPrinter errorPrinter(std::cerr, args.asciiOnlyOutput);
+		errorPrinter << "[ERROR]: Unable to factorize " << e.getTerm() << "\n  " << e.what() << "\n";
+		return Contractor::ExitCodes::INFEASIBLE_FACTORIZATION;
+	}
 
 	std::vector< ct::BinaryTermGroup > factorizedTermGroups;
 
+	std::size_t compositeIndex = 0;
 	for (ct::GeneralTermGroup &currentGroup : termGroups) {
 		ct::BinaryTermGroup currentFactorizedGroup(currentGroup.getOriginalTerm());
 
 		for (const ct::GeneralCompositeTerm &currentComposite : currentGroup) {
 			ct::BinaryCompositeTerm resultComposite;
-			std::vector< ct::BinaryTerm > producedTerms;
+			std::vector< FactorizationResult > &currentResults = compositeResults[compositeIndex++];
+
+			assert(currentResults.size() == currentComposite.size());
 
-			for (const ct::GeneralTerm &currentGeneral : currentComposite) {
-				std::vector< ct::BinaryTerm > currentBinary = factorizer.factorize(currentGeneral, producedTerms);
-				ct::ContractionResult::cost_t cost          = factorizer.getLastFactorizationCost();
+			for (std::size_t i = 0; i < currentComposite.size(); ++i) {
+				const ct::GeneralTerm &currentGeneral = currentComposite[i];
+				FactorizationResult &currentResult    = currentResults[i];
 
 				printer << currentGeneral << " factorizes to\n";
-				for (const ct::BinaryTerm &current : currentBinary) {
+				for (ct::BinaryTerm &current : currentResult.terms) {
 					printer << "  " << current << "\n";
 					printer << "  -> ";
 					printer.printScaling(current.getFormalScaling(), resolver);
@@ -584,8 +906,6 @@ int main(int argc, const char **argv) {
 
 					totalScalingExponent = std::max(totalScalingExponent, currentTotalScaling);
 
-					producedTerms.push_back(current);
-
 					if (current.getResult() != currentComposite.getResult()) {
 						// This Term is not a direct contribution of the original composite Term. Therefore it
 						// must be a Term on its own (factorization does not add any additive components that
@@ -599,10 +919,44 @@ int main(int argc, const char **argv) {
 					}
 				}
 
-				printer << "Estimated cost of carrying out the contraction: " << cost << "\n";
-				printer << "Biggest intermediate's size: " << factorizer.getLastBiggestIntermediateSize() << "\n\n";
+				printer << "Estimated cost of carrying out the contraction: " << currentResult.cost << "\n";
+				printer << "Biggest intermediate's size: " << currentResult.biggestIntermediateSize << "\n";
+				if (args.reuseAwareFactorization) {
+					printer << "Cost saved by reusing intermediates: " << currentResult.reuseSavings << "\n";
+				}
+				if (args.symmetryAwareCost) {
+					printer << "Dense cost: " << currentResult.denseCost
+							<< ", symmetry-reduced cost: " << currentResult.symmetryReducedCost << "\n";
+				}
+				if (args.layoutAwareFactorization) {
+					printer << "Elements to transpose for GEMMs: " << currentResult.transposeCost << "\n";
+				}
+				if (!args.sizeRange.empty()) {
+					printer << "Cost polynomial: ";
+					printer.printCost(currentResult.costPolynomial, resolver);
+					printer << "\nWorst-case ratio to the optimal cost within the size range: "
+							<< currentResult.worstCostRatio << "\n";
+				}
+				if (args.printParetoFront) {
+					printer << "Pareto front (cost / biggest intermediate's size):\n";
+					for (std::size_t j = 0; j < currentResult.paretoFront.size(); ++j) {
+						const cpr::Factorizer::ParetoPoint &currentPoint = currentResult.paretoFront[j];
 
-				totalCost += cost;
+						printer << (j == currentResult.paretoChoice ? "  * " : "    ") << currentPoint.cost << " / "
+								<< currentPoint.biggestIntermediate << "\n";
+					}
+				}
+				printer << "Search nodes expanded: " << currentResult.statistics.expandedNodes
+						<< ", pruned: " << currentResult.statistics.prunedNodes << "\n\n";
+
+				totalCost += currentResult.cost;
+				totalCostPolynomial += currentResult.costPolynomial;
+				totalReuseSavings += currentResult.reuseSavings;
+				totalDenseCost += currentResult.denseCost;
+				totalReducedCost += currentResult.symmetryReducedCost;
+				totalTransposeCost += currentResult.transposeCost;
+				totalExpandedNodes += currentResult.statistics.expandedNodes;
+				totalPrunedNodes += currentResult.statistics.prunedNodes;
 			}
 
 			// Also add the composite Term for the result
@@ -613,7 +967,49 @@ int main(int argc, const char **argv) {
 		factorizedTermGroups.push_back(std::move(currentFactorizedGroup));
 	}
 
-	printer << "Total # of operations: " << totalCost << "\nFormal scaling: N^" << totalScalingExponent << "\n\n\n";
+	printer << "Total # of operations: " << totalCost << "\nFormal scaling: N^" << totalScalingExponent << "\n";
+	if (!args.sizeRange.empty()) {
+		printer << "Total cost polynomial: ";
+		printer.printCost(totalCostPolynomial, resolver);
+		printer << "\n";
+	}
+	if (args.reuseAwareFactorization) {
+		printer << "Total cost saved by reusing intermediates: " << totalReuseSavings << "\n";
+	}
+	if (args.symmetryAwareCost) {
+		printer << "Total # of operations (dense): " << totalDenseCost << "\n";
+		printer << "Total # of operations (symmetry-reduced): " << totalReducedCost << "\n";
+	}
+	if (args.layoutAwareFactorization) {
+		printer << "Total # of elements to transpose for GEMMs: " << totalTransposeCost << "\n";
+	}
+	printer << "Total # of search nodes expanded: " << totalExpandedNodes << ", pruned: " << totalPrunedNodes << "\n";
+
+	// Every thread has its own cache and which composites a thread gets to process depends on the scheduling. Hence
+	// the cache statistics (and the amount of searching that had to be done) may vary with the amount of jobs. The
+	// factorizations themselves don't, as a cache hit yields the same factorization as a fresh search would.
+	std::size_t cacheHits   = 0;
+	std::size_t cacheMisses = 0;
+	for (const cpr::Factorizer &currentFactorizer : factorizers) {
+		cacheHits += currentFactorizer.getCacheHits();
+		cacheMisses += currentFactorizer.getCacheMisses();
+	}
+
+	printer << "Factorization cache hits: " << cacheHits << ", misses: " << cacheMisses << "\n\n\n";
+
+	if (!args.factorizationCacheFile.empty()) {
+		for (std::size_t i = 1; i < factorizers.size(); ++i) {
+			factorizers[0].mergeCache(factorizers[i]);
+		}
+
+		std::ofstream cacheStream(args.factorizationCacheFile);
+		if (cacheStream) {
+			factorizers[0].writeCache(cacheStream);
+		} else {
+			// The cache only serves to speed up subsequent runs -> not being able to write it is not an error
+			std::cerr << "Unable to write factorization cache to " << args.factorizationCacheFile << std::endl;
+		}
+	}
 
 	printer.printHeadline("Factorized Terms");
 	printer << factorizedTermGroups << "\n\n";
@@ -941,6 +1337,30 @@ int main(int argc, const char **argv) {
 	simplify(factorizedTermGroups, printer);
 
 
+	if (args.shareIntermediates) {
+		printer.printHeadline("Sharing intermediates between term groups");
+
+		std::unordered_set< std::string_view > nonIntermediateNames;
+		nonIntermediateNames.reserve(resultTensorNames.size() + baseTensorNames.size());
+
+		nonIntermediateNames.insert(resultTensorNames.begin(), resultTensorNames.end());
+		nonIntermediateNames.insert(baseTensorNames.begin(), baseTensorNames.end());
+
+		ct::ContractionResult::cost_t savedOperations =
+			cpr::shareIntermediates(factorizedTermGroups, resolver, [&](std::string_view name) {
+				return nonIntermediateNames.find(name) == nonIntermediateNames.end();
+			}, printer);
+
+		if (savedOperations == 0) {
+			printer << "  Nothing to do\n";
+		} else {
+			printer << "\nTotal # of operations saved: " << savedOperations << "\n";
+		}
+
+		printer << "\n\n";
+	}
+
+
 	// Check for unneeded terms
 	printer.printHeadline("Checking for redundant terms");
 	bool changed;
@@ -997,9 +1417,12 @@ int main(int argc, const char **argv) {
 
 
 	// Verify that all tensors that are referenced actually exist (and are declared before they are referenced)
+	// Intermediates are local to the group calculating them, unless they are shared between groups
+	std::unordered_set< ct::Tensor, ct::Tensor::tensor_element_hash, ct::Tensor::is_same_tensor_element >
+		sharedIntermediates;
 	for (const ct::BinaryTermGroup &currentGroup : factorizedTermGroups) {
 		std::unordered_set< ct::Tensor, ct::Tensor::tensor_element_hash, ct::Tensor::is_same_tensor_element >
-			definedIntermediates;
+			definedIntermediates = sharedIntermediates;
 
 		for (const ct::BinaryCompositeTerm &currentComposite : currentGroup) {
 			for (const ct::BinaryTerm &currentTerm : currentComposite) {
@@ -1021,6 +1444,10 @@ int main(int argc, const char **argv) {
 			}
 
 			definedIntermediates.insert(currentComposite.getResult());
+
+			if (args.shareIntermediates) {
+				sharedIntermediates.insert(currentComposite.getResult());
+			}
 		}
 	}
 
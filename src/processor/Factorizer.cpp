@@ -1,9 +1,24 @@
 #include "processor/Factorizer.hpp"
+#include "processor/LayoutCost.hpp"
 #include "processor/Simplifier.hpp"
+#include "terms/CanonicalLabelling.hpp"
+#include "terms/IndexSpaceMeta.hpp"
 #include "utils/IndexSpaceResolver.hpp"
 #include "utils/PairingGenerator.hpp"
+#include "utils/ParallelFor.hpp"
 
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iterator>
 #include <limits.h>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
 #include <string>
 
 namespace ct = Contractor::Terms;
@@ -13,7 +28,98 @@ namespace Contractor::Processor {
 
 using cost_t = ct::ContractionResult::cost_t;
 
-Factorizer::Factorizer(const cu::IndexSpaceResolver &resolver) : m_resolver(resolver) {
+namespace {
+	/**
+	 * @returns A description of the index spaces known to the given resolver
+	 */
+	nlohmann::json getIndexSpaceDescription(const cu::IndexSpaceResolver &resolver) {
+		nlohmann::json description = nlohmann::json::array();
+
+		for (const ct::IndexSpaceMeta &currentMeta : resolver.getMetaList()) {
+			description.push_back({ { "id", currentMeta.getSpace().getID() },
+									{ "name", currentMeta.getName() },
+									{ "size", currentMeta.getSize() } });
+		}
+
+		return description;
+	}
+
+	/**
+	 * @returns A textual representation of the given key, suitable for identifying entries in the cache file
+	 */
+	std::string describeKey(const ct::CanonicalLabelling::key_t &key) {
+		std::string description;
+
+		for (ct::CanonicalLabelling::key_entry_t currentEntry : key) {
+			description += std::to_string(currentEntry) + " ";
+		}
+
+		return description;
+	}
+
+	/**
+	 * @returns Whether all of the given indices also appear among the other given indices
+	 */
+	bool isContainedIn(const ct::Tensor::index_list_t &indices, const ct::Tensor::index_list_t &other) {
+		return std::all_of(indices.begin(), indices.end(), [&other](const ct::Index &current) {
+			return std::any_of(other.begin(), other.end(),
+							   [&current](const ct::Index &candidate) { return ct::Index::isSame(current, candidate); });
+		});
+	}
+
+	/**
+	 * @returns Whether the result of contracting the given Tensors has a different index sequence depending on which
+	 * of them is the left operand
+	 */
+	bool dependsOnOperandOrder(const ct::Tensor &lhs, const ct::Tensor &rhs) {
+		return !isContainedIn(lhs.getIndices(), rhs.getIndices()) && !isContainedIn(rhs.getIndices(), lhs.getIndices());
+	}
+
+	/**
+	 * Determines which indices get contracted and which remain when contracting Tensors with the given indices. This
+	 * follows the exact same logic as Tensor::contract.
+	 */
+	void splitIndices(const ct::Tensor::index_list_t &left, const ct::Tensor::index_list_t &right,
+					  ct::Tensor::index_list_t &contractedIndices, ct::Tensor::index_list_t &resultIndices) {
+		for (const ct::Index &currentIndex : left) {
+			auto it = std::find_if(right.begin(), right.end(), [currentIndex](const ct::Index &other) {
+				return ct::Index::isSame(currentIndex, other);
+			});
+
+			if (it != right.end()) {
+				contractedIndices.push_back(currentIndex);
+			} else {
+				resultIndices.push_back(currentIndex);
+			}
+		}
+
+		if (contractedIndices.size() != right.size()) {
+			for (const ct::Index &currentIndex : right) {
+				auto isSame = [currentIndex](const ct::Index &other) { return ct::Index::isSame(currentIndex, other); };
+				auto it     = std::find_if(contractedIndices.begin(), contractedIndices.end(), isSame);
+
+				if (it == contractedIndices.end()) {
+					resultIndices.push_back(currentIndex);
+				}
+			}
+		}
+	}
+}; // namespace
+
+FactorizationException::FactorizationException(const std::string_view msg, const ct::GeneralTerm &term)
+	: m_msg(msg), m_term(term) {
+}
+
+const char *FactorizationException::what() const noexcept {
+	return m_msg.c_str();
+}
+
+const ct::GeneralTerm &FactorizationException::getTerm() const {
+	return m_term;
+}
+
+Factorizer::Factorizer(const cu::IndexSpaceResolver &resolver, Engine engine)
+	: m_resolver(resolver), m_engine(engine) {
 }
 
 ct::ContractionResult::cost_t Factorizer::getLastFactorizationCost() const {
@@ -24,27 +130,555 @@ ct::ContractionResult::cost_t Factorizer::getLastBiggestIntermediateSize() const
 	return m_biggestIntermediateSize;
 }
 
+const ct::CostPolynomial &Factorizer::getLastCostPolynomial() const {
+	return m_bestCostPolynomial;
+}
+
+Factorizer::Engine Factorizer::getEngine() const {
+	return m_engine;
+}
+
+void Factorizer::setEngine(Engine engine) {
+	m_engine = engine;
+}
+
+std::size_t Factorizer::getCacheHits() const {
+	return m_cacheHits;
+}
+
+std::size_t Factorizer::getCacheMisses() const {
+	return m_cacheMisses;
+}
+
+void Factorizer::clearCache() {
+	m_cache.clear();
+	m_cacheHits   = 0;
+	m_cacheMisses = 0;
+}
+
+void Factorizer::mergeCache(const Factorizer &other) {
+	for (const auto &currentEntry : other.m_cache) {
+		m_cache.insert(currentEntry);
+	}
+}
+
+std::size_t Factorizer::getCacheSize() const {
+	return m_cache.size();
+}
+
+void Factorizer::writeCache(std::ostream &stream) const {
+	nlohmann::json json;
+	json["version"]       = cacheFormatVersion;
+	json["indexSpaces"]   = getIndexSpaceDescription(m_resolver);
+	json["symmetryAware"] = m_symmetryAware;
+	json["layoutAware"]   = m_layoutAware;
+
+	// Write the entries sorted by their signature so that the produced file does not depend on the hashing order
+	std::vector< const std::pair< const std::string, CachedFactorization > * > entries;
+	for (const auto &currentEntry : m_cache) {
+		entries.push_back(&currentEntry);
+	}
+	std::sort(entries.begin(), entries.end(), [](const auto *lhs, const auto *rhs) { return lhs->first < rhs->first; });
+
+	nlohmann::json entryList = nlohmann::json::array();
+	for (const auto *currentEntry : entries) {
+		entryList.push_back({ { "signature", currentEntry->first }, { "order", currentEntry->second.order } });
+	}
+	json["entries"] = std::move(entryList);
+
+	stream << json.dump(1, '\t') << "\n";
+}
+
+bool Factorizer::readCache(std::istream &stream) {
+	cache_t readEntries;
+
+	try {
+		nlohmann::json json = nlohmann::json::parse(stream);
+
+		if (json.at("version").get< unsigned int >() != cacheFormatVersion
+			|| json.at("indexSpaces") != getIndexSpaceDescription(m_resolver)) {
+			// The cached costs (and thus the cached factorizations) are no longer valid
+			return false;
+		}
+
+		if (json.at("symmetryAware").get< bool >() != m_symmetryAware
+			|| json.at("layoutAware").get< bool >() != m_layoutAware) {
+			// The cached factorizations have been found with a different cost model
+			return false;
+		}
+
+		for (const nlohmann::json &currentEntry : json.at("entries")) {
+			CachedFactorization factorization;
+			currentEntry.at("order").get_to(factorization.order);
+
+			if (!isValidOrder(factorization.order, factorization.order.size() + 1)) {
+				// The file has been modified or is corrupted
+				return false;
+			}
+
+			readEntries[currentEntry.at("signature").get< std::string >()] = std::move(factorization);
+		}
+	} catch (const nlohmann::json::exception &) {
+		// A broken cache is treated the same way as an outdated one
+		return false;
+	}
+
+	for (auto &currentEntry : readEntries) {
+		m_cache.insert(std::move(currentEntry));
+	}
+
+	return true;
+}
+
+std::size_t Factorizer::getJobs() const {
+	return m_jobs;
+}
+
+void Factorizer::setJobs(std::size_t jobs) {
+	m_jobs = std::max< std::size_t >(jobs, 1);
+}
+
+const Factorizer::SearchStatistics &Factorizer::getLastSearchStatistics() const {
+	return m_statistics;
+}
+
+const std::vector< Factorizer::CacheLookup > &Factorizer::getLastCacheLookups() const {
+	return m_cacheLookups;
+}
+
+bool Factorizer::isReuseAware() const {
+	return m_reuseAware;
+}
+
+void Factorizer::setReuseAware(bool reuseAware) {
+	m_reuseAware = reuseAware;
+}
+
+cost_t Factorizer::getLastReuseSavings() const {
+	return m_bestReuseSavings;
+}
+
+cost_t Factorizer::getMaxIntermediateSize() const {
+	return m_maxIntermediateSize;
+}
+
+void Factorizer::setMaxIntermediateSize(const cost_t &maxSize) {
+	m_maxIntermediateSize = maxSize;
+}
+
+bool Factorizer::hasIntermediateSizeLimit() const {
+	return m_maxIntermediateSize != std::numeric_limits< cost_t >::max();
+}
+
+Factorizer::Policy Factorizer::getPolicy() const {
+	return m_policy;
+}
+
+void Factorizer::setPolicy(Policy policy) {
+	m_policy = policy;
+}
+
+bool Factorizer::isRecordingParetoFront() const {
+	return m_recordParetoFront;
+}
+
+void Factorizer::setRecordParetoFront(bool record) {
+	m_recordParetoFront = record;
+}
+
+const std::vector< Factorizer::ParetoPoint > &Factorizer::getLastParetoFront() const {
+	return m_paretoFront;
+}
+
+std::size_t Factorizer::getLastParetoChoice() const {
+	return m_paretoChoice;
+}
+
+std::size_t Factorizer::getSizePointCount() const {
+	return m_sizePoints ? m_sizePoints->size() : 0;
+}
+
+void Factorizer::setSizePoints(std::vector< cu::IndexSpaceResolver > sizePoints) {
+	m_pointFactorizers.clear();
+
+	if (sizePoints.empty()) {
+		m_sizePoints.reset();
+		return;
+	}
+
+	// The point Factorizers only keep a reference to their resolver which therefore must not move in memory
+	m_sizePoints = std::make_shared< const std::vector< cu::IndexSpaceResolver > >(std::move(sizePoints));
+
+	for (const cu::IndexSpaceResolver &currentPoint : *m_sizePoints) {
+		m_pointFactorizers.emplace_back(currentPoint, m_engine);
+	}
+}
+
+double Factorizer::getLastWorstCostRatio() const {
+	return m_worstCostRatio;
+}
+
+bool Factorizer::isSymmetryAware() const {
+	return m_symmetryAware;
+}
+
+void Factorizer::setSymmetryAware(bool symmetryAware) {
+	m_symmetryAware = symmetryAware;
+}
+
+cost_t Factorizer::getLastDenseCost() const {
+	return m_bestDenseCost;
+}
+
+cost_t Factorizer::getLastSymmetryReducedCost() const {
+	return m_bestSymmetryReducedCost;
+}
+
+bool Factorizer::isLayoutAware() const {
+	return m_layoutAware;
+}
+
+void Factorizer::setLayoutAware(bool layoutAware) {
+	m_layoutAware = layoutAware;
+}
+
+cost_t Factorizer::getLastTransposeCost() const {
+	return m_bestTransposeCost;
+}
+
 const std::vector< ct::BinaryTerm > &Factorizer::factorize(const ct::GeneralTerm &term,
 														   const std::vector< ct::BinaryTerm > &previousTerms) {
+	m_statistics = {};
+	m_cacheLookups.clear();
+	m_paretoFront.clear();
+	m_paretoChoice   = 0;
+	m_worstCostRatio = 1;
+
+	// Intermediates computed by previous Terms can be reused (the Terms contributing to the final result can't)
+	m_reusableTerms.clear();
+	if (m_reuseAware && term.size() > 1) {
+		for (const ct::BinaryTerm &currentTerm : previousTerms) {
+			if (currentTerm.getResult().getInternedName() != term.getResult().getInternedName()) {
+				m_reusableTerms.push_back(&currentTerm);
+			}
+		}
+	}
+
+	if (m_recordParetoFront || m_policy != Policy::MinimumCost) {
+		findParetoFront(term, previousTerms);
+
+		m_paretoChoice            = choosePoint();
+		const ParetoPoint &chosen = m_paretoFront[m_paretoChoice];
+		m_bestFactorization       = chosen.terms;
+		m_bestCost                = chosen.cost;
+		m_biggestIntermediateSize = chosen.biggestIntermediate;
+		m_bestReuseSavings        = chosen.reuseSavings;
+	} else if (!m_pointFactorizers.empty() && term.size() > 2 && !m_symmetryAware) {
+		findRobustFactorization(term, previousTerms);
+	} else {
+		findOptimalFactorization(term, previousTerms);
+
+		// Potentially change index orders if the symmetry allows it and it would lead to a more "canonical"
+		// representation of the term
+		finalizeIndexSequences(m_bestFactorization);
+	}
+
+	m_bestCostPolynomial      = getCostPolynomial(m_bestFactorization);
+	m_bestDenseCost           = m_bestCostPolynomial.evaluate(m_resolver);
+	m_bestSymmetryReducedCost = getSymmetryReducedCost(m_bestFactorization);
+	assert((m_symmetryAware ? m_bestSymmetryReducedCost : m_bestDenseCost) == m_bestCost);
+	m_bestTransposeCost = getTotalTransposeCost(m_bestFactorization);
+
+	return m_bestFactorization;
+}
+
+void Factorizer::findRobustFactorization(const ct::GeneralTerm &term,
+										 const std::vector< ct::BinaryTerm > &previousTerms) {
+	// The first candidate is the factorization that is optimal for the sizes of this Factorizer's resolver
+	findOptimalFactorization(term, previousTerms);
+
+	std::vector< std::vector< ct::BinaryTerm > > candidates = { std::move(m_bestFactorization) };
+	finalizeIndexSequences(candidates[0]);
+
+	for (std::size_t i = 0; i < m_pointFactorizers.size(); ++i) {
+		Factorizer &currentFactorizer = m_pointFactorizers[i];
+		currentFactorizer.setEngine(m_engine);
+		currentFactorizer.setJobs(m_jobs);
+		currentFactorizer.setReuseAware(m_reuseAware);
+
+		const std::vector< ct::BinaryTerm > &currentFactorization = currentFactorizer.factorize(term, previousTerms);
+
+		m_statistics.expandedNodes += currentFactorizer.getLastSearchStatistics().expandedNodes;
+		m_statistics.prunedNodes += currentFactorizer.getLastSearchStatistics().prunedNodes;
+
+		for (CacheLookup currentLookup : currentFactorizer.getLastCacheLookups()) {
+			currentLookup.sizePoint = i + 1;
+			m_cacheLookups.push_back(std::move(currentLookup));
+		}
+
+		if (std::find(candidates.begin(), candidates.end(), currentFactorization) == candidates.end()) {
+			candidates.push_back(currentFactorization);
+		}
+	}
+
+	std::vector< ct::CostPolynomial::size_point_t > sizePoints = { ct::CostPolynomial::getSizePoint(m_resolver) };
+	for (const cu::IndexSpaceResolver &currentPoint : *m_sizePoints) {
+		sizePoints.push_back(ct::CostPolynomial::getSizePoint(currentPoint));
+	}
+
+	// Evaluate every admissible candidate at every size point
+	std::vector< ct::CostPolynomial > polynomials;
+	std::vector< ct::CostPolynomial > reuseSavings;
+	std::vector< std::vector< cost_t > > costs;
+	std::vector< bool > admissible;
+	for (const std::vector< ct::BinaryTerm > &currentCandidate : candidates) {
+		reuseSavings.emplace_back();
+		polynomials.push_back(getCostPolynomial(currentCandidate, &reuseSavings.back()));
+
+		costs.emplace_back();
+		for (const ct::CostPolynomial::size_point_t &currentPoint : sizePoints) {
+			costs.back().push_back(polynomials.back().evaluate(currentPoint));
+		}
+
+		// The size limit applies to all but the last Term (which produces the result Tensor)
+		admissible.push_back(std::all_of(currentCandidate.begin(), currentCandidate.end() - 1,
+										 [this](const ct::BinaryTerm &current) {
+											 return getElementCount(current.getResult().getIndices())
+													<= m_maxIntermediateSize;
+										 }));
+	}
+
+	// The first candidate is optimal for the first size point and admissible by construction
+	assert(admissible[0]);
+
+	std::vector< cost_t > optima = costs[0];
+	for (std::size_t i = 1; i < candidates.size(); ++i) {
+		for (std::size_t j = 0; j < sizePoints.size(); ++j) {
+			if (admissible[i]) {
+				optima[j] = std::min(optima[j], costs[i][j]);
+			}
+		}
+	}
+
+	// Find the candidate with the smallest worst-case ratio of its cost to the optimal cost. The ratios are compared
+	// as fractions in order to stay exact. Ties are broken in favor of the earlier candidate.
+	std::size_t best = 0;
+	std::pair< cost_t, cost_t > bestRatio;
+	for (std::size_t i = 0; i < candidates.size(); ++i) {
+		if (!admissible[i]) {
+			continue;
+		}
+
+		std::pair< cost_t, cost_t > worstRatio = { 1, 1 };
+		for (std::size_t j = 0; j < sizePoints.size(); ++j) {
+			if (optima[j] != 0 && costs[i][j] * worstRatio.second > worstRatio.first * optima[j]) {
+				worstRatio = { costs[i][j], optima[j] };
+			}
+		}
+
+		if (i == 0 || worstRatio.first * bestRatio.second < bestRatio.first * worstRatio.second) {
+			best      = i;
+			bestRatio = std::move(worstRatio);
+		}
+	}
+
+	m_bestFactorization = std::move(candidates[best]);
+	m_bestCost          = costs[best][0];
+	m_bestReuseSavings  = reuseSavings[best].evaluate(sizePoints[0]);
+	m_worstCostRatio    = bestRatio.first.convert_to< double >() / bestRatio.second.convert_to< double >();
+
+	m_biggestIntermediateSize = 0;
+	for (const ct::BinaryTerm &currentTerm : m_bestFactorization) {
+		m_biggestIntermediateSize =
+			std::max(m_biggestIntermediateSize, getElementCount(currentTerm.getResult().getIndices()));
+	}
+}
+
+void Factorizer::findParetoFront(const ct::GeneralTerm &term, const std::vector< ct::BinaryTerm > &previousTerms) {
+	// The result Tensor has to be produced by every factorization and is exempt from the intermediate size limit.
+	// Hence no factorization can have a smaller biggest intermediate than that.
+	const cost_t resultSize = getElementCount(term.getResult().getIndices());
+	const cost_t sizeLimit  = m_maxIntermediateSize;
+
+	try {
+		while (true) {
+			findOptimalFactorization(term, previousTerms);
+
+			finalizeIndexSequences(m_bestFactorization);
+
+			// As the optimum is chosen by cost first and by biggest intermediate second, the found factorization
+			// can't be dominated by any other admissible one. Every factorization that has a smaller biggest
+			// intermediate has been inadmissible in the previous searches and thus the cost strictly increases
+			// from one point to the next.
+			m_paretoFront.push_back({ m_bestFactorization, m_bestCost, m_biggestIntermediateSize, m_bestReuseSavings });
+
+			if (m_biggestIntermediateSize <= resultSize) {
+				break;
+			}
+
+			m_maxIntermediateSize = m_biggestIntermediateSize - 1;
+		}
+	} catch (const FactorizationException &) {
+		m_maxIntermediateSize = sizeLimit;
+
+		if (m_paretoFront.empty()) {
+			// There is no factorization at all under the original limit
+			throw;
+		}
+	}
+
+	m_maxIntermediateSize = sizeLimit;
+}
+
+std::size_t Factorizer::choosePoint() const {
+	assert(!m_paretoFront.empty());
+
+	switch (m_policy) {
+		case Policy::MinimumCost:
+			return 0;
+		case Policy::MinimumMemory:
+			return m_paretoFront.size() - 1;
+		case Policy::Balanced: {
+			// Ties are broken in favor of the cheaper factorization
+			std::size_t best = 0;
+			for (std::size_t i = 1; i < m_paretoFront.size(); ++i) {
+				if (m_paretoFront[i].cost * m_paretoFront[i].biggestIntermediate
+					< m_paretoFront[best].cost * m_paretoFront[best].biggestIntermediate) {
+					best = i;
+				}
+			}
+
+			return best;
+		}
+	}
+
+	return 0;
+}
+
+void Factorizer::findOptimalFactorization(const ct::GeneralTerm &term,
+										  const std::vector< ct::BinaryTerm > &previousTerms) {
 	// Initialize the best cost for this factorization with the maximum possible
 	// value so that all possible factorizations will result in a better cost than that
 	m_bestCost                = std::numeric_limits< decltype(m_bestCost) >::max();
 	m_biggestIntermediateSize = std::numeric_limits< decltype(m_biggestIntermediateSize) >::max();
+	m_currentReuseSavings     = 0;
+	m_bestReuseSavings        = 0;
+	m_bestTransposeCost       = std::numeric_limits< decltype(m_bestTransposeCost) >::max();
 
-	// Copy the Tensors of this term into a vector to be used for the factorization
-	std::vector< ct::Tensor > tensors = term.accessTensorList();
-	std::vector< ct::BinaryTerm > factorizedTerms;
+	// Terms consisting of a single Tensor don't require any search and thus are not worth caching. Neither are
+	// factorizations that depend on which intermediates are available for reuse.
+	const bool useCache = term.size() > 1 && m_reusableTerms.empty();
+	std::string signature;
+	auto cacheEntry = m_cache.end();
+	// Cached contraction orders refer to the Tensors in their canonical order rather than the order they have in the
+	// Term, so that Terms that only differ in the order of their Tensors share the same cache entry. The search is
+	// carried out on the Tensors in that order as well, such that looking up a Term yields the exact same
+	// factorization as searching for it would have.
+	std::optional< ct::GeneralTerm > canonicalTerm;
+	if (useCache) {
+		// The search for the optimal factorization doesn't depend on the names of the Tensors. Symmetries only matter
+		// for the symmetry-aware cost and the tie-breaking of layout-aware factorizations, which also depends on the
+		// index sequences of the Tensors and of the result.
+		ct::CanonicalLabelling::Options options;
+		options.names              = false;
+		options.symmetry           = m_symmetryAware || m_layoutAware;
+		options.symmetricSequences = false;
+		options.resultPositions    = m_layoutAware;
+
+		const ct::CanonicalLabelling labelling(term, options);
+
+		signature = describeKey(labelling.getKey());
+		if (hasIntermediateSizeLimit()) {
+			// The limit changes which factorizations are admissible
+			signature += "<=" + m_maxIntermediateSize.str();
+		}
+		// The cost model changes which factorization is the optimal one
+		if (m_symmetryAware) {
+			signature += "|symmetry-aware";
+		}
+		if (m_layoutAware) {
+			signature += "|layout-aware";
+		}
 
-	bool foundFactorization = doFactorize(0, 0, tensors, factorizedTerms, term, previousTerms);
-	assert(foundFactorization);
+		ct::GeneralTerm::tensor_list_t tensors;
+		for (std::size_t currentPosition : labelling.getOrder()) {
+			tensors.push_back(term.accessTensorList()[currentPosition]);
+		}
+		canonicalTerm.emplace(term.getResult(), term.getPrefactor(), std::move(tensors));
+
+		cacheEntry = m_cache.find(signature);
 
-	// Potentially change index orders if the symmetry allows it and it would lead to a more "canonical"
-	// representation of the term
-	for (ct::BinaryTerm &currentTerm : m_bestFactorization) {
-		canonicalizeIndexSequences(currentTerm);
+		if (cacheEntry != m_cache.end() && !isValidOrder(cacheEntry->second.order, term.size())) {
+			// The entry doesn't fit the Term (e.g. because the cache file has been tampered with) and is replaced by
+			// the result of a fresh search
+			cacheEntry = m_cache.end();
+		}
 	}
 
-	return m_bestFactorization;
+	const ct::GeneralTerm &searchedTerm = canonicalTerm ? *canonicalTerm : term;
+
+	if (cacheEntry != m_cache.end()) {
+		// A Term with the exact same shape has been factorized before. As the search only depends on the shape of the
+		// Term, it would come up with the same sequence of contractions again.
+		m_cacheHits++;
+		m_cacheLookups.push_back({ signature, 0, true, {} });
+
+		replayFactorization(cacheEntry->second.order, searchedTerm, previousTerms);
+	} else {
+		const SearchStatistics previousStatistics = m_statistics;
+
+		// The DynamicProgramming engine memoizes subset costs which doesn't work if contractions can become free
+		// depending on how the contracted Tensors have been obtained. It also doesn't know about the intermediate
+		// size limit, about the symmetry of intermediates or about index sequences.
+		if (m_engine == Engine::DynamicProgramming && term.size() > 1 && m_reusableTerms.empty()
+			&& !hasIntermediateSizeLimit() && !m_symmetryAware && !m_layoutAware) {
+			doFactorizeDynamically(searchedTerm, previousTerms);
+		} else {
+			// Copy the Tensors of this term into a vector to be used for the factorization
+			std::vector< ct::Tensor > tensors = searchedTerm.accessTensorList();
+			std::vector< ct::BinaryTerm > factorizedTerms;
+
+			if (tensors.size() > 1) {
+				// Use the cost of a greedy factorization as the initial bound so that pruning can already happen
+				// for the very first paths explored by the exhaustive search
+				SubsetCost greedyCost = getGreedyFactorizationCost(tensors);
+
+				// If the greedy approach runs into the intermediate size limit, there is no initial bound
+				m_incumbentIsSeed         = greedyCost.cost != std::numeric_limits< cost_t >::max();
+				m_bestCost                = std::move(greedyCost.cost);
+				m_biggestIntermediateSize = std::move(greedyCost.biggestIntermediate);
+			}
+
+			m_currentOrder.clear();
+
+			bool foundFactorization;
+			if (m_jobs > 1 && tensors.size() >= minTensorsForConcurrentSearch) {
+				foundFactorization = doFactorizeConcurrently(tensors, searchedTerm, previousTerms);
+			} else {
+				foundFactorization = doFactorize(0, 0, tensors, factorizedTerms, searchedTerm, previousTerms);
+			}
+			if (!foundFactorization) {
+				// Without a limit on the intermediate size, there is always a factorization
+				assert(hasIntermediateSizeLimit());
+
+				throw FactorizationException("Every factorization produces an intermediate with more than "
+												 + m_maxIntermediateSize.str() + " elements",
+											 term);
+			}
+			assert(!m_incumbentIsSeed);
+		}
+
+		if (useCache) {
+			m_cacheMisses++;
+			m_cacheLookups.push_back({ signature,
+									   0,
+									   false,
+									   { m_statistics.expandedNodes - previousStatistics.expandedNodes,
+										 m_statistics.prunedNodes - previousStatistics.prunedNodes } });
+
+			m_cache[std::move(signature)] = { m_bestOrder };
+		}
+	}
 }
 
 struct locate_result_tensor {
@@ -53,7 +687,7 @@ struct locate_result_tensor {
 	bool operator()(const ct::BinaryTerm &current) const { return current.getResult() == tensor; }
 };
 
-void ensureUniqueResultTensor(ct::BinaryTerm &term, const std::vector< ct::BinaryTerm > previousTerms) {
+void ensureUniqueResultTensor(ct::BinaryTerm &term, const std::vector< ct::BinaryTerm > &previousTerms) {
 	auto it = std::find_if(previousTerms.begin(), previousTerms.end(), locate_result_tensor{ term.getResult() });
 
 	if (it == previousTerms.end()) {
@@ -111,25 +745,46 @@ bool Factorizer::doFactorize(const ct::ContractionResult::cost_t &costSoFar,
 			// The factorization has completed since the last Tensor that remains is only the result
 			// of the last contraction. Since there are no other Tensors left to contract with, we have
 			// reached the end of this routine.
-			// That also means though that the last factorization should produce the final result. That
-			// means we'll have to adapt the result tensor and the prefactor.
-			ct::BinaryTerm &resultTerm = factorizedTerms[factorizedTerms.size() - 1];
-			resultTerm.setResult(term.getResult());
-			resultTerm.setPrefactor(term.getPrefactor());
+			finalizeFactorization(factorizedTerms, term);
+		}
 
-			// Exchanging the result Tensor might change how the index names have to be canonicalized
-			canonicalizeIndexIDs(resultTerm);
+		// The initial incumbent (obtained from a greedy factorization) only serves as a bound and therefore has to be
+		// replaced by the first factorization that is at least as good
+		bool replacesSeed = m_incumbentIsSeed && cost == m_bestCost && biggestIntermediate == m_biggestIntermediateSize;
+
+		bool isBetter = cost < m_bestCost || (cost == m_bestCost && biggestIntermediate < m_biggestIntermediateSize)
+						|| replacesSeed;
+
+		// Layout-aware factorizations break ties by the amount of transposition their final form requires
+		cost_t transposeCost = 0;
+		if (m_layoutAware
+			&& (isBetter || (cost == m_bestCost && biggestIntermediate == m_biggestIntermediateSize))) {
+			std::vector< ct::BinaryTerm > finalTerms = factorizedTerms;
+			finalizeIndexSequences(finalTerms);
+
+			transposeCost = getTotalTransposeCost(finalTerms);
+			isBetter      = isBetter || transposeCost < m_bestTransposeCost;
 		}
 
-		if (cost < m_bestCost || (cost == m_bestCost && biggestIntermediate < m_biggestIntermediateSize)) {
+		if (isBetter) {
 			// Save factorized terms
 			m_bestFactorization.clear();
 			m_bestFactorization.reserve(factorizedTerms.size());
 
 			m_bestFactorization.insert(m_bestFactorization.end(), factorizedTerms.begin(), factorizedTerms.end());
+			m_bestOrder        = m_currentOrder;
+			m_bestReuseSavings = m_currentReuseSavings;
 
 			m_bestCost                = cost;
 			m_biggestIntermediateSize = biggestIntermediate;
+			m_bestTransposeCost       = std::move(transposeCost);
+			m_incumbentIsSeed         = false;
+
+			if (m_sharedBound) {
+				// Let the other threads know about the new best cost
+				std::lock_guard< std::mutex > guard(m_sharedBound->mutex);
+				m_sharedBound->cost = std::min(m_sharedBound->cost, m_bestCost);
+			}
 
 			return true;
 		} else {
@@ -140,99 +795,847 @@ bool Factorizer::doFactorize(const ct::ContractionResult::cost_t &costSoFar,
 	bool foundBetterFactorization = false;
 	for (std::size_t i = 0; i < tensors.size(); ++i) {
 		for (std::size_t j = i + 1; j < tensors.size(); j++) {
-			cost_t cost = costSoFar;
+			if (tryContraction(i, j, costSoFar, biggestIntermediate, tensors, factorizedTerms, term, previousTerms)) {
+				foundBetterFactorization = true;
+			}
+			// The order of the operands determines the index sequence of the intermediate and thereby how much it
+			// has to be transposed. The last contraction produces the result Tensor whose index sequence is fixed.
+			if (m_layoutAware && tensors.size() > 2 && dependsOnOperandOrder(tensors[i], tensors[j])
+				&& tryContraction(j, i, costSoFar, biggestIntermediate, tensors, factorizedTerms, term, previousTerms)) {
+				foundBetterFactorization = true;
+			}
+		}
+	}
 
-			// Move the respective Tensors out of the list
-			auto itLeft = tensors.begin() + i;
-			assert(itLeft != tensors.end());
-			ct::Tensor left = std::move(*itLeft);
-			tensors.erase(itLeft);
+	return foundBetterFactorization;
+}
+
+bool Factorizer::doFactorizeConcurrently(std::vector< ct::Tensor > &tensors, const ct::GeneralTerm &term,
+										 const std::vector< ct::BinaryTerm > &previousTerms) {
+	// Every choice of the first contraction becomes a task of its own. These tasks are handed out to the threads in the
+	// same order in which the serial search would explore them.
+	std::vector< std::pair< std::size_t, std::size_t > > tasks;
+	for (std::size_t i = 0; i < tensors.size(); ++i) {
+		for (std::size_t j = i + 1; j < tensors.size(); j++) {
+			tasks.emplace_back(i, j);
+			if (m_layoutAware && dependsOnOperandOrder(tensors[i], tensors[j])) {
+				tasks.emplace_back(j, i);
+			}
+		}
+	}
 
-			auto itRight = tensors.begin() + j - 1;
-			assert(itRight != tensors.end());
-			ct::Tensor right = std::move(*itRight);
-			tensors.erase(itRight);
+	SharedBound sharedBound;
+	sharedBound.cost = m_bestCost;
 
-			// Contract left with right
-			ct::ContractionResult result = left.contract(right, m_resolver);
+	// Every thread works with its own copy of this Factorizer (that only shares the bound with the others)
+	Factorizer prototype(m_resolver, m_engine);
+	prototype.m_sharedBound   = &sharedBound;
+	prototype.m_reuseAware    = m_reuseAware;
+	prototype.m_reusableTerms = m_reusableTerms;
+	prototype.m_symmetryAware = m_symmetryAware;
+	prototype.m_layoutAware   = m_layoutAware;
+	prototype.setMaxIntermediateSize(m_maxIntermediateSize);
+	std::vector< Factorizer > workers(std::min(m_jobs, tasks.size()), prototype);
 
-			cost += result.cost;
+	// The best factorization found by every task. Tasks that did not find anything better than the initial (greedy)
+	// factorization leave their entry empty.
+	std::vector< std::vector< ct::BinaryTerm > > taskFactorizations(tasks.size());
+	std::vector< contraction_order_t > taskOrders(tasks.size());
+	std::vector< SubsetCost > taskCosts(tasks.size());
+	std::vector< cost_t > taskReuseSavings(tasks.size());
+	std::vector< cost_t > taskTransposeCosts(tasks.size());
+	std::vector< SearchStatistics > taskStatistics(tasks.size());
 
-			if (cost <= m_bestCost) {
-				// If the cost at this point is already higher than the best cost found so far, then
-				// we don't have to follow this path further down as there are no negative contraction
-				// costs meaning that there is no way that the cost will get lower than what it is
-				// at this point.
+	cu::parallelFor(tasks.size(), workers.size(), [&](std::size_t taskIndex, std::size_t threadIndex) {
+		Factorizer &worker = workers[threadIndex];
 
-				ct::ContractionResult::cost_t intermediateSize = 1;
-				for (const ct::Index &current : result.resultTensor.getIndices()) {
-					intermediateSize *= m_resolver.getMeta(current.getSpace()).getSize();
+		worker.m_bestCost                = m_bestCost;
+		worker.m_biggestIntermediateSize = m_biggestIntermediateSize;
+		worker.m_bestTransposeCost       = m_bestTransposeCost;
+		worker.m_incumbentIsSeed         = m_incumbentIsSeed;
+		worker.m_statistics              = {};
+		worker.m_currentReuseSavings     = 0;
+		worker.m_currentOrder.clear();
+
+		std::vector< ct::Tensor > taskTensors = tensors;
+		std::vector< ct::BinaryTerm > factorizedTerms;
+
+		if (worker.tryContraction(tasks[taskIndex].first, tasks[taskIndex].second, 0, 0, taskTensors, factorizedTerms,
+								  term, previousTerms)) {
+			taskFactorizations[taskIndex] = std::move(worker.m_bestFactorization);
+			taskOrders[taskIndex]         = std::move(worker.m_bestOrder);
+			taskCosts[taskIndex]          = { worker.m_bestCost, worker.m_biggestIntermediateSize };
+			taskReuseSavings[taskIndex]   = worker.m_bestReuseSavings;
+			taskTransposeCosts[taskIndex] = worker.m_bestTransposeCost;
+		}
+
+		taskStatistics[taskIndex] = worker.m_statistics;
+	});
+
+	// Pick the best result. Ties are broken in favor of the task that comes first which yields the same result as the
+	// serial search (which only replaces its best factorization if it finds a strictly better one).
+	bool foundFactorization = false;
+	for (std::size_t i = 0; i < tasks.size(); ++i) {
+		m_statistics.expandedNodes += taskStatistics[i].expandedNodes;
+		m_statistics.prunedNodes += taskStatistics[i].prunedNodes;
+
+		if (taskFactorizations[i].empty()) {
+			continue;
+		}
+
+		const SubsetCost currentBest = { m_bestCost, m_biggestIntermediateSize };
+
+		const bool isTie = taskCosts[i] == currentBest;
+
+		if (taskCosts[i] < currentBest || (isTie && m_incumbentIsSeed)
+			|| (isTie && m_layoutAware && taskTransposeCosts[i] < m_bestTransposeCost)) {
+			m_bestFactorization       = std::move(taskFactorizations[i]);
+			m_bestOrder               = std::move(taskOrders[i]);
+			m_bestCost                = taskCosts[i].cost;
+			m_biggestIntermediateSize = taskCosts[i].biggestIntermediate;
+			m_bestReuseSavings        = taskReuseSavings[i];
+			m_bestTransposeCost       = taskTransposeCosts[i];
+			m_incumbentIsSeed         = false;
+
+			foundFactorization = true;
+		}
+	}
+
+	return foundFactorization;
+}
+
+bool Factorizer::tryContraction(std::size_t i, std::size_t j, const cost_t &costSoFar, const cost_t &biggestIntermediate,
+								std::vector< ct::Tensor > &tensors, std::vector< ct::BinaryTerm > &factorizedTerms,
+								const ct::GeneralTerm &term, const std::vector< ct::BinaryTerm > &previousTerms) {
+	assert(i != j);
+	assert(i < tensors.size() && j < tensors.size());
+
+	bool foundBetterFactorization = false;
+
+	cost_t cost = costSoFar;
+
+	// Move the respective Tensors out of the list
+	ct::Tensor left  = std::move(tensors[i]);
+	ct::Tensor right = std::move(tensors[j]);
+	tensors.erase(tensors.begin() + std::max(i, j));
+	tensors.erase(tensors.begin() + std::min(i, j));
+
+	// Contract left with right
+	ct::ContractionResult result = left.contract(right, m_resolver);
+
+	const cost_t intermediateSize = getElementCount(result.resultTensor.getIndices());
+	// The result of the last contraction is the Term's result Tensor which has to be stored in any case
+	const bool exceedsSizeLimit = !tensors.empty() && intermediateSize > m_maxIntermediateSize;
+
+	// Whether this contraction is free can only be decided once the Term it produces is known. Otherwise the Term is
+	// only created if this path is explored further.
+	std::optional< ct::BinaryTerm > producedTerm;
+	bool reusesPreviousTerm = false;
+	if (!m_reusableTerms.empty()) {
+		producedTerm = createContractionTerm(result, left, right, tensors.empty(), factorizedTerms, previousTerms,
+											 &reusesPreviousTerm);
+	}
+
+	const cost_t contractionCost = getCost(left, right, result);
+
+	if (!reusesPreviousTerm) {
+		cost += contractionCost;
+	}
+
+	// If the cost at this point (plus the least amount of cost the remaining contractions will add) is already
+	// higher than the best cost found so far, then we don't have to follow this path further down as there
+	// are no negative contraction costs meaning that there is no way that the cost will get lower than what
+	// it is at this point. The lower bound no longer holds if the remaining contractions might be free though.
+	// Neither does it if the remaining contractions are cheaper due to symmetry.
+	const cost_t bound = getPruningBound();
+	bool expand        = !exceedsSizeLimit && cost <= bound;
+	if (expand && m_reusableTerms.empty() && !m_symmetryAware) {
+		expand = cost + getLowerBound(tensors, result.resultTensor) <= bound;
+	}
+
+	if (expand) {
+		m_statistics.expandedNodes++;
+
+		if (!producedTerm) {
+			producedTerm = createContractionTerm(result, left, right, tensors.empty(), factorizedTerms, previousTerms);
+		}
+
+		// Copy the result Tensor of this Tensor to the list of Tensors available for further
+		// contractions
+		// We explicitly don't copy the result Tensor of our simplified Term as it is very likely that in
+		// that Tensor the indices have been renamed to match a "canonical" representation. However in the
+		// upcoming terms that will be produced by further contractions, it is important to not have the
+		// indices renamed as that would lead to index name collisions which is avoided if we stick to the
+		// original index names for that.
+		tensors.push_back(std::move(result.resultTensor));
+
+		// Store the current contraction
+		factorizedTerms.push_back(std::move(*producedTerm));
+		m_currentOrder.emplace_back(i, j);
+
+		if (reusesPreviousTerm) {
+			m_currentReuseSavings += contractionCost;
+		}
+
+		// Factorize the remaining Tensors recursively
+		foundBetterFactorization = doFactorize(cost, std::max(biggestIntermediate, intermediateSize), tensors,
+											   factorizedTerms, term, previousTerms);
+
+		if (reusesPreviousTerm) {
+			m_currentReuseSavings -= contractionCost;
+		}
+	}
+
+	// Revert the factorization that we have performed up to here in order to explore the other
+	// alternatives undisturbed.
+	// Clear the last binary term that was added in the current iteration
+	if (expand) {
+		factorizedTerms.pop_back();
+		m_currentOrder.pop_back();
+		// Remove the result Tensor of the contraction of this iteration
+		tensors.pop_back();
+	} else {
+		m_statistics.prunedNodes++;
+	}
+	// Insert the Tensors back at their original position (the one further to the front has to be inserted first, so
+	// that the position of the other one is correct)
+	if (i < j) {
+		tensors.insert(tensors.begin() + i, std::move(left));
+		tensors.insert(tensors.begin() + j, std::move(right));
+	} else {
+		tensors.insert(tensors.begin() + j, std::move(right));
+		tensors.insert(tensors.begin() + i, std::move(left));
+	}
+
+	return foundBetterFactorization;
+}
+
+void Factorizer::replayFactorization(const contraction_order_t &order, const ct::GeneralTerm &term,
+									 const std::vector< ct::BinaryTerm > &previousTerms) {
+	assert(isValidOrder(order, term.size()));
+
+	std::vector< ct::Tensor > tensors = term.accessTensorList();
+	std::vector< ct::BinaryTerm > factorizedTerms;
+	factorizedTerms.reserve(order.size());
+
+	m_bestCost                = 0;
+	m_biggestIntermediateSize = 0;
+
+	for (const std::pair< std::size_t, std::size_t > &currentContraction : order) {
+		const std::size_t i = currentContraction.first;
+		const std::size_t j = currentContraction.second;
+
+		ct::Tensor left  = std::move(tensors[i]);
+		ct::Tensor right = std::move(tensors[j]);
+		tensors.erase(tensors.begin() + std::max(i, j));
+		tensors.erase(tensors.begin() + std::min(i, j));
+
+		ct::ContractionResult result = left.contract(right, m_resolver);
+
+		// Cached factorizations are never reuse-aware, so every contraction contributes its full cost
+		m_bestCost += getCost(left, right, result);
+		m_biggestIntermediateSize =
+			std::max(m_biggestIntermediateSize, getElementCount(result.resultTensor.getIndices()));
+
+		ct::BinaryTerm producedTerm =
+			createContractionTerm(result, left, right, tensors.empty(), factorizedTerms, previousTerms);
+
+		tensors.push_back(std::move(result.resultTensor));
+		factorizedTerms.push_back(std::move(producedTerm));
+	}
+
+	finalizeFactorization(factorizedTerms, term);
+
+	m_bestFactorization = std::move(factorizedTerms);
+}
+
+bool Factorizer::isValidOrder(const contraction_order_t &order, std::size_t tensorCount) {
+	if (order.size() + 1 != tensorCount) {
+		return false;
+	}
+
+	// Every contraction replaces two of the remaining Tensors by their result
+	std::size_t remainingTensors = tensorCount;
+	for (const std::pair< std::size_t, std::size_t > &currentContraction : order) {
+		if (currentContraction.first == currentContraction.second || currentContraction.first >= remainingTensors
+			|| currentContraction.second >= remainingTensors) {
+			return false;
+		}
+
+		remainingTensors--;
+	}
+
+	return true;
+}
+
+ct::BinaryTerm Factorizer::createContractionTerm(ct::ContractionResult &result, const ct::Tensor &left,
+												 const ct::Tensor &right, bool isLastContraction,
+												 const std::vector< ct::BinaryTerm > &factorizedTerms,
+												 const std::vector< ct::BinaryTerm > &previousTerms,
+												 bool *reusesPreviousTerm) const {
+	ct::BinaryTerm producedTerm = ct::BinaryTerm(result.resultTensor, 1.0, left, right);
+
+	// Always make sure that the Tensors in this term are in a unique order
+	producedTerm.sort();
+
+	// We want these terms to have "canonical" index names so that the routine checking the result tensor
+	// names can compare terms better and doesn't have to worry about possible index renamings.
+	// We don't do this for the final contraction though as for that we'll replace the result Tensor with
+	// the original result and if we rename indices here, this can lead to errors
+	if (!isLastContraction) {
+		canonicalizeIndexIDs(producedTerm);
+
+		if (reusesPreviousTerm) {
+			*reusesPreviousTerm = false;
+
+			// If one of the previous Terms computes exactly the same intermediate (up to its name), we can simply use
+			// its result instead of computing it again
+			for (const ct::BinaryTerm *currentTerm : m_reusableTerms) {
+				if (currentTerm->size() != producedTerm.size()
+					|| currentTerm->getResult().getIndices() != producedTerm.getResult().getIndices()) {
+					continue;
 				}
 
-				ct::BinaryTerm producedTerm = ct::BinaryTerm(result.resultTensor, 1.0, left, right);
-
-				// Always make sure that the Tensors in this term are in a unique order
-				producedTerm.sort();
-
-				// We want these terms to have "canonical" index names so that the routine checking the result tensor
-				// names can compare terms better and doesn't have to worry about possible index renamings.
-				// We don't do this for the final contraction though as for that we'll replace the result Tensor with
-				// the original result and if we rename indices here, this can lead to errors
-				if (!tensors.empty()) {
-					canonicalizeIndexIDs(producedTerm);
-
-					// We have to take special precaution that the result Tensor we have produced in this contraction
-					// is not taken already. In that case it could be that although the result Tensors of both terms
-					// are equal, the Terms themselves are not. This can happen if the difference for these terms only
-					// lies somewhere in the contracted indices.
-					// This function makes sure that in this case the name of the current result Tensor is altered until
-					// there is no such collision anymore.
-					ensureUniqueResultTensor(producedTerm, previousTerms);
-					// We have to do the same with the current factorized terms to also avoid name clashes within the
-					// currently factorized term
-					ensureUniqueResultTensor(producedTerm, factorizedTerms);
-
-					// Make sure the result Tensor has the same name as the result Tensor in the simplified term (which
-					// might have been altered to ensure a unique result Tensor name)
-					result.resultTensor.setName(producedTerm.getResult().getName());
+				ct::BinaryTerm candidate = producedTerm;
+				candidate.accessResult().setName(currentTerm->getResult().getInternedName());
+
+				if (candidate == *currentTerm) {
+					producedTerm        = std::move(candidate);
+					*reusesPreviousTerm = true;
+
+					result.resultTensor.setName(producedTerm.getResult().getInternedName());
+
+					return producedTerm;
 				}
+			}
+		}
+
+		// We have to take special precaution that the result Tensor we have produced in this contraction
+		// is not taken already. In that case it could be that although the result Tensors of both terms
+		// are equal, the Terms themselves are not. This can happen if the difference for these terms only
+		// lies somewhere in the contracted indices.
+		// This function makes sure that in this case the name of the current result Tensor is altered until
+		// there is no such collision anymore.
+		ensureUniqueResultTensor(producedTerm, previousTerms);
+		// We have to do the same with the current factorized terms to also avoid name clashes within the
+		// currently factorized term
+		ensureUniqueResultTensor(producedTerm, factorizedTerms);
+
+		// Make sure the result Tensor has the same name as the result Tensor in the simplified term (which
+		// might have been altered to ensure a unique result Tensor name)
+		result.resultTensor.setName(producedTerm.getResult().getInternedName());
+	}
+
+	return producedTerm;
+}
+
+void Factorizer::finalizeFactorization(std::vector< ct::BinaryTerm > &factorizedTerms,
+									   const ct::GeneralTerm &term) const {
+	assert(!factorizedTerms.empty());
+
+	// The last factorization should produce the final result. That means we'll have to adapt the result tensor
+	// and the prefactor.
+	ct::BinaryTerm &resultTerm = factorizedTerms[factorizedTerms.size() - 1];
+	resultTerm.setResult(term.getResult());
+	resultTerm.setPrefactor(term.getPrefactor());
 
-				// Copy the result Tensor of this Tensor to the list of Tensors available for further
-				// contractions
-				// We explicitly don't copy the result Tensor of our simplified Term as it is very likely that in
-				// that Tensor the indices have been renamed to match a "canonical" representation. However in the
-				// upcoming terms that will be produced by further contractions, it is important to not have the
-				// indices renamed as that would lead to index name collisions which is avoided if we stick to the
-				// original index names for that.
-				tensors.push_back(std::move(result.resultTensor));
-
-				// Store the current contraction
-				factorizedTerms.push_back(std::move(producedTerm));
-
-				// Factorize the remaining Tensors recursively
-				if (doFactorize(cost, std::max(biggestIntermediate, intermediateSize), tensors, factorizedTerms, term,
-								previousTerms)) {
-					foundBetterFactorization = true;
+	// Exchanging the result Tensor might change how the index names have to be canonicalized
+	canonicalizeIndexIDs(resultTerm);
+}
+
+cost_t Factorizer::getPruningBound() const {
+	if (!m_sharedBound) {
+		return m_bestCost;
+	}
+
+	std::lock_guard< std::mutex > guard(m_sharedBound->mutex);
+	return std::min(m_bestCost, m_sharedBound->cost);
+}
+
+cost_t Factorizer::getLowerBound(const std::vector< ct::Tensor > &tensors, const ct::Tensor &additionalTensor) const {
+	if (tensors.empty()) {
+		// Only a single Tensor remains -> there is nothing left to contract
+		return 0;
+	}
+
+	auto contains_index = [](const ct::Tensor::index_list_t &indices, const ct::Index &index) {
+		return std::any_of(indices.begin(), indices.end(),
+						   [&index](const ct::Index &current) { return ct::Index::isSame(index, current); });
+	};
+
+	// All (distinct) indices of the remaining Tensors along with the amount of Tensors carrying them
+	ct::Tensor::index_list_t distinctIndices;
+	std::vector< std::size_t > occurrences;
+	std::vector< cost_t > elementCounts;
+	elementCounts.reserve(tensors.size() + 1);
+
+	auto process_tensor = [&](const ct::Tensor &tensor) {
+		ct::Tensor::index_list_t tensorIndices;
+
+		for (const ct::Index &currentIndex : tensor.getIndices()) {
+			if (contains_index(tensorIndices, currentIndex)) {
+				continue;
+			}
+
+			tensorIndices.push_back(currentIndex);
+
+			auto it = std::find_if(distinctIndices.begin(), distinctIndices.end(), [&currentIndex](const ct::Index &other) {
+				return ct::Index::isSame(currentIndex, other);
+			});
+
+			if (it == distinctIndices.end()) {
+				distinctIndices.push_back(currentIndex);
+				occurrences.push_back(1);
+			} else {
+				occurrences[static_cast< std::size_t >(std::distance(distinctIndices.begin(), it))]++;
+			}
+		}
+
+		elementCounts.push_back(getElementCount(tensorIndices));
+	};
+
+	process_tensor(additionalTensor);
+	for (const ct::Tensor &currentTensor : tensors) {
+		process_tensor(currentTensor);
+	}
+
+	// Every remaining Tensor takes part in exactly one of the remaining contractions as an operand and a contraction
+	// always iterates over (at least) all indices of both of its operands. As a single contraction can only cover two
+	// of the remaining Tensors, the remaining cost is at least the sum of every second element count (sorted in
+	// descending order).
+	std::sort(elementCounts.begin(), elementCounts.end(), std::greater< cost_t >{});
+
+	cost_t operandBound = 0;
+	for (std::size_t i = 0; i < elementCounts.size(); i += 2) {
+		operandBound += elementCounts[i];
+	}
+
+	// Furthermore the final contraction has to iterate over (at least) all indices that are not shared between any of
+	// the remaining Tensors as these can't be contracted away before.
+	ct::Tensor::index_list_t openIndices;
+	for (std::size_t i = 0; i < distinctIndices.size(); ++i) {
+		if (occurrences[i] == 1) {
+			openIndices.push_back(distinctIndices[i]);
+		}
+	}
+
+	return std::max(operandBound, getElementCount(openIndices));
+}
+
+Factorizer::SubsetCost Factorizer::getGreedyFactorizationCost(std::vector< ct::Tensor > tensors) const {
+	SubsetCost greedyCost;
+
+	while (tensors.size() > 1) {
+		// Always perform the cheapest of all contractions that are possible at this point
+		std::size_t bestLeft  = 0;
+		std::size_t bestRight = 0;
+		ct::ContractionResult bestResult;
+		SubsetCost bestStep;
+
+		for (std::size_t i = 0; i < tensors.size(); ++i) {
+			for (std::size_t j = i + 1; j < tensors.size(); ++j) {
+				ct::ContractionResult result = tensors[i].contract(tensors[j], m_resolver);
+
+				SubsetCost step;
+				step.cost                = getCost(tensors[i], tensors[j], result);
+				step.biggestIntermediate = getElementCount(result.resultTensor.getIndices());
+
+				if (tensors.size() > 2 && step.biggestIntermediate > m_maxIntermediateSize) {
+					continue;
+				}
+
+				if (bestLeft == bestRight || step < bestStep) {
+					bestLeft   = i;
+					bestRight  = j;
+					bestResult = std::move(result);
+					bestStep   = std::move(step);
 				}
 			}
+		}
+
+		if (bestLeft == bestRight) {
+			// Every possible contraction exceeds the intermediate size limit
+			return { std::numeric_limits< cost_t >::max(), std::numeric_limits< cost_t >::max() };
+		}
+
+		greedyCost.cost += bestStep.cost;
+		greedyCost.biggestIntermediate = std::max(greedyCost.biggestIntermediate, bestStep.biggestIntermediate);
+
+		tensors.erase(tensors.begin() + bestRight);
+		tensors.erase(tensors.begin() + bestLeft);
+		tensors.push_back(std::move(bestResult.resultTensor));
+	}
+
+	return greedyCost;
+}
+
+cost_t Factorizer::getElementCount(const ct::Tensor::index_list_t &indices) const {
+	cost_t count = 1;
+	for (const ct::Index &current : indices) {
+		count *= m_resolver.getMeta(current.getSpace()).getSize();
+	}
+
+	return count;
+}
 
-			// Revert the factorization that we have performed up to here in order to explore the other
-			// alternatives undisturbed.
-			// Clear the last binary term that was added in the current iteration
-			if (cost <= m_bestCost) {
-				factorizedTerms.pop_back();
-				// Remove the result Tensor of the contraction of this iteration
-				tensors.pop_back();
+ct::CostPolynomial Factorizer::getCostPolynomial(const std::vector< ct::BinaryTerm > &terms,
+												 ct::CostPolynomial *reuseSavings) const {
+	ct::CostPolynomial cost;
+
+	for (const ct::BinaryTerm &currentTerm : terms) {
+		// The cost of a contraction is the product of the sizes of all indices that are iterated over. A Term with only
+		// a single Tensor costs as much as there are elements in that Tensor.
+		std::vector< const ct::Tensor * > tensors;
+		for (const ct::Tensor &currentTensor : currentTerm.getTensors()) {
+			tensors.push_back(&currentTensor);
+		}
+
+		ct::Tensor::index_list_t iteratedIndices;
+		if (tensors.size() == 1) {
+			iteratedIndices = tensors[0]->getIndices();
+		} else {
+			ct::Tensor::index_list_t resultIndices;
+			splitIndices(tensors[0]->getIndices(), tensors[1]->getIndices(), iteratedIndices, resultIndices);
+
+			iteratedIndices.insert(iteratedIndices.end(), resultIndices.begin(), resultIndices.end());
+		}
+
+		std::unordered_map< ct::IndexSpace, unsigned int > exponents;
+		for (const ct::Index &currentIndex : iteratedIndices) {
+			exponents[currentIndex.getSpace()] += 1;
+		}
+
+		const bool isReused = std::any_of(m_reusableTerms.begin(), m_reusableTerms.end(),
+										  [&currentTerm](const ct::BinaryTerm *other) { return *other == currentTerm; });
+
+		if (!isReused) {
+			cost += ct::CostPolynomial(exponents);
+		} else if (reuseSavings) {
+			*reuseSavings += ct::CostPolynomial(exponents);
+		}
+	}
+
+	return cost;
+}
+
+cost_t Factorizer::getSymmetryReducedCost(const std::vector< ct::BinaryTerm > &terms) const {
+	cost_t cost = 0;
+
+	for (const ct::BinaryTerm &currentTerm : terms) {
+		const bool isReused = std::any_of(m_reusableTerms.begin(), m_reusableTerms.end(),
+										  [&currentTerm](const ct::BinaryTerm *other) { return *other == currentTerm; });
+
+		if (isReused) {
+			continue;
+		}
+
+		std::vector< const ct::Tensor * > tensors;
+		for (const ct::Tensor &currentTensor : currentTerm.getTensors()) {
+			tensors.push_back(&currentTensor);
+		}
+
+		if (tensors.size() == 1) {
+			// A Term with only a single Tensor costs as much as there are elements in that Tensor
+			cost += getElementCount(tensors[0]->getIndices());
+		} else {
+			cost += tensors[0]->getSymmetryReducedCost(*tensors[1], tensors[0]->contract(*tensors[1], m_resolver));
+		}
+	}
+
+	return cost;
+}
+
+cost_t Factorizer::getCost(const ct::Tensor &left, const ct::Tensor &right, const ct::ContractionResult &result) const {
+	// Determining the symmetry reduction is comparatively expensive, so it is only done if it is actually needed
+	return m_symmetryAware ? left.getSymmetryReducedCost(right, result) : result.cost;
+}
+
+void Factorizer::finalizeIndexSequences(std::vector< ct::BinaryTerm > &terms) const {
+	for (ct::BinaryTerm &currentTerm : terms) {
+		if (m_layoutAware) {
+			// The last Term produces the final result whose index sequence is dictated by the factorized Term
+			canonicalizeIndexSequences(currentTerm, m_resolver, &currentTerm == &terms.back());
+		} else {
+			canonicalizeIndexSequences(currentTerm);
+		}
+	}
+}
+
+cost_t Factorizer::getTotalTransposeCost(const std::vector< ct::BinaryTerm > &terms) const {
+	cost_t cost = 0;
+
+	for (const ct::BinaryTerm &currentTerm : terms) {
+		cost += getTransposeCost(currentTerm, m_resolver);
+	}
+
+	return cost;
+}
+
+cost_t Factorizer::getContractionCost(subset_t left, subset_t right) const {
+	ct::Tensor::index_list_t contractedIndices;
+	ct::Tensor::index_list_t resultIndices;
+
+	splitIndices(m_subsetIndices[left], m_subsetIndices[right], contractedIndices, resultIndices);
+
+	// Every contracted index has to be summed over for every element of the result
+	return getElementCount(contractedIndices) * getElementCount(resultIndices);
+}
+
+void Factorizer::doFactorizeDynamically(const ct::GeneralTerm &term,
+										const std::vector< ct::BinaryTerm > &previousTerms) {
+	const std::vector< ct::Tensor > &originalTensors = term.accessTensorList();
+
+	if (originalTensors.size() >= static_cast< std::size_t >(std::numeric_limits< subset_t >::digits)) {
+		throw std::runtime_error("Too many Tensors in a single Term for the dynamic programming factorization");
+	}
+
+	const subset_t fullSet = (static_cast< subset_t >(1) << originalTensors.size()) - 1;
+
+	// First determine the indices of the Tensor representing each subset. These are obtained by contracting the
+	// lowest Tensor in the subset with the Tensor representing the remaining subset (the order in which the Tensors
+	// of a given subset are contracted does not change which indices remain).
+	m_subsetIndices.clear();
+	m_subsetIndices.resize(fullSet + 1);
+	std::vector< SubsetCost > subsetCosts(fullSet + 1);
+
+	for (subset_t subset = 1; subset <= fullSet; ++subset) {
+		const subset_t lowest = subset & (~subset + 1);
+
+		if (subset == lowest) {
+			// A single Tensor has to be neither computed nor contracted
+			std::size_t position = 0;
+			while ((static_cast< subset_t >(1) << position) != lowest) {
+				position++;
 			}
-			// Insert the Tensors back at their original position (if the right Tensor was originally to the
-			// left of the left one (index-wise in the tensors list), then we have to correct the insertion
-			// index for this Tensor that is still missing at this point (we have removed it above).
-			tensors.insert(tensors.begin() + i, std::move(left));
-			tensors.insert(tensors.begin() + j, std::move(right));
+
+			m_subsetIndices[subset] = originalTensors[position].getIndices();
+
+			continue;
 		}
+
+		ct::Tensor::index_list_t contractedIndices;
+		splitIndices(m_subsetIndices[subset ^ lowest], m_subsetIndices[lowest], contractedIndices,
+					 m_subsetIndices[subset]);
+
+		const cost_t resultSize = getElementCount(m_subsetIndices[subset]);
+
+		// Find the cheapest way of splitting this subset into two (already optimal) parts. In order to not consider
+		// every split twice, the first part always contains the lowest Tensor of the subset.
+		bool initialized = false;
+		for (subset_t first = (subset - 1) & subset; first != 0; first = (first - 1) & subset) {
+			if ((first & lowest) == 0) {
+				continue;
+			}
+
+			const subset_t second = subset ^ first;
+
+			m_statistics.expandedNodes++;
+
+			SubsetCost candidate;
+			candidate.cost =
+				subsetCosts[first].cost + subsetCosts[second].cost + getContractionCost(first, second);
+			candidate.biggestIntermediate = std::max(
+				{ subsetCosts[first].biggestIntermediate, subsetCosts[second].biggestIntermediate, resultSize });
+
+			if (!initialized || candidate < subsetCosts[subset]) {
+				subsetCosts[subset] = std::move(candidate);
+				initialized         = true;
+			}
+		}
+
+		assert(initialized);
 	}
 
-	return foundBetterFactorization;
+	// Subsets that only consist of single Tensors are the same as the respective bitmask in the table computed above
+	m_completionMemo.clear();
+	for (subset_t subset = 1; subset <= fullSet; ++subset) {
+		std::vector< subset_t > blocks;
+		for (std::size_t i = 0; i < originalTensors.size(); ++i) {
+			if (subset & (static_cast< subset_t >(1) << i)) {
+				blocks.push_back(static_cast< subset_t >(1) << i);
+			}
+		}
+
+		m_completionMemo[std::move(blocks)] = std::move(subsetCosts[subset]);
+	}
+
+	std::vector< subset_t > blocks;
+	for (std::size_t i = 0; i < originalTensors.size(); ++i) {
+		blocks.push_back(static_cast< subset_t >(1) << i);
+	}
+
+	const SubsetCost optimum = getOptimalCompletion(blocks);
+
+	// Now that the optimal cost is known, reconstruct the sequence of contractions that the exhaustive search would
+	// have found. That search processes the pairs of remaining Tensors in a fixed order and only replaces the best
+	// factorization found so far by a strictly better one. Thus it ends up with the first optimal sequence in that
+	// order, which we can construct greedily by always picking the first pair that still allows reaching the
+	// optimum.
+	SubsetCost accumulated;
+	m_bestOrder.clear();
+
+	while (blocks.size() > 1) {
+		bool foundPair = false;
+
+		for (std::size_t i = 0; i < blocks.size() && !foundPair; ++i) {
+			for (std::size_t j = i + 1; j < blocks.size() && !foundPair; ++j) {
+				const subset_t merged = blocks[i] | blocks[j];
+
+				std::vector< subset_t > remainingBlocks;
+				remainingBlocks.reserve(blocks.size() - 1);
+				for (std::size_t k = 0; k < blocks.size(); ++k) {
+					if (k != i && k != j) {
+						remainingBlocks.push_back(blocks[k]);
+					}
+				}
+				remainingBlocks.push_back(merged);
+
+				SubsetCost current;
+				current.cost                = accumulated.cost + getContractionCost(blocks[i], blocks[j]);
+				current.biggestIntermediate = std::max(accumulated.biggestIntermediate,
+													   getElementCount(m_subsetIndices[merged]));
+
+				const SubsetCost &completion = getOptimalCompletion(remainingBlocks);
+
+				SubsetCost total;
+				total.cost = current.cost + completion.cost;
+				total.biggestIntermediate =
+					std::max(current.biggestIntermediate, completion.biggestIntermediate);
+
+				if (!(total == optimum)) {
+					continue;
+				}
+
+				foundPair   = true;
+				accumulated = std::move(current);
+				blocks      = std::move(remainingBlocks);
+				m_bestOrder.emplace_back(i, j);
+			}
+		}
+
+		assert(foundPair);
+	}
+
+	assert(accumulated == optimum);
+
+	// The Tensors are kept in the same order as the blocks, so the chosen sequence can be carried out directly
+	replayFactorization(m_bestOrder, term, previousTerms);
+
+	m_bestCost                = optimum.cost;
+	m_biggestIntermediateSize = optimum.biggestIntermediate;
+
+	m_subsetIndices.clear();
+	m_completionMemo.clear();
+}
+
+const Factorizer::SubsetCost &Factorizer::getOptimalCompletion(const std::vector< subset_t > &blocks) {
+	std::vector< subset_t > key = blocks;
+	std::sort(key.begin(), key.end());
+
+	auto it = m_completionMemo.find(key);
+	if (it != m_completionMemo.end()) {
+		return it->second;
+	}
+
+	SubsetCost best;
+
+	if (key.size() > 1) {
+		subset_t combined = 0;
+		for (subset_t current : key) {
+			combined |= current;
+		}
+
+		const cost_t resultSize = getElementCount(m_subsetIndices[combined]);
+
+		// Split the blocks into two groups (the first one always containing the first block)
+		bool initialized                = false;
+		const std::size_t amountOfSplits = static_cast< std::size_t >(1) << (key.size() - 1);
+		for (std::size_t split = 0; split + 1 < amountOfSplits; ++split) {
+			std::vector< subset_t > firstGroup  = { key[0] };
+			std::vector< subset_t > secondGroup = {};
+			subset_t first                      = key[0];
+
+			for (std::size_t i = 1; i < key.size(); ++i) {
+				if (split & (static_cast< std::size_t >(1) << (i - 1))) {
+					firstGroup.push_back(key[i]);
+					first |= key[i];
+				} else {
+					secondGroup.push_back(key[i]);
+				}
+			}
+
+			SubsetCost candidate;
+			const SubsetCost &firstCost  = getOptimalCompletion(firstGroup);
+			const SubsetCost &secondCost = getOptimalCompletion(secondGroup);
+
+			candidate.cost = firstCost.cost + secondCost.cost + getContractionCost(first, combined ^ first);
+			candidate.biggestIntermediate =
+				std::max({ firstCost.biggestIntermediate, secondCost.biggestIntermediate, resultSize });
+
+			if (!initialized || candidate < best) {
+				best        = std::move(candidate);
+				initialized = true;
+			}
+		}
+	}
+
+	return m_completionMemo[std::move(key)] = std::move(best);
+}
+
+std::ostream &operator<<(std::ostream &stream, Factorizer::Engine engine) {
+	switch (engine) {
+		case Factorizer::Engine::Exhaustive:
+			return stream << "exhaustive";
+		case Factorizer::Engine::DynamicProgramming:
+			return stream << "dp";
+	}
+
+	return stream;
+}
+
+std::istream &operator>>(std::istream &stream, Factorizer::Engine &engine) {
+	std::string name;
+	stream >> name;
+
+	if (name == "exhaustive") {
+		engine = Factorizer::Engine::Exhaustive;
+	} else if (name == "dp") {
+		engine = Factorizer::Engine::DynamicProgramming;
+	} else {
+		stream.setstate(std::ios_base::failbit);
+	}
+
+	return stream;
+}
+
+std::ostream &operator<<(std::ostream &stream, Factorizer::Policy policy) {
+	switch (policy) {
+		case Factorizer::Policy::MinimumCost:
+			return stream << "cost";
+		case Factorizer::Policy::MinimumMemory:
+			return stream << "memory";
+		case Factorizer::Policy::Balanced:
+			return stream << "balanced";
+	}
+
+	return stream;
+}
+
+std::istream &operator>>(std::istream &stream, Factorizer::Policy &policy) {
+	std::string name;
+	stream >> name;
+
+	if (name == "cost") {
+		policy = Factorizer::Policy::MinimumCost;
+	} else if (name == "memory") {
+		policy = Factorizer::Policy::MinimumMemory;
+	} else if (name == "balanced") {
+		policy = Factorizer::Policy::Balanced;
+	} else {
+		stream.setstate(std::ios_base::failbit);
+	}
+
+	return stream;
 }
 
 }; // namespace Contractor::Processor
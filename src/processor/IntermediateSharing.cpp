@@ -0,0 +1,154 @@
+#include "processor/IntermediateSharing.hpp"
+#include "processor/Simplifier.hpp"
+#include "terms/CanonicalLabelling.hpp"
+#include "terms/CompositeTerm.hpp"
+#include "terms/TensorSubstitution.hpp"
+#include "utils/IndexSpaceResolver.hpp"
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace ct = Contractor::Terms;
+namespace cu = Contractor::Utils;
+
+namespace Contractor::Processor {
+
+ct::ContractionResult::cost_t getOperationCount(const ct::BinaryTerm &term, const cu::IndexSpaceResolver &resolver) {
+	ct::ContractionResult::cost_t count = 1;
+
+	for (const auto &currentPair : term.getFormalScaling()) {
+		for (unsigned int i = 0; i < currentPair.second; ++i) {
+			count *= resolver.getMeta(currentPair.first).getSize();
+		}
+	}
+
+	return count;
+}
+
+ct::ContractionResult::cost_t shareIntermediates(std::vector< ct::BinaryTermGroup > &groups,
+												 const cu::IndexSpaceResolver &resolver,
+												 const std::function< bool(std::string_view) > &isIntermediate,
+												 PrinterWrapper printer) {
+	ct::ContractionResult::cost_t savedOperations = 0;
+
+	// The intermediates calculated by the groups processed so far
+	std::vector< ct::BinaryCompositeTerm > availableIntermediates;
+	// The positions of these intermediates in availableIntermediates by their relation key. Intermediates can only be
+	// reused for ones with the same key.
+	std::map< std::vector< ct::CanonicalLabelling::key_t >, std::vector< std::size_t > > intermediatesByKey;
+	// For every intermediate name, the position of its latest calculation in availableIntermediates. An intermediate
+	// can only be reused as long as its name has not been recalculated to hold something else in the meantime.
+	std::unordered_map< std::string, std::size_t > latestCalculation;
+
+	for (ct::BinaryTermGroup &currentGroup : groups) {
+		std::vector< ct::BinaryCompositeTerm > &composites = currentGroup.accessTerms();
+
+		// Positions of the intermediates calculated by this group (that will remain in this group)
+		std::vector< std::size_t > ownIntermediates;
+
+		std::size_t i = 0;
+		while (i < composites.size()) {
+			const ct::BinaryCompositeTerm &currentComposite = composites[i];
+
+			if (!isIntermediate(currentComposite.getResult().getName())) {
+				++i;
+				continue;
+			}
+
+			// Set if the current intermediate is only related to the reusable one with its indices permuted
+			std::optional< ct::TensorSubstitution > permutedRelation;
+
+			auto is_reusable = [&](const ct::BinaryCompositeTerm &candidate) {
+				const std::string_view name = candidate.getResult().getName();
+
+				if (&candidate != &availableIntermediates[latestCalculation.at(std::string(name))]) {
+					// The name of this intermediate has been reused for something else since it has been calculated
+					return false;
+				}
+
+				for (std::size_t j = 0; j < composites.size(); ++j) {
+					if (j != i && composites[j].getResult().getName() == name) {
+						// This group calculates a (different) intermediate of the same name on its own
+						return false;
+					}
+				}
+
+				if (candidate.getResult().refersToSameElement(currentComposite.getResult())) {
+					// Relating a Tensor to itself (with different index order or prefactor) is not possible via a
+					// substitution. Thus in this case only exact duplicates can be eliminated.
+					return candidate == currentComposite;
+				}
+
+				if (currentComposite.isRelatedTo(candidate)) {
+					return true;
+				}
+
+				// E.g. X'[ji] = - X[ij]
+				std::optional< ct::TensorSubstitution > relation = findPermutedRelation(currentComposite, candidate);
+				if (relation) {
+					permutedRelation.emplace(std::move(*relation));
+
+					return true;
+				}
+
+				return false;
+			};
+
+			const std::vector< std::size_t > &candidates = intermediatesByKey[getRelationKey(currentComposite)];
+
+			auto matchIt = std::find_if(candidates.begin(), candidates.end(), [&](std::size_t candidate) {
+				return is_reusable(availableIntermediates[candidate]);
+			});
+
+			if (matchIt == candidates.end()) {
+				ownIntermediates.push_back(i);
+				++i;
+				continue;
+			}
+
+			const ct::BinaryCompositeTerm &match = availableIntermediates[*matchIt];
+
+			ct::ContractionResult::cost_t currentSavings = 0;
+			for (const ct::BinaryTerm &currentTerm : currentComposite) {
+				currentSavings += getOperationCount(currentTerm, resolver);
+			}
+			savedOperations += currentSavings;
+
+			printer << "Reusing " << match.getResult() << " for " << currentComposite.getResult() << " (saves "
+					<< currentSavings << " operations)\n";
+
+			if (permutedRelation || match.getResult() != currentComposite.getResult()) {
+				ct::TensorSubstitution substitution =
+					permutedRelation ? std::move(*permutedRelation) : currentComposite.getRelation(match);
+
+				composites.erase(composites.begin() + static_cast< std::ptrdiff_t >(i));
+
+				for (ct::BinaryCompositeTerm &remainingComposite : composites) {
+					for (ct::Term &currentTerm : remainingComposite) {
+						substitution.apply(currentTerm, false);
+					}
+				}
+			} else {
+				// The later calculation is an exact duplicate -> the remaining Terms can stay as they are
+				composites.erase(composites.begin() + static_cast< std::ptrdiff_t >(i));
+			}
+		}
+
+		// Only make the intermediates of this group available once the entire group has been processed as the
+		// substitutions performed above may still have changed them
+		for (std::size_t currentPosition : ownIntermediates) {
+			latestCalculation[std::string(composites[currentPosition].getResult().getName())] =
+				availableIntermediates.size();
+			intermediatesByKey[getRelationKey(composites[currentPosition])].push_back(availableIntermediates.size());
+
+			availableIntermediates.push_back(composites[currentPosition]);
+		}
+	}
+
+	return savedOperations;
+}
+
+}; // namespace Contractor::Processor
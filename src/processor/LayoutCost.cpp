@@ -0,0 +1,134 @@
+#include "processor/LayoutCost.hpp"
+#include "terms/Index.hpp"
+#include "utils/IndexSpaceResolver.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+namespace ct = Contractor::Terms;
+namespace cu = Contractor::Utils;
+
+namespace Contractor::Processor {
+
+/**
+ * @returns The indices of the given list that are (or are not) contained in the other list, in their original order
+ */
+ct::Tensor::index_list_t selectIndices(const ct::Tensor::index_list_t &indices, const ct::Tensor::index_list_t &other,
+									   bool contained) {
+	ct::Tensor::index_list_t selected;
+
+	for (const ct::Index &currentIndex : indices) {
+		const bool isContained = std::any_of(other.begin(), other.end(), [&currentIndex](const ct::Index &current) {
+			return ct::Index::isSame(currentIndex, current);
+		});
+
+		if (isContained == contained) {
+			selected.push_back(currentIndex);
+		}
+	}
+
+	return selected;
+}
+
+/**
+ * @returns Whether the given indices consist of the two given blocks of indices (in either order)
+ */
+bool consistsOfBlocks(const ct::Tensor::index_list_t &indices, const ct::Tensor::index_list_t &first,
+					  const ct::Tensor::index_list_t &second) {
+	if (indices.size() != first.size() + second.size()) {
+		return false;
+	}
+
+	auto matches = [&indices](const ct::Tensor::index_list_t &head, const ct::Tensor::index_list_t &tail) {
+		return std::equal(head.begin(), head.end(), indices.begin(), &ct::Index::isSame)
+			   && std::equal(tail.begin(), tail.end(), indices.begin() + head.size(), &ct::Index::isSame);
+	};
+
+	return matches(first, second) || matches(second, first);
+}
+
+/**
+ * @returns The amount of elements in a Tensor carrying the given indices
+ */
+ct::ContractionResult::cost_t countElements(const ct::Tensor::index_list_t &indices,
+											const cu::IndexSpaceResolver &resolver) {
+	ct::ContractionResult::cost_t count = 1;
+	for (const ct::Index &currentIndex : indices) {
+		count *= resolver.getMeta(currentIndex.getSpace()).getSize();
+	}
+
+	return count;
+}
+
+ct::ContractionResult::cost_t getTransposeCost(const ct::BinaryTerm &term, const cu::IndexSpaceResolver &resolver) {
+	std::vector< const ct::Tensor * > tensors;
+	for (const ct::Tensor &currentTensor : term.getTensors()) {
+		tensors.push_back(&currentTensor);
+	}
+
+	if (tensors.size() == 1) {
+		return getTransposeCost(term.getResult().getIndices(), tensors[0]->getIndices(), resolver);
+	}
+
+	return getTransposeCost(term.getResult().getIndices(), tensors[0]->getIndices(), tensors[1]->getIndices(),
+							resolver);
+}
+
+ct::ContractionResult::cost_t getTransposeCost(const ct::Tensor::index_list_t &resultIndices,
+											   const ct::Tensor::index_list_t &operandIndices,
+											   const cu::IndexSpaceResolver &resolver) {
+	const ct::Tensor::index_list_t orderedIndices = selectIndices(operandIndices, resultIndices, true);
+
+	const bool sameOrder = std::equal(resultIndices.begin(), resultIndices.end(), orderedIndices.begin(),
+									  orderedIndices.end(), &ct::Index::isSame);
+
+	return sameOrder ? 0 : countElements(operandIndices, resolver);
+}
+
+ct::ContractionResult::cost_t getTransposeCost(const ct::Tensor::index_list_t &resultIndices,
+											   const ct::Tensor::index_list_t &leftIndices,
+											   const ct::Tensor::index_list_t &rightIndices,
+											   const cu::IndexSpaceResolver &resolver) {
+	const ct::Tensor::index_list_t leftResultIndices  = selectIndices(leftIndices, rightIndices, false);
+	const ct::Tensor::index_list_t rightResultIndices = selectIndices(rightIndices, leftIndices, false);
+
+	// The order of the indices within every block can be taken from either of the two Tensors it appears in. Whichever
+	// Tensor doesn't use that order has to be transposed.
+	const std::array< ct::Tensor::index_list_t, 2 > leftResultOrders = {
+		leftResultIndices, selectIndices(resultIndices, leftResultIndices, true)
+	};
+	const std::array< ct::Tensor::index_list_t, 2 > contractedOrders = {
+		selectIndices(leftIndices, rightIndices, true), selectIndices(rightIndices, leftIndices, true)
+	};
+	const std::array< ct::Tensor::index_list_t, 2 > rightResultOrders = {
+		rightResultIndices, selectIndices(resultIndices, rightResultIndices, true)
+	};
+
+	ct::ContractionResult::cost_t minCost = std::numeric_limits< ct::ContractionResult::cost_t >::max();
+
+	for (const ct::Tensor::index_list_t &leftOrder : leftResultOrders) {
+		for (const ct::Tensor::index_list_t &contractedOrder : contractedOrders) {
+			for (const ct::Tensor::index_list_t &rightOrder : rightResultOrders) {
+				ct::ContractionResult::cost_t cost = 0;
+
+				if (!consistsOfBlocks(leftIndices, leftOrder, contractedOrder)) {
+					cost += countElements(leftIndices, resolver);
+				}
+				if (!consistsOfBlocks(rightIndices, contractedOrder, rightOrder)) {
+					cost += countElements(rightIndices, resolver);
+				}
+				if (!consistsOfBlocks(resultIndices, leftOrder, rightOrder)) {
+					cost += countElements(resultIndices, resolver);
+				}
+
+				minCost = std::min(minCost, cost);
+			}
+		}
+	}
+
+	return minCost;
+}
+
+}; // namespace Contractor::Processor
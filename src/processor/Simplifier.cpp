@@ -1,4 +1,5 @@
 #include "processor/Simplifier.hpp"
+#include "processor/LayoutCost.hpp"
 
 #include "terms/Index.hpp"
 #include "terms/IndexSpace.hpp"
@@ -8,8 +9,10 @@
 
 #include <cassert>
 #include <unordered_map>
+#include <vector>
 
 namespace ct = Contractor::Terms;
+namespace cu = Contractor::Utils;
 
 namespace Contractor::Processor {
 
@@ -130,5 +133,110 @@ bool canonicalizeIndexSequences(ct::Term &term) {
 	return modified;
 }
 
+/**
+ * The maximum amount of combinations of index sequences that are tried when looking for the one requiring the least
+ * amount of transposition. Terms with more combinations keep their canonical sequences.
+ */
+constexpr std::size_t maxLayoutCombinations = 4096;
+
+bool canonicalizeIndexSequences(ct::BinaryTerm &term, const cu::IndexSpaceResolver &resolver, bool keepResultSequence) {
+	bool modified = false;
+
+	if (keepResultSequence) {
+		int factor = 1;
+		for (ct::Tensor &currentTensor : term.accessTensors()) {
+			if (!currentTensor.hasCanonicalIndexSequence()) {
+				factor *= currentTensor.canonicalizeIndices();
+				modified = true;
+			}
+		}
+
+		if (factor != 1) {
+			term.setPrefactor(term.getPrefactor() * factor);
+		}
+	} else {
+		modified = canonicalizeIndexSequences(term);
+	}
+
+	std::vector< ct::Tensor * > tensors = { &term.accessResult() };
+	for (ct::Tensor &currentTensor : term.accessTensors()) {
+		tensors.push_back(&currentTensor);
+	}
+
+	// The index sequences every Tensor may use. As all Tensors use their canonical sequence at this point, that
+	// sequence comes first.
+	std::vector< std::vector< ct::Tensor::index_list_t > > candidates;
+	std::size_t combinations = 1;
+	for (const ct::Tensor *currentTensor : tensors) {
+		candidates.push_back({ currentTensor->getIndices() });
+
+		if (keepResultSequence && currentTensor == &term.getResult()) {
+			// The result Tensor is bound to the sequence it currently has
+			continue;
+		}
+
+		const ct::PermutationGroup &symmetry = currentTensor->getSymmetry();
+
+		for (const ct::PermutationGroup::Element &currentElement : symmetry.getIndexPermutations()) {
+			if (currentElement.indexSequence != currentTensor->getIndices()) {
+				candidates.back().push_back(currentElement.indexSequence);
+			}
+		}
+
+		combinations *= candidates.back().size();
+	}
+
+	if (combinations == 1 || combinations > maxLayoutCombinations) {
+		return modified;
+	}
+
+	auto getCost = [&](const std::vector< std::size_t > &choice) {
+		if (tensors.size() == 2) {
+			return getTransposeCost(candidates[0][choice[0]], candidates[1][choice[1]], resolver);
+		}
+
+		return getTransposeCost(candidates[0][choice[0]], candidates[1][choice[1]], candidates[2][choice[2]], resolver);
+	};
+
+	auto advance = [&candidates](std::vector< std::size_t > &choice) {
+		for (std::size_t i = choice.size(); i-- > 0;) {
+			if (++choice[i] < candidates[i].size()) {
+				return true;
+			}
+
+			choice[i] = 0;
+		}
+
+		return false;
+	};
+
+	// Try all combinations, starting with the canonical one. Only strictly cheaper ones replace the best one.
+	std::vector< std::size_t > choice(tensors.size(), 0);
+	std::vector< std::size_t > bestChoice  = choice;
+	ct::ContractionResult::cost_t bestCost = getCost(choice);
+
+	while (bestCost > 0 && advance(choice)) {
+		ct::ContractionResult::cost_t currentCost = getCost(choice);
+
+		if (currentCost < bestCost) {
+			bestCost   = std::move(currentCost);
+			bestChoice = choice;
+		}
+	}
+
+	int factor = 1;
+	for (std::size_t i = 0; i < tensors.size(); ++i) {
+		if (bestChoice[i] != 0) {
+			factor *= tensors[i]->setIndexSequence(candidates[i][bestChoice[i]]);
+			modified = true;
+		}
+	}
+
+	if (factor != 1) {
+		term.setPrefactor(term.getPrefactor() * factor);
+	}
+
+	return modified;
+}
 
 }; // namespace Contractor::Processor
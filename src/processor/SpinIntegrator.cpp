@@ -70,8 +70,8 @@ void SpinIntegrator::process(const Terms::Tensor &tensor) {
 	}
 
 	// First collect a list of creator and annihilator indices in this Tensor
-	std::vector< ct::Index > creators;
-	std::vector< ct::Index > annihilators;
+	ct::IndexList creators;
+	ct::IndexList annihilators;
 	for (const ct::Index &currentIndex : tensor.getIndices()) {
 		if (currentIndex.getType() == ct::Index::Type::Creator) {
 			assert(currentIndex.getSpin() == ct::Index::Spin::Both);
@@ -99,7 +99,7 @@ void SpinIntegrator::process(const Terms::Tensor &tensor) {
 	}
 }
 
-int applySubstitutition(const ct::IndexSubstitution &sub, const std::vector< ct::Index > &indices,
+int applySubstitutition(const ct::IndexSubstitution &sub, const ct::IndexList &indices,
 						std::vector< std::size_t > &availableIndexIndices) {
 	availableIndexIndices.clear();
 
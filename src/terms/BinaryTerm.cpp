@@ -7,7 +7,7 @@ namespace Contractor::Terms {
 const Tensor BinaryTerm::DummyRHS("DummyRHS (Should never be actually visible to the user)");
 
 BinaryTerm BinaryTerm::toBinaryTerm(const Term &term) {
-	std::size_t size = std::distance(term.getTensors().begin(), term.getTensors().end());
+	std::size_t size = term.size();
 
 	if (size > 2) {
 		throw std::logic_error("Can't convert Term with more than 2 Tensors into a binary Term!");
@@ -16,44 +16,38 @@ BinaryTerm BinaryTerm::toBinaryTerm(const Term &term) {
 		throw std::logic_error("Can't convert Term with 0 Tensors into binary Term!");
 	}
 
-	auto it = term.getTensors().begin();
+	Span< const Tensor > tensors = term.getTensors();
 	if (size == 1) {
-		return BinaryTerm(term.getResult(), term.getPrefactor(), *it, DummyRHS);
+		return BinaryTerm(term.getResult(), term.getPrefactor(), tensors[0], DummyRHS);
 	} else {
-		Tensor left  = *it;
-		Tensor right = *(++it);
-		return BinaryTerm(term.getResult(), term.getPrefactor(), std::move(left), std::move(right));
+		return BinaryTerm(term.getResult(), term.getPrefactor(), tensors[0], tensors[1]);
 	}
 }
 
 BinaryTerm::BinaryTerm(const Tensor &result, Term::factor_t prefactor, const Tensor &left, const Tensor &right)
-	: Term(result, prefactor), m_left(left), m_right(right) {
+	: Term(result, prefactor), m_tensors({ left, right }) {
 }
 
 std::size_t BinaryTerm::size() const {
-	return m_right != DummyRHS ? 2 : 1;
+	return m_tensors[1] != DummyRHS ? 2 : 1;
 }
 
-Tensor &BinaryTerm::get(std::size_t index) {
-	assert(index == 0 || index == 1);
-
-	return (index == 0 ? m_left : m_right);
+Span< Tensor > BinaryTerm::accessTensorStorage() {
+	return Span< Tensor >(m_tensors.data(), size());
 }
 
-const Tensor &BinaryTerm::get(std::size_t index) const {
-	assert(index == 0 || index == 1);
-
-	return (index == 0 ? m_left : m_right);
+Span< const Tensor > BinaryTerm::getTensorStorage() const {
+	return Span< const Tensor >(m_tensors.data(), size());
 }
 
 void BinaryTerm::sort() {
-	if (m_right == DummyRHS) {
+	if (m_tensors[1] == DummyRHS) {
 		// This term only contains a single Tensor -> There is nothing to sort
 		return;
 	}
 
-	if (m_right < m_left) {
-		std::swap(m_left, m_right);
+	if (m_tensors[1] < m_tensors[0]) {
+		std::swap(m_tensors[0], m_tensors[1]);
 	}
 }
 
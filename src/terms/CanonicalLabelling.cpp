@@ -0,0 +1,473 @@
+#include "terms/CanonicalLabelling.hpp"
+#include "terms/IndexSubstitution.hpp"
+#include "terms/PermutationGroup.hpp"
+#include "terms/SlotPermutation.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace Contractor::Terms {
+
+namespace {
+	/**
+	 * A partial labelling as it is built up during the search
+	 */
+	struct PartialLabelling {
+		std::vector< std::size_t > order;
+		std::vector< IndexList > sequences;
+		std::vector< Index > contractedIndices;
+		/**
+		 * The external indices in the order of their first appearance (only used if they are not labelled by their
+		 * position in the result Tensor)
+		 */
+		std::vector< Index > externalIndices;
+		std::vector< bool > used;
+		CanonicalLabelling::key_t blocks;
+	};
+
+	/**
+	 * A possible choice for the Tensor at the next position in the canonical order
+	 */
+	struct Candidate {
+		std::size_t tensor;
+		PermutationGroup::Element element;
+		CanonicalLabelling::key_t block;
+		std::vector< Index > newContractedIndices;
+		std::vector< Index > newExternalIndices;
+	};
+
+	CanonicalLabelling::key_entry_t encode(const Index &index, bool contracted, std::size_t label) {
+		// External indices sort before contracted ones
+		return (static_cast< CanonicalLabelling::key_entry_t >(index.getType()) << 56)
+			   | (static_cast< CanonicalLabelling::key_entry_t >(index.getSpin()) << 48)
+			   | (static_cast< CanonicalLabelling::key_entry_t >(index.getSpace().getID() & 0xFFFF) << 32)
+			   | (static_cast< CanonicalLabelling::key_entry_t >(contracted) << 31) | (label & 0x7FFFFFFF);
+	}
+
+	template< typename container_t > std::optional< std::size_t > find(const container_t &indices, const Index &index) {
+		auto it = std::find_if(indices.begin(), indices.end(),
+							   [&index](const Index &current) { return Index::index_has_same_name{}(current, index); });
+
+		if (it == indices.end()) {
+			return {};
+		}
+
+		return static_cast< std::size_t >(std::distance(indices.begin(), it));
+	}
+
+	/**
+	 * Appends the given name (its length followed by its characters, packed into as few entries as possible)
+	 */
+	void appendName(CanonicalLabelling::key_t &key, std::string_view name) {
+		constexpr std::size_t charsPerEntry = sizeof(CanonicalLabelling::key_entry_t);
+
+		key.push_back(name.size());
+
+		for (std::size_t i = 0; i < name.size(); i += charsPerEntry) {
+			CanonicalLabelling::key_entry_t entry = 0;
+
+			for (std::size_t j = i; j < i + charsPerEntry; ++j) {
+				entry = (entry << 8) | (j < name.size() ? static_cast< unsigned char >(name[j]) : 0);
+			}
+
+			key.push_back(entry);
+		}
+	}
+
+	/**
+	 * Appends a description of the given symmetry that only depends on the group itself (and not on the indices it
+	 * acts on or on the generators it has been created from)
+	 */
+	void appendSymmetry(CanonicalLabelling::key_t &key, const PermutationGroup &symmetry) {
+		std::optional< std::vector< SlotPermutation > > description = symmetry.getSlotDescription();
+
+		if (!description) {
+			// Groups that have to be generated explicitly are described along with the index sequence of the Tensor
+			// (see appendExplicitSymmetry)
+			key.push_back(1);
+			key.push_back(symmetry.size());
+
+			return;
+		}
+
+		key.push_back(0);
+		key.push_back(description->size());
+
+		for (const SlotPermutation &currentPermutation : *description) {
+			key.push_back(currentPermutation.getSign() == 1 ? 0 : 1);
+			key.insert(key.end(), currentPermutation.getImages().begin(), currentPermutation.getImages().end());
+		}
+	}
+
+	/**
+	 * Appends a description of the given (explicitly generated) symmetry relative to the given element: every element
+	 * of the group is described by the positions of its indices in the given one (or by the index itself, if it doesn't
+	 * appear in there) along with the factor relating the two.
+	 */
+	void appendExplicitSymmetry(CanonicalLabelling::key_t &key, const PermutationGroup &symmetry,
+								const PermutationGroup::Element &reference) {
+		std::vector< CanonicalLabelling::key_t > descriptions;
+
+		for (const PermutationGroup::Element &currentElement : symmetry.getIndexPermutations()) {
+			CanonicalLabelling::key_t currentDescription;
+
+			for (const Index &currentIndex : currentElement.indexSequence) {
+				if (std::optional< std::size_t > position = find(reference.indexSequence, currentIndex)) {
+					currentDescription.push_back(*position);
+				} else {
+					currentDescription.push_back(encode(currentIndex, true, currentIndex.getID())
+												 | (CanonicalLabelling::key_entry_t(1) << 63));
+				}
+			}
+
+			// The factors are 1, 0 or -1
+			currentDescription.push_back(currentElement.factor * reference.factor + 1);
+
+			descriptions.push_back(std::move(currentDescription));
+		}
+
+		std::sort(descriptions.begin(), descriptions.end());
+
+		for (const CanonicalLabelling::key_t &currentDescription : descriptions) {
+			key.insert(key.end(), currentDescription.begin(), currentDescription.end());
+		}
+	}
+
+	class LabellingSearch {
+	public:
+		LabellingSearch(const Term &term, const CanonicalLabelling::Options &options)
+			: m_options(options), m_result(term.getResult().getIndices()) {
+			assert(options.symmetry || !options.symmetricSequences);
+
+			for (const Tensor &currentTensor : term.getTensors()) {
+				m_tensors.push_back(&currentTensor);
+				m_explicitSymmetries.push_back(options.symmetry
+											   && !currentTensor.getSymmetry().getSlotDescription().has_value());
+
+				CanonicalLabelling::key_t description;
+				if (options.names) {
+					appendName(description, currentTensor.getName());
+				}
+				description.push_back(currentTensor.getIndices().size());
+				if (options.symmetry) {
+					appendSymmetry(description, currentTensor.getSymmetry());
+				}
+
+				m_descriptions.push_back(std::move(description));
+			}
+
+			// Only Tensors with the same description can be exchanged with one another. The descriptions determine
+			// the order of the Tensors as far as possible.
+			m_slotTensors.resize(m_tensors.size());
+			std::iota(m_slotTensors.begin(), m_slotTensors.end(), 0);
+			std::stable_sort(m_slotTensors.begin(), m_slotTensors.end(), [this](std::size_t lhs, std::size_t rhs) {
+				return m_descriptions[lhs] < m_descriptions[rhs];
+			});
+
+			m_classes.resize(m_tensors.size());
+			for (std::size_t i = 1; i < m_slotTensors.size(); ++i) {
+				const bool sameClass = m_descriptions[m_slotTensors[i - 1]] == m_descriptions[m_slotTensors[i]];
+
+				m_classes[m_slotTensors[i]] = m_classes[m_slotTensors[i - 1]] + (sameClass ? 0 : 1);
+			}
+		}
+
+		const PartialLabelling &run() {
+			PartialLabelling start;
+			start.used.resize(m_tensors.size(), false);
+
+			search(start);
+
+			assert(m_best.has_value());
+
+			return *m_best;
+		}
+
+		CanonicalLabelling::key_t getHeader() const {
+			CanonicalLabelling::key_t header = { m_result.size(), m_tensors.size() };
+
+			if (m_options.resultPositions) {
+				for (std::size_t i = 0; i < m_result.size(); ++i) {
+					header.push_back(encode(m_result[i], false, *find(m_result, m_result[i])));
+				}
+			}
+
+			for (std::size_t current : m_slotTensors) {
+				header.insert(header.end(), m_descriptions[current].begin(), m_descriptions[current].end());
+			}
+
+			return header;
+		}
+
+	protected:
+		CanonicalLabelling::Options m_options;
+		IndexList m_result;
+		std::vector< const Tensor * > m_tensors;
+		std::vector< CanonicalLabelling::key_t > m_descriptions;
+		std::vector< bool > m_explicitSymmetries;
+		/**
+		 * The Tensors sorted by their descriptions and the class (of interchangeable Tensors) every Tensor belongs to
+		 */
+		std::vector< std::size_t > m_slotTensors;
+		std::vector< std::size_t > m_classes;
+		std::optional< PartialLabelling > m_best;
+
+		/**
+		 * @returns The encoding of the index in the given slot of the given sequence, if it was appended to the given
+		 * partial labelling. Indices that are not labelled yet get labels in the order of their first appearance in
+		 * the sequence.
+		 */
+		CanonicalLabelling::key_entry_t encodeSlot(const PartialLabelling &labelling, const IndexList &sequence,
+												   std::size_t slot) const {
+			const Index &index  = sequence[slot];
+			const bool external = find(m_result, index).has_value();
+
+			if (external && m_options.resultPositions) {
+				return encode(index, false, *find(m_result, index));
+			}
+
+			const std::vector< Index > &labelled = external ? labelling.externalIndices : labelling.contractedIndices;
+
+			if (std::optional< std::size_t > label = find(labelled, index)) {
+				return encode(index, !external, *label);
+			}
+
+			IndexList newIndices;
+			for (std::size_t i = 0; !Index::index_has_same_name{}(sequence[i], index); ++i) {
+				const Index &currentIndex = sequence[i];
+
+				if (find(m_result, currentIndex).has_value() == external && !find(labelled, currentIndex)
+					&& !find(newIndices, currentIndex)) {
+					newIndices.push_back(currentIndex);
+				}
+			}
+
+			return encode(index, !external, labelled.size() + newIndices.size());
+		}
+
+		Candidate createCandidate(const PartialLabelling &labelling, std::size_t tensor,
+								  PermutationGroup::Element element) const {
+			Candidate candidate = { tensor, std::move(element), {}, {}, {} };
+
+			const IndexList &sequence = candidate.element.indexSequence;
+
+			for (std::size_t i = 0; i < sequence.size(); ++i) {
+				candidate.block.push_back(encodeSlot(labelling, sequence, i));
+
+				const bool external = find(m_result, sequence[i]).has_value();
+				if (external && m_options.resultPositions) {
+					continue;
+				}
+
+				const std::vector< Index > &labelled =
+					external ? labelling.externalIndices : labelling.contractedIndices;
+				std::vector< Index > &newIndices =
+					external ? candidate.newExternalIndices : candidate.newContractedIndices;
+
+				if (!find(labelled, sequence[i]) && !find(newIndices, sequence[i])) {
+					newIndices.push_back(sequence[i]);
+				}
+			}
+
+			if (m_explicitSymmetries[tensor]) {
+				appendExplicitSymmetry(candidate.block, m_tensors[tensor]->getSymmetry(), candidate.element);
+			}
+
+			return candidate;
+		}
+
+		/**
+		 * @returns The index sequences of the given Tensor that lead to the smallest block when appended to the given
+		 * partial labelling
+		 */
+		std::vector< PermutationGroup::Element > getSequences(const PartialLabelling &labelling,
+															  std::size_t tensor) const {
+			const Tensor &currentTensor = *m_tensors[tensor];
+
+			if (!m_options.symmetricSequences) {
+				return { PermutationGroup::Element(currentTensor.getIndices(),
+												   *currentTensor.getSymmetry().getFactor(currentTensor.getIndices())) };
+			}
+
+			return currentTensor.getSymmetry().getMinimalElements(
+				[&](const IndexList &sequence, std::size_t slot) { return encodeSlot(labelling, sequence, slot); });
+		}
+
+		/**
+		 * @returns Whether the given partial labelling extended by the given block is lexicographically greater than
+		 * the best labelling found so far
+		 */
+		bool isWorse(const PartialLabelling &labelling, const CanonicalLabelling::key_t &block) const {
+			if (!m_best) {
+				return false;
+			}
+
+			const CanonicalLabelling::key_t &best = m_best->blocks;
+
+			auto [currentIt, bestIt] = std::mismatch(labelling.blocks.begin(), labelling.blocks.end(), best.begin());
+			if (currentIt != labelling.blocks.end()) {
+				return *currentIt > *bestIt;
+			}
+
+			auto [blockIt, bestBlockIt] = std::mismatch(block.begin(), block.end(), bestIt);
+
+			return blockIt != block.end() && *blockIt > *bestBlockIt;
+		}
+
+		void search(const PartialLabelling &labelling) {
+			const std::size_t depth = labelling.order.size();
+
+			if (depth == m_tensors.size()) {
+				if (!m_best || labelling.blocks < m_best->blocks) {
+					m_best = labelling;
+				}
+
+				return;
+			}
+
+			const std::size_t slotClass = m_classes[m_slotTensors[depth]];
+
+			// Only the smallest blocks of every Tensor can be the smallest block overall
+			std::vector< Candidate > candidates;
+			for (std::size_t i = 0; i < m_tensors.size(); ++i) {
+				if (labelling.used[i] || m_classes[i] != slotClass) {
+					continue;
+				}
+
+				for (PermutationGroup::Element &currentElement : getSequences(labelling, i)) {
+					candidates.push_back(createCandidate(labelling, i, std::move(currentElement)));
+				}
+			}
+
+			assert(!candidates.empty());
+
+			const CanonicalLabelling::key_t &minimalBlock =
+				std::min_element(candidates.begin(), candidates.end(), [](const Candidate &lhs, const Candidate &rhs) {
+					return lhs.block < rhs.block;
+				})->block;
+
+			if (isWorse(labelling, minimalBlock)) {
+				return;
+			}
+
+			// Only the choices leading to the smallest encoding can be part of the canonical labelling, but as the
+			// choice influences the labels of contracted indices in the remaining Tensors, all of them have to be
+			// followed
+			for (const Candidate &currentCandidate : candidates) {
+				if (currentCandidate.block != minimalBlock) {
+					continue;
+				}
+
+				PartialLabelling extended = labelling;
+				extended.order.push_back(currentCandidate.tensor);
+				extended.sequences.push_back(currentCandidate.element.indexSequence);
+				extended.used[currentCandidate.tensor] = true;
+				extended.contractedIndices.insert(extended.contractedIndices.end(),
+												  currentCandidate.newContractedIndices.begin(),
+												  currentCandidate.newContractedIndices.end());
+				extended.externalIndices.insert(extended.externalIndices.end(),
+												currentCandidate.newExternalIndices.begin(),
+												currentCandidate.newExternalIndices.end());
+				extended.blocks.insert(extended.blocks.end(), currentCandidate.block.begin(),
+									   currentCandidate.block.end());
+
+				search(extended);
+			}
+		}
+	};
+}; // namespace
+
+CanonicalLabelling::CanonicalLabelling(const Term &term) : CanonicalLabelling(term, Options()) {
+}
+
+CanonicalLabelling::CanonicalLabelling(const Term &term, const Options &options) {
+	LabellingSearch search(term, options);
+
+	const PartialLabelling &best = search.run();
+
+	m_key = search.getHeader();
+	m_key.insert(m_key.end(), best.blocks.begin(), best.blocks.end());
+
+	m_order             = best.order;
+	m_sequences         = best.sequences;
+	m_contractedIndices = best.contractedIndices;
+
+	for (std::size_t i = 0; i < m_order.size(); ++i) {
+		const Tensor &currentTensor = term.getTensors()[m_order[i]];
+
+		// Both factors are relative to the root sequence of the Tensor's symmetry (and are either 1 or -1)
+		m_factor *= *currentTensor.getSymmetry().getFactor(m_sequences[i])
+					* *currentTensor.getSymmetry().getFactor(currentTensor.getIndices());
+	}
+}
+
+const CanonicalLabelling::key_t &CanonicalLabelling::getKey() const {
+	return m_key;
+}
+
+std::size_t CanonicalLabelling::getHash() const {
+	std::size_t hash = 0;
+	for (key_entry_t currentEntry : m_key) {
+		hash = hash * 31 + std::hash< key_entry_t >{}(currentEntry);
+	}
+
+	return hash;
+}
+
+int CanonicalLabelling::getFactor() const {
+	return m_factor;
+}
+
+const std::vector< std::size_t > &CanonicalLabelling::getOrder() const {
+	return m_order;
+}
+
+void CanonicalLabelling::apply(Term &term) const {
+	Span< Tensor > tensors = term.accessTensors();
+
+	assert(tensors.size() == m_order.size());
+
+	std::vector< Tensor > canonicalTensors;
+	canonicalTensors.reserve(tensors.size());
+
+	int factor = 1;
+	for (std::size_t i = 0; i < m_order.size(); ++i) {
+		canonicalTensors.push_back(tensors[m_order[i]]);
+		factor *= canonicalTensors.back().setIndexSequence(m_sequences[i]);
+	}
+
+	// The contracted indices are named in the order of their appearance, using IDs that don't clash with the ones of
+	// the result Tensor's indices
+	std::unordered_map< IndexSpace, Index::id_t > nextIDs;
+	for (const Index &currentIndex : term.getResult().getIndices()) {
+		Index::id_t &nextID = nextIDs[currentIndex.getSpace()];
+		nextID              = std::max(nextID, currentIndex.getID() + 1);
+	}
+
+	IndexSubstitution::substitution_list renamings;
+	for (const Index &currentIndex : m_contractedIndices) {
+		Index canonicalIndex = currentIndex;
+		canonicalIndex.setID(nextIDs[currentIndex.getSpace()]++);
+
+		if (!Index::index_has_same_name{}(currentIndex, canonicalIndex)) {
+			renamings.push_back({ currentIndex, std::move(canonicalIndex) });
+		}
+	}
+
+	const IndexSubstitution renaming(std::move(renamings), 1, false);
+
+	for (std::size_t i = 0; i < canonicalTensors.size(); ++i) {
+		renaming.apply(canonicalTensors[i]);
+
+		tensors[i] = std::move(canonicalTensors[i]);
+	}
+
+	term.setPrefactor(term.getPrefactor() * factor);
+}
+
+}; // namespace Contractor::Terms
@@ -0,0 +1,97 @@
+#include "terms/Cost.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace Contractor::Terms {
+
+/**
+ * @returns The biggest value that can be represented natively, as a multiprecision integer
+ */
+const Cost::multiprecision_t &getNativeMax() {
+	static const Cost::multiprecision_t nativeMax = (Cost::multiprecision_t(1) << Cost::nativeBits) - 1;
+
+	return nativeMax;
+}
+
+Cost::Cost(const multiprecision_t &value) {
+	assign(value);
+}
+
+Cost::Cost(std::string_view value) {
+	// Let Boost do the parsing (and the error reporting)
+	assign(multiprecision_t(std::string(value)));
+}
+
+std::string Cost::str() const {
+	if (m_multiprecision) {
+		return m_multiprecision->str();
+	}
+
+	if (m_native == 0) {
+		return "0";
+	}
+
+	std::string digits;
+	for (native_t remainder = m_native; remainder > 0; remainder /= 10) {
+		digits.push_back(static_cast< char >('0' + static_cast< int >(remainder % 10)));
+	}
+
+	std::reverse(digits.begin(), digits.end());
+
+	return digits;
+}
+
+Cost::multiprecision_t Cost::toMultiprecision() const {
+	if (m_multiprecision) {
+		return *m_multiprecision;
+	}
+
+	// Assemble the value from 64-bit chunks as multiprecision_t can't be constructed from (unsigned) __int128 directly
+	multiprecision_t value = 0;
+	for (unsigned int shift = 0; shift < nativeBits; shift += 64) {
+		value |= multiprecision_t(static_cast< std::uint64_t >(m_native >> shift)) << shift;
+	}
+
+	return value;
+}
+
+Cost &Cost::assign(const multiprecision_t &value) {
+	if (value > getNativeMax()) {
+		m_native         = 0;
+		m_multiprecision = std::make_unique< multiprecision_t >(value);
+	} else {
+		const multiprecision_t lowMask = std::numeric_limits< std::uint64_t >::max();
+
+		m_native = 0;
+		for (unsigned int shift = 0; shift < nativeBits; shift += 64) {
+			m_native |= static_cast< native_t >(((value >> shift) & lowMask).convert_to< std::uint64_t >()) << shift;
+		}
+		m_multiprecision.reset();
+	}
+
+	return *this;
+}
+
+Cost &Cost::addSlow(const Cost &other) {
+	return assign(toMultiprecision() + other.toMultiprecision());
+}
+
+Cost &Cost::subtractSlow(const Cost &other) {
+	return assign(toMultiprecision() - other.toMultiprecision());
+}
+
+Cost &Cost::multiplySlow(const Cost &other) {
+	return assign(toMultiprecision() * other.toMultiprecision());
+}
+
+Cost &Cost::divideSlow(const Cost &other) {
+	if (other == 0) {
+		throw std::overflow_error("Division of a Cost by zero");
+	}
+
+	return assign(toMultiprecision() / other.toMultiprecision());
+}
+
+}; // namespace Contractor::Terms
@@ -0,0 +1,116 @@
+#include "terms/CostPolynomial.hpp"
+#include "terms/IndexSpaceMeta.hpp"
+#include "utils/IndexSpaceResolver.hpp"
+
+#include <algorithm>
+
+namespace Contractor::Terms {
+
+CostPolynomial::CostPolynomial(const std::unordered_map< IndexSpace, unsigned int > &exponents,
+							   const cost_t &coefficient) {
+	if (coefficient == 0) {
+		return;
+	}
+
+	exponent_list_t monomial;
+	for (const auto &currentPair : exponents) {
+		if (currentPair.second == 0) {
+			continue;
+		}
+
+		if (monomial.size() <= currentPair.first.getID()) {
+			monomial.resize(currentPair.first.getID() + 1, 0);
+		}
+
+		monomial[currentPair.first.getID()] = currentPair.second;
+	}
+
+	m_monomials[std::move(monomial)] = coefficient;
+}
+
+bool operator==(const CostPolynomial &lhs, const CostPolynomial &rhs) {
+	return lhs.m_monomials == rhs.m_monomials;
+}
+
+bool operator!=(const CostPolynomial &lhs, const CostPolynomial &rhs) {
+	return !(lhs == rhs);
+}
+
+CostPolynomial &CostPolynomial::operator+=(const CostPolynomial &other) {
+	for (const auto &currentPair : other.m_monomials) {
+		m_monomials[currentPair.first] += currentPair.second;
+	}
+
+	return *this;
+}
+
+CostPolynomial operator+(CostPolynomial lhs, const CostPolynomial &rhs) {
+	lhs += rhs;
+
+	return lhs;
+}
+
+const CostPolynomial::monomial_map_t &CostPolynomial::getMonomials() const {
+	return m_monomials;
+}
+
+bool CostPolynomial::isZero() const {
+	return m_monomials.empty();
+}
+
+unsigned int CostPolynomial::getDegree() const {
+	unsigned int degree = 0;
+
+	for (const auto &currentPair : m_monomials) {
+		unsigned int currentDegree = 0;
+		for (unsigned int currentExponent : currentPair.first) {
+			currentDegree += currentExponent;
+		}
+
+		degree = std::max(degree, currentDegree);
+	}
+
+	return degree;
+}
+
+CostPolynomial::cost_t CostPolynomial::evaluate(const size_point_t &sizes) const {
+	cost_t cost = 0;
+
+	for (const auto &currentPair : m_monomials) {
+		cost_t currentCost = currentPair.second;
+
+		for (std::size_t i = 0; i < currentPair.first.size(); ++i) {
+			const cost_t &currentSize = i < sizes.size() ? sizes[i] : cost_t(0);
+
+			for (unsigned int j = 0; j < currentPair.first[i]; ++j) {
+				currentCost *= currentSize;
+			}
+		}
+
+		cost += currentCost;
+	}
+
+	return cost;
+}
+
+CostPolynomial::cost_t CostPolynomial::evaluate(const Utils::IndexSpaceResolver &resolver) const {
+	return evaluate(getSizePoint(resolver));
+}
+
+CostPolynomial::size_point_t CostPolynomial::getSizePoint(const Utils::IndexSpaceResolver &resolver) {
+	size_point_t sizes;
+
+	for (const IndexSpaceMeta &currentMeta : resolver.getMetaList()) {
+		const IndexSpace::id_t id = currentMeta.getSpace().getID();
+
+		if (sizes.size() <= id) {
+			sizes.resize(id + 1, 0);
+		}
+
+		sizes[id] = currentMeta.getSize();
+	}
+
+	return sizes;
+}
+
+}; // namespace Contractor::Terms
@@ -57,16 +57,12 @@ void GeneralTerm::sort() {
 	std::sort(m_tensors.begin(), m_tensors.end());
 }
 
-Tensor &GeneralTerm::get(std::size_t index) {
-	assert(index < m_tensors.size());
-
-	return m_tensors[index];
+Span< Tensor > GeneralTerm::accessTensorStorage() {
+	return Span< Tensor >(m_tensors.data(), m_tensors.size());
 }
 
-const Tensor &GeneralTerm::get(std::size_t index) const {
-	assert(index < m_tensors.size());
-
-	return m_tensors[index];
+Span< const Tensor > GeneralTerm::getTensorStorage() const {
+	return Span< const Tensor >(m_tensors.data(), m_tensors.size());
 }
 
 }; // namespace Contractor::Terms
@@ -34,6 +34,10 @@ unsigned int IndexSpaceMeta::getSize() const {
 	return m_size;
 }
 
+void IndexSpaceMeta::setSize(IndexSpaceMeta::size_t size) {
+	m_size = size;
+}
+
 const IndexSpace &IndexSpaceMeta::getSpace() const {
 	return m_space;
 }
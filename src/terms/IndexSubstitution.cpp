@@ -20,7 +20,7 @@ IndexSubstitution IndexSubstitution::createPermutation(const std::vector< IndexP
 	return IndexSubstitution(std::move(substitutions), factor);
 }
 
-IndexSubstitution IndexSubstitution::createCyclicPermutation(const std::vector< Index > &indices,
+IndexSubstitution IndexSubstitution::createCyclicPermutation(const IndexList &indices,
 															 IndexSubstitution::factor_t factor) {
 	assert(indices.size() > 1);
 
@@ -156,9 +156,10 @@ void IndexSubstitution::setRespectSpin(bool respectSpin) {
 }
 
 IndexSubstitution::factor_t IndexSubstitution::apply(Tensor &tensor) const {
-	IndexSubstitution::factor_t factor = apply(tensor.getIndices());
+	Tensor::index_list_t indices       = tensor.getIndices();
+	IndexSubstitution::factor_t factor = apply(indices);
 
-	PermutationGroup transformedSymmetry(tensor.getIndices());
+	PermutationGroup transformedSymmetry(indices);
 	for (const IndexSubstitution &currentPermutation : tensor.getSymmetry().getGenerators()) {
 		IndexSubstitution copy = currentPermutation;
 		apply(copy);
@@ -168,12 +169,12 @@ IndexSubstitution::factor_t IndexSubstitution::apply(Tensor &tensor) const {
 
 	transformedSymmetry.regenerateGroup();
 
-	tensor.setSymmetry(transformedSymmetry);
+	tensor.setIndices(std::move(indices), std::move(transformedSymmetry));
 
 	return factor;
 }
 
-IndexSubstitution::factor_t IndexSubstitution::apply(std::vector< Index > &indices) const {
+IndexSubstitution::factor_t IndexSubstitution::apply(IndexList &indices) const {
 	for (std::size_t i = 0; i < indices.size(); i++) {
 		for (const IndexSubstitution::index_pair_t &currentPermutation : m_substitutions) {
 			// Replace all occurrences of the two indices
@@ -252,7 +253,7 @@ bool IndexSubstitution::appliesTo(const Tensor &tensor) const {
 	return appliesTo(tensor.getIndices());
 }
 
-bool IndexSubstitution::appliesTo(const std::vector< Index > &indices) const {
+bool IndexSubstitution::appliesTo(const IndexList &indices) const {
 	// A substitution applies, if all subsitutions can be carried out on the given index list (that is all
 	// indices referenced in the substitutions are contained in the given Tensor)
 	for (const index_pair_t &currentPair : m_substitutions) {
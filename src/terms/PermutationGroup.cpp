@@ -1,18 +1,120 @@
 #include "terms/PermutationGroup.hpp"
+#include "terms/StabilizerChain.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
+#include <unordered_map>
+
+#include <boost/functional/hash.hpp>
+#include <boost/range/join.hpp>
 
 namespace Contractor::Terms {
 
-PermutationGroup::PermutationGroup(const Element &startConfiguration) : m_permutations({ startConfiguration }) {
+struct PermutationGroup::Pattern {
+	std::vector< SlotPermutation > generators;
+	/**
+	 * The group spanned by the generators. The sign of the permutations is encoded as the exchange of the two points
+	 * following the actual slots.
+	 */
+	StabilizerChain chain;
+
+	explicit Pattern(std::size_t rank) : chain(rank + 2) {}
+};
+
+static StabilizerChain::permutation_t toChainElement(const SlotPermutation &permutation) {
+	const std::size_t rank = permutation.getRank();
+
+	StabilizerChain::permutation_t element(permutation.getImages().begin(), permutation.getImages().end());
+	element.push_back(static_cast< StabilizerChain::point_t >(permutation.getSign() == 1 ? rank : rank + 1));
+	element.push_back(static_cast< StabilizerChain::point_t >(permutation.getSign() == 1 ? rank + 1 : rank));
+
+	return element;
 }
 
-PermutationGroup::PermutationGroup(Element &&startConfiguration) : m_permutations({ std::move(startConfiguration) }) {
+static SlotPermutation fromChainElement(const StabilizerChain::permutation_t &element) {
+	const std::size_t rank = element.size() - 2;
+
+	return SlotPermutation(SlotPermutation::slot_list_t(element.begin(), element.begin() + rank),
+						   element[rank] == rank ? 1 : -1);
+}
+
+std::shared_ptr< const PermutationGroup::Pattern >
+	PermutationGroup::getPattern(std::size_t rank, const std::vector< SlotPermutation > &generators) {
+	using key_t = std::pair< std::size_t, std::vector< SlotPermutation > >;
+
+	struct key_hash {
+		std::size_t operator()(const key_t &key) const {
+			std::size_t hash = key.first;
+			for (const SlotPermutation &currentGenerator : key.second) {
+				boost::hash_combine(hash, std::hash< SlotPermutation >{}(currentGenerator));
+			}
+
+			return hash;
+		}
+	};
+
+	static std::shared_mutex mutex;
+	static std::unordered_map< key_t, std::shared_ptr< const Pattern >, key_hash > patterns;
+
+	key_t key(rank, generators);
+
+	{
+		std::shared_lock< std::shared_mutex > lock(mutex);
+
+		auto it = patterns.find(key);
+		if (it != patterns.end()) {
+			return it->second;
+		}
+	}
+
+	auto pattern = std::make_shared< Pattern >(rank);
+	for (const SlotPermutation &currentGenerator : generators) {
+		if (pattern->chain.addGenerator(toChainElement(currentGenerator))) {
+			pattern->generators.push_back(currentGenerator);
+		}
+	}
+
+	std::unique_lock< std::shared_mutex > lock(mutex);
+
+	// Another thread might have inserted the same pattern in the meantime
+	return patterns.emplace(std::move(key), std::move(pattern)).first->second;
+}
+
+PermutationGroup::PermutationGroup(const Element &startConfiguration) : PermutationGroup() {
+	setRootSequence(startConfiguration);
+}
+
+PermutationGroup::PermutationGroup(Element &&startConfiguration) : PermutationGroup() {
+	setRootSequence(startConfiguration);
 }
 
 bool operator==(const PermutationGroup &lhs, const PermutationGroup &rhs) {
+	if ((lhs.m_pattern == nullptr) != (rhs.m_pattern == nullptr)) {
+		// Groups that can be represented as permutations of their root sequence can't be equal to ones that can't
+		return false;
+	}
+
+	if (lhs.m_pattern) {
+		if (lhs.m_pattern == rhs.m_pattern && lhs.m_root->indexSequence == rhs.m_root->indexSequence) {
+			return true;
+		}
+
+		// Equal groups act on the same set of sequences and thus have the same canonical representation. Given that,
+		// the permutations of both groups act on the same indices and the groups are equal if one is a subgroup of the
+		// other and both have the same size.
+		if (lhs.size() != rhs.size() || lhs.m_canonical != rhs.m_canonical) {
+			return false;
+		}
+
+		const std::vector< IndexSubstitution > generators = lhs.getGenerators();
+
+		return std::all_of(generators.begin(), generators.end(),
+						   [&rhs](const IndexSubstitution &current) { return rhs.contains(current); });
+	}
+
 	if (lhs.m_generators.size() + lhs.m_additionalElements.size()
 		!= rhs.m_generators.size() + rhs.m_additionalElements.size()) {
 		return false;
@@ -52,7 +154,7 @@ bool operator!=(const PermutationGroup &lhs, const PermutationGroup &rhs) {
 std::ostream &operator<<(std::ostream &stream, const PermutationGroup &group) {
 	stream << "[";
 
-	if (group.m_permutations.size() > 0) {
+	if (group.m_root) {
 		for (std::size_t i = 0; i < group.getCanonicalRepresentation().size(); ++i) {
 			stream << group.getCanonicalRepresentation()[i];
 
@@ -66,10 +168,12 @@ std::ostream &operator<<(std::ostream &stream, const PermutationGroup &group) {
 
 	stream << "]{";
 
-	for (std::size_t i = 0; i < group.m_generators.size(); ++i) {
-		stream << group.m_generators[i];
+	const std::vector< IndexSubstitution > generators = group.getGenerators();
+
+	for (std::size_t i = 0; i < generators.size(); ++i) {
+		stream << generators[i];
 
-		if (i + i < group.m_generators.size()) {
+		if (i + i < generators.size()) {
 			stream << ", ";
 		}
 	}
@@ -89,35 +193,198 @@ void PermutationGroup::addGenerator(IndexSubstitution &&generator, bool regenera
 			"Permutations with a factor different of -1, 1 or 0 can't lead to a finite permutation group!");
 	}
 
-	if (contains(generator)) {
+	if (m_pattern) {
+		std::optional< SlotPermutation > permutation =
+			SlotPermutation::fromSubstitution(generator, m_root->indexSequence);
+
+		if (permutation) {
+			if (m_pattern->chain.contains(toChainElement(*permutation))) {
+				// This symmetry operation is already contained in this group
+				return;
+			}
+
+			std::vector< SlotPermutation > generators = m_pattern->generators;
+			generators.push_back(std::move(*permutation));
+
+			m_pattern = getPattern(m_root->indexSequence.size(), generators);
+		} else {
+			// From now on we have to generate the group explicitly
+			m_generators = getGenerators();
+			m_generators.push_back(std::move(generator));
+			m_pattern.reset();
+		}
+	} else if (contains(generator)) {
 		// This symmetry operation is already contained in  this group
 		return;
+	} else {
+		m_generators.push_back(std::move(generator));
 	}
 
-	m_generators.push_back(std::move(generator));
-
 	if (regenerate) {
 		regenerateGroup();
 	}
 }
 
-const std::vector< IndexSubstitution > &PermutationGroup::getGenerators() const {
-	return m_generators;
+std::vector< IndexSubstitution > PermutationGroup::getGenerators() const {
+	if (!m_pattern) {
+		return m_generators;
+	}
+
+	std::vector< IndexSubstitution > generators = { IndexSubstitution::identity() };
+	for (const SlotPermutation &currentGenerator : m_pattern->generators) {
+		generators.push_back(currentGenerator.toSubstitution(m_root->indexSequence));
+	}
+
+	return generators;
 }
 
-const std::vector< IndexSubstitution > &PermutationGroup::getAdditionalSymmetryOperations() const {
-	return m_additionalElements;
+std::vector< IndexSubstitution > PermutationGroup::getAdditionalSymmetryOperations() const {
+	if (!m_pattern) {
+		return m_additionalElements;
+	}
+
+	std::vector< IndexSubstitution > operations;
+
+	m_pattern->chain.forEachElement([&](const StabilizerChain::permutation_t &element) {
+		const SlotPermutation permutation = fromChainElement(element);
+
+		if (!permutation.isIdentity()
+			&& std::find(m_pattern->generators.begin(), m_pattern->generators.end(), permutation)
+				   == m_pattern->generators.end()) {
+			operations.push_back(permutation.toSubstitution(m_root->indexSequence));
+		}
+	});
+
+	return operations;
+}
+
+std::vector< PermutationGroup::Element > PermutationGroup::getIndexPermutations() const {
+	if (!m_pattern) {
+		return m_permutations;
+	}
+
+	std::vector< Element > permutations;
+	permutations.reserve(m_pattern->chain.order());
+
+	m_pattern->chain.forEachElement([&](const StabilizerChain::permutation_t &element) {
+		permutations.push_back(toElement(fromChainElement(element)));
+	});
+
+	// sort the contained permutations into a "canonical order"
+	std::sort(permutations.begin(), permutations.end());
+
+	return permutations;
 }
 
-const std::vector< PermutationGroup::Element > &PermutationGroup::getIndexPermutations() const {
-	return m_permutations;
+std::vector< PermutationGroup::Element > PermutationGroup::getMinimalElements(
+	const std::function< std::uint64_t(const IndexList &, std::size_t) > &value) const {
+	if (!m_pattern) {
+		std::vector< Element > minimalElements;
+		std::vector< std::uint64_t > minimalValues;
+
+		for (const Element &currentElement : m_permutations) {
+			std::vector< std::uint64_t > currentValues;
+			for (std::size_t i = 0; i < currentElement.indexSequence.size(); ++i) {
+				currentValues.push_back(value(currentElement.indexSequence, i));
+			}
+
+			if (minimalElements.empty() || currentValues < minimalValues) {
+				minimalElements.clear();
+				minimalValues = std::move(currentValues);
+			} else if (currentValues > minimalValues) {
+				continue;
+			}
+
+			minimalElements.push_back(currentElement);
+		}
+
+		return minimalElements;
+	}
+
+	const IndexList &root = m_root->indexSequence;
+
+	std::vector< StabilizerChain::permutation_t > minimalPermutations =
+		m_pattern->chain.findMinimalElements([&](const StabilizerChain::permutation_t &permutation, std::size_t slot) {
+			if (slot >= root.size()) {
+				// The two additional positions encode the sign which is not part of the sequence
+				return std::uint64_t(0);
+			}
+
+			IndexList sequence(root.begin(), root.begin() + slot + 1);
+			for (std::size_t i = 0; i <= slot; ++i) {
+				// The type of an index is determined by its position in the sequence
+				sequence[i] = root[permutation[i]];
+				sequence[i].setType(root[i].getType());
+			}
+
+			return value(sequence, slot);
+		});
+
+	std::vector< Element > minimalElements;
+	for (const StabilizerChain::permutation_t &currentPermutation : minimalPermutations) {
+		minimalElements.push_back(toElement(fromChainElement(currentPermutation)));
+	}
+
+	return minimalElements;
+}
+
+std::optional< std::vector< SlotPermutation > > PermutationGroup::getSlotDescription() const {
+	if (!m_pattern) {
+		return {};
+	}
+
+	std::vector< SlotPermutation > description;
+	for (const StabilizerChain::permutation_t &currentTransversal : m_pattern->chain.getCanonicalTransversals()) {
+		description.push_back(fromChainElement(currentTransversal));
+	}
+
+	return description;
 }
 
 void PermutationGroup::setRootSequence(const Element &rootSequence) {
-	m_permutations.clear();
-	m_additionalElements.clear();
+	if (m_pattern && rootSequence.indexSequence.size() == m_root->indexSequence.size()) {
+		// If the new root sequence is a permutation p of the old one, the operations acting on the new sequence are
+		// obtained as the conjugates p^-1 * g * p of the old ones.
+		const IndexList &oldRoot = m_root->indexSequence;
+		const IndexList &newRoot = rootSequence.indexSequence;
+
+		SlotPermutation::slot_list_t images(newRoot.size());
+		bool isPermutation = true;
+		for (std::size_t i = 0; i < newRoot.size() && isPermutation; ++i) {
+			auto it = std::find_if(oldRoot.begin(), oldRoot.end(),
+								   [&](const Index &current) { return Index::isSame(current, newRoot[i]); });
+
+			isPermutation = it != oldRoot.end();
+			images[i]     = static_cast< SlotPermutation::slot_t >(std::distance(oldRoot.begin(), it));
+		}
+
+		if (isPermutation) {
+			const SlotPermutation relabeling(std::move(images));
+
+			if (!relabeling.isIdentity()) {
+				const SlotPermutation inverse = relabeling.inverse();
+
+				std::vector< SlotPermutation > generators;
+				for (const SlotPermutation &currentGenerator : m_pattern->generators) {
+					generators.push_back(inverse * currentGenerator * relabeling);
+				}
+
+				m_pattern = getPattern(relabeling.getRank(), generators);
+			}
 
-	m_permutations.push_back(rootSequence);
+			m_root = rootSequence;
+
+			regenerateGroup();
+
+			return;
+		}
+	}
+
+	std::vector< IndexSubstitution > generators = getGenerators();
+
+	m_root = rootSequence;
+
+	setGenerators(std::move(generators));
 
 	regenerateGroup();
 }
@@ -128,6 +395,15 @@ bool PermutationGroup::contains(const IndexSubstitution &permutation) const {
 		return true;
 	}
 
+	if (m_pattern) {
+		std::optional< SlotPermutation > converted =
+			SlotPermutation::fromSubstitution(permutation, m_root->indexSequence);
+
+		if (converted) {
+			return m_pattern->chain.contains(toChainElement(*converted));
+		}
+	}
+
 	auto it = std::find(m_generators.begin(), m_generators.end(), permutation);
 
 	if (it != m_generators.end()) {
@@ -140,55 +416,171 @@ bool PermutationGroup::contains(const IndexSubstitution &permutation) const {
 };
 
 struct equal_sequence {
-	const std::vector< Index > &sequence;
+	const IndexList &sequence;
 
 	bool operator()(const PermutationGroup::Element &current) const { return current.indexSequence == sequence; }
 };
 
-bool PermutationGroup::contains(const std::vector< Index > &indexSequence) const {
-	return std::find_if(m_permutations.begin(), m_permutations.end(), equal_sequence{ indexSequence })
-		   != m_permutations.end();
+bool PermutationGroup::contains(const IndexList &indexSequence) const {
+	return getFactor(indexSequence).has_value();
+}
+
+std::optional< int > PermutationGroup::getFactor(const IndexList &indexSequence) const {
+	if (!m_pattern) {
+		auto it = std::find_if(m_permutations.begin(), m_permutations.end(), equal_sequence{ indexSequence });
+
+		if (it == m_permutations.end()) {
+			return {};
+		}
+
+		return it->factor;
+	}
+
+	const IndexList &root = m_root->indexSequence;
+
+	if (indexSequence.size() != root.size()) {
+		return {};
+	}
+
+	// Find the permutation of the root sequence that yields the given one (permuting the root sequence never changes
+	// the type of the index at a given position)
+	SlotPermutation::slot_list_t images(root.size());
+	for (std::size_t i = 0; i < indexSequence.size(); ++i) {
+		auto it = std::find_if(root.begin(), root.end(),
+							   [&](const Index &current) { return Index::isSame(current, indexSequence[i]); });
+
+		if (it == root.end() || indexSequence[i].getType() != root[i].getType()) {
+			return {};
+		}
+
+		images[i] = static_cast< SlotPermutation::slot_t >(std::distance(root.begin(), it));
+	}
+
+	// The sequence might be reachable with either sign
+	for (int sign : { 1, -1 }) {
+		if (m_pattern->chain.contains(toChainElement(SlotPermutation(images, sign)))) {
+			return m_root->factor * sign;
+		}
+	}
+
+	return {};
 }
 
 std::size_t PermutationGroup::size() const {
+	if (m_pattern) {
+		return m_pattern->chain.order();
+	}
+
 	return m_generators.size() + m_additionalElements.size();
 }
 
-const std::vector< Index > &PermutationGroup::getCanonicalRepresentation() const {
-	static const std::vector< Index > empty;
-
-	return m_permutations.empty() ? empty : m_permutations[0].indexSequence;
+const IndexList &PermutationGroup::getCanonicalRepresentation() const {
+	return m_canonical.indexSequence;
 }
 
 int PermutationGroup::getCanonicalRepresentationFactor() const {
-	return m_permutations.empty() ? 1 : m_permutations[0].factor;
+	return m_canonical.factor;
 }
 
 
 void PermutationGroup::regenerateGroup() {
+	m_additionalElements.clear();
+	m_permutations.clear();
+
+	if (!m_root) {
+		m_canonical = Element();
+
+		generateSymmetryOperations();
+
+		return;
+	}
+
+	if (m_pattern) {
+		// The pattern is kept up-to-date by addGenerator and setRootSequence
+		const IndexList &root = m_root->indexSequence;
+
+		// Compare positions by the indices at these positions. Two additional positions encode the sign which is
+		// preferred to be positive.
+		auto less = [&root](StabilizerChain::point_t lhs, StabilizerChain::point_t rhs) {
+			if (lhs >= root.size() || rhs >= root.size()) {
+				return lhs < rhs;
+			}
+
+			// The type of an index is determined by its position in the sequence
+			Index lhsIndex = root[lhs];
+			lhsIndex.setType(root[rhs].getType());
+
+			return lhsIndex < root[rhs];
+		};
+
+		m_canonical = toElement(fromChainElement(m_pattern->chain.findMinimalElement(less)));
+
+		return;
+	}
+
 	generateSymmetryOperations();
 
-	if (!m_permutations.empty()) {
-		// Based on the contained permutation operations, we can now (re)generate the resulting permutations of
-		// the index sequence
-		const Element reference = std::move(m_permutations[0]);
-		m_permutations.clear();
+	// Based on the contained permutation operations, we can now (re)generate the resulting permutations of
+	// the index sequence
+	for (const IndexSubstitution &currentPermutation : boost::join(m_generators, m_additionalElements)) {
+		assert(currentPermutation.appliesTo(m_root->indexSequence));
 
-		for (const IndexSubstitution &currentPermutation : boost::join(m_generators, m_additionalElements)) {
-			assert(currentPermutation.appliesTo(reference.indexSequence));
+		Element current = *m_root;
+		current.factor *= currentPermutation.apply(current.indexSequence);
+
+		m_permutations.push_back(std::move(current));
+	}
 
-			Element current = reference;
-			current.factor *= currentPermutation.apply(current.indexSequence);
+	// sort the contained permutations into a "canonical order"
+	std::sort(m_permutations.begin(), m_permutations.end());
 
-			m_permutations.push_back(std::move(current));
+	// Assert that m_permutations does not contain duplicates
+	assert(std::adjacent_find(m_permutations.begin(), m_permutations.end()) == m_permutations.end());
+
+	m_canonical = m_permutations[0];
+}
+
+void PermutationGroup::setGenerators(std::vector< IndexSubstitution > generators) {
+	const IndexList &root = m_root->indexSequence;
+
+	m_pattern.reset();
+	m_generators = std::move(generators);
+
+	for (std::size_t i = 0; i < root.size(); ++i) {
+		for (std::size_t j = i + 1; j < root.size(); ++j) {
+			if (Index::isSame(root[i], root[j])) {
+				// Permutations of the sequence are not unique
+				return;
+			}
+		}
+	}
+
+	std::vector< SlotPermutation > permutations;
+
+	for (const IndexSubstitution &currentGenerator : m_generators) {
+		if (currentGenerator.isIdentity()) {
+			continue;
 		}
 
-		// sort the contained permutations into a "canonical order"
-		std::sort(m_permutations.begin(), m_permutations.end());
+		std::optional< SlotPermutation > permutation = SlotPermutation::fromSubstitution(currentGenerator, root);
+
+		if (!permutation) {
+			return;
+		}
 
-		// Assert that m_permutations does not contain duplicates
-		assert(std::adjacent_find(m_permutations.begin(), m_permutations.end()) == m_permutations.end());
+		permutations.push_back(std::move(*permutation));
 	}
+
+	m_pattern = getPattern(root.size(), permutations);
+	m_generators.clear();
+}
+
+PermutationGroup::Element PermutationGroup::toElement(const SlotPermutation &permutation) const {
+	Element element(m_root->indexSequence, m_root->factor);
+
+	element.factor *= permutation.apply(element.indexSequence);
+
+	return element;
 }
 
 void PermutationGroup::generateSymmetryOperations(const IndexSubstitution &precedingOperation) {
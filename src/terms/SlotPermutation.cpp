@@ -0,0 +1,138 @@
+#include "terms/SlotPermutation.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace Contractor::Terms {
+
+SlotPermutation::SlotPermutation(std::size_t rank, int sign) : m_images(rank), m_sign(sign) {
+	for (std::size_t i = 0; i < rank; ++i) {
+		m_images[i] = static_cast< slot_t >(i);
+	}
+}
+
+SlotPermutation::SlotPermutation(slot_list_t images, int sign) : m_images(std::move(images)), m_sign(sign) {
+	assert(m_sign == 1 || m_sign == -1);
+}
+
+std::optional< SlotPermutation > SlotPermutation::fromSubstitution(const IndexSubstitution &substitution,
+																   const IndexList &reference) {
+	if ((substitution.getFactor() != 1 && substitution.getFactor() != -1) || !substitution.appliesTo(reference)) {
+		return {};
+	}
+
+	IndexList permuted = reference;
+	substitution.apply(permuted);
+
+	SlotPermutation permutation(reference.size(), substitution.getFactor() == 1 ? 1 : -1);
+	boost::container::small_vector< bool, 12 > used(reference.size(), false);
+
+	for (std::size_t i = 0; i < permuted.size(); ++i) {
+		// Substitutions preserve the type of the index in every slot, so the type is irrelevant here
+		auto it = std::find_if(reference.begin(), reference.end(),
+							   [&](const Index &current) { return Index::isSame(current, permuted[i]); });
+
+		if (it == reference.end()) {
+			return {};
+		}
+
+		const std::size_t slot = std::distance(reference.begin(), it);
+
+		if (used[slot]) {
+			// The reference contains this index multiple times
+			return {};
+		}
+
+		used[slot]              = true;
+		permutation.m_images[i] = static_cast< slot_t >(slot);
+	}
+
+	return permutation;
+}
+
+IndexSubstitution SlotPermutation::toSubstitution(const IndexList &reference) const {
+	assert(reference.size() == m_images.size());
+
+	IndexSubstitution::substitution_list substitutions;
+	for (std::size_t i = 0; i < m_images.size(); ++i) {
+		if (m_images[i] != i) {
+			substitutions.push_back({ reference[i], reference[m_images[i]] });
+		}
+	}
+
+	return IndexSubstitution(std::move(substitutions), m_sign);
+}
+
+SlotPermutation operator*(const SlotPermutation &lhs, const SlotPermutation &rhs) {
+	assert(lhs.getRank() == rhs.getRank());
+
+	SlotPermutation product(rhs.getRank(), lhs.m_sign * rhs.m_sign);
+	for (std::size_t i = 0; i < rhs.m_images.size(); ++i) {
+		product.m_images[i] = lhs.m_images[rhs.m_images[i]];
+	}
+
+	return product;
+}
+
+std::ostream &operator<<(std::ostream &stream, const SlotPermutation &permutation) {
+	stream << "(";
+	for (std::size_t i = 0; i < permutation.getRank(); ++i) {
+		stream << permutation[i];
+
+		if (i + 1 < permutation.getRank()) {
+			stream << " ";
+		}
+	}
+
+	return stream << ") -> " << permutation.getSign();
+}
+
+SlotPermutation SlotPermutation::inverse() const {
+	SlotPermutation inverse(m_images.size(), m_sign);
+	for (std::size_t i = 0; i < m_images.size(); ++i) {
+		inverse.m_images[m_images[i]] = static_cast< slot_t >(i);
+	}
+
+	return inverse;
+}
+
+int SlotPermutation::apply(IndexList &indices) const {
+	assert(indices.size() == m_images.size());
+
+	const IndexList original = indices;
+	for (std::size_t i = 0; i < m_images.size(); ++i) {
+		indices[i] = original[m_images[i]];
+		indices[i].setType(original[i].getType());
+	}
+
+	return m_sign;
+}
+
+const SlotPermutation::slot_list_t &SlotPermutation::getImages() const {
+	return m_images;
+}
+
+int SlotPermutation::getSign() const {
+	return m_sign;
+}
+
+std::size_t SlotPermutation::getRank() const {
+	return m_images.size();
+}
+
+bool SlotPermutation::isIdentity() const {
+	if (m_sign != 1) {
+		return false;
+	}
+
+	for (std::size_t i = 0; i < m_images.size(); ++i) {
+		if (m_images[i] != i) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+}; // namespace Contractor::Terms
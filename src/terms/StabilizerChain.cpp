@@ -0,0 +1,325 @@
+#include "terms/StabilizerChain.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Contractor::Terms {
+
+StabilizerChain::permutation_t StabilizerChain::identity(std::size_t degree) {
+	permutation_t permutation(degree);
+	for (std::size_t i = 0; i < degree; ++i) {
+		permutation[i] = static_cast< point_t >(i);
+	}
+
+	return permutation;
+}
+
+StabilizerChain::permutation_t StabilizerChain::multiply(const permutation_t &lhs, const permutation_t &rhs) {
+	assert(lhs.size() == rhs.size());
+
+	permutation_t product(rhs.size());
+	for (std::size_t i = 0; i < rhs.size(); ++i) {
+		product[i] = lhs[rhs[i]];
+	}
+
+	return product;
+}
+
+StabilizerChain::permutation_t StabilizerChain::invert(const permutation_t &permutation) {
+	permutation_t inverse(permutation.size());
+	for (std::size_t i = 0; i < permutation.size(); ++i) {
+		inverse[permutation[i]] = static_cast< point_t >(i);
+	}
+
+	return inverse;
+}
+
+StabilizerChain::StabilizerChain(std::size_t degree) : m_degree(degree) {
+}
+
+bool StabilizerChain::addGenerator(const permutation_t &permutation) {
+	assert(permutation.size() == m_degree);
+
+	permutation_t residue   = permutation;
+	const std::size_t depth = sift(residue, 0);
+
+	if (depth == m_degree) {
+		return false;
+	}
+
+	m_strongGenerators.push_back({ std::move(residue), depth });
+
+	for (std::size_t i = 0; i <= depth; ++i) {
+		computeOrbit(i);
+	}
+
+	complete(depth);
+
+	return true;
+}
+
+bool StabilizerChain::contains(const permutation_t &permutation) const {
+	assert(permutation.size() == m_degree);
+
+	permutation_t residue = permutation;
+
+	return sift(residue, 0) == m_degree;
+}
+
+std::size_t StabilizerChain::order() const {
+	std::size_t order = 1;
+	for (const Level &currentLevel : m_levels) {
+		order *= currentLevel.orbit.size() + 1;
+	}
+
+	return order;
+}
+
+std::size_t StabilizerChain::getDegree() const {
+	return m_degree;
+}
+
+StabilizerChain::permutation_t
+	StabilizerChain::findMinimalElement(const std::function< bool(point_t, point_t) > &less) const {
+	return minimize(identity(m_degree), 0, less);
+}
+
+std::vector< StabilizerChain::permutation_t >
+	StabilizerChain::findMinimalElements(const std::function< std::uint64_t(const permutation_t &, std::size_t) > &value)
+		const {
+	// As in findMinimalElement, the elements agreeing with a given one on the first i base points are obtained by
+	// multiplying with the transversal elements of the i-th level. However, the smallest image can't be picked for
+	// every element on its own, as the values of the images depend on the previous choices. Thus all candidates of
+	// all elements that are still minimal are compared with one another.
+	std::vector< permutation_t > elements = { identity(m_degree) };
+
+	for (std::size_t level = 0; level < m_degree; ++level) {
+		std::vector< permutation_t > candidates;
+		std::uint64_t minimalValue = 0;
+
+		auto consider = [&](permutation_t candidate) {
+			const std::uint64_t currentValue = value(candidate, level);
+
+			if (candidates.empty() || currentValue < minimalValue) {
+				candidates.clear();
+				minimalValue = currentValue;
+			} else if (currentValue > minimalValue) {
+				return;
+			}
+
+			candidates.push_back(std::move(candidate));
+		};
+
+		for (const permutation_t &currentElement : elements) {
+			consider(currentElement);
+
+			if (level < m_levels.size()) {
+				for (const permutation_t &currentTransversal : m_levels[level].transversal) {
+					consider(multiply(currentElement, currentTransversal));
+				}
+			}
+		}
+
+		elements = std::move(candidates);
+	}
+
+	return elements;
+}
+
+std::vector< StabilizerChain::permutation_t > StabilizerChain::getCanonicalTransversals() const {
+	std::vector< permutation_t > transversals;
+
+	for (std::size_t level = 0; level < m_levels.size(); ++level) {
+		for (const permutation_t &currentTransversal : m_levels[level].transversal) {
+			// The coset u * G_{i+1} consists of all elements that map the i-th base point onto u(i)
+			transversals.push_back(minimize(currentTransversal, level + 1, std::less< point_t >{}));
+		}
+	}
+
+	std::sort(transversals.begin(), transversals.end());
+
+	return transversals;
+}
+
+void StabilizerChain::forEachElement(const std::function< void(const permutation_t &) > &callback) const {
+	// Every element can be written uniquely as a product u_0 * u_1 * ... of transversal elements of the levels. A
+	// choice of 0 stands for the identity and i > 0 for the transversal element of the (i - 1)-th orbit point.
+	const std::size_t levels = m_levels.size();
+	std::vector< std::size_t > choice(levels, 0);
+	std::vector< permutation_t > prefixes(levels + 1, identity(m_degree));
+
+	while (true) {
+		callback(prefixes[levels]);
+
+		// Advance to the next combination of transversal elements
+		std::size_t level = levels;
+		while (level > 0 && choice[level - 1] == m_levels[level - 1].orbit.size()) {
+			choice[level - 1] = 0;
+			--level;
+		}
+
+		if (level == 0) {
+			return;
+		}
+
+		choice[level - 1]++;
+
+		for (std::size_t i = level - 1; i < levels; ++i) {
+			prefixes[i + 1] =
+				choice[i] == 0 ? prefixes[i] : multiply(prefixes[i], m_levels[i].transversal[choice[i] - 1]);
+		}
+	}
+}
+
+void StabilizerChain::computeOrbit(std::size_t level) {
+	if (m_levels.size() <= level) {
+		m_levels.resize(level + 1);
+	}
+
+	Level &currentLevel     = m_levels[level];
+	const point_t basePoint = static_cast< point_t >(level);
+	const permutation_t id  = identity(m_degree);
+
+	currentLevel.orbit.clear();
+	currentLevel.transversal.clear();
+
+	// Breadth-first search starting at the base point (the 0-th point of the search)
+	for (std::size_t i = 0; i <= currentLevel.orbit.size(); ++i) {
+		const point_t currentPoint = i == 0 ? basePoint : currentLevel.orbit[i - 1];
+
+		for (const auto &currentGenerator : m_strongGenerators) {
+			if (currentGenerator.second < level) {
+				continue;
+			}
+
+			const point_t image = currentGenerator.first[currentPoint];
+
+			if (findTransversal(level, image, id) == nullptr) {
+				permutation_t element =
+					i == 0 ? currentGenerator.first : multiply(currentGenerator.first, currentLevel.transversal[i - 1]);
+
+				currentLevel.orbit.push_back(image);
+				currentLevel.transversal.push_back(std::move(element));
+			}
+		}
+	}
+}
+
+StabilizerChain::permutation_t StabilizerChain::minimize(permutation_t element, std::size_t startLevel,
+														 const std::function< bool(point_t, point_t) > &less) const {
+	// All elements that agree with element on the first i base points are given by element * G_i where G_i is the
+	// stabilizer of these points. These elements map the i-th base point onto element(p) for all p in the orbit of
+	// that point under G_i, so we can greedily pick the smallest such image. The remaining levels are trivial.
+	for (std::size_t level = startLevel; level < m_levels.size(); ++level) {
+		const Level &currentLevel = m_levels[level];
+
+		std::size_t best = currentLevel.orbit.size();
+		for (std::size_t i = 0; i < currentLevel.orbit.size(); ++i) {
+			const point_t bestPoint = best < currentLevel.orbit.size() ? currentLevel.orbit[best] : level;
+
+			if (less(element[currentLevel.orbit[i]], element[bestPoint])) {
+				best = i;
+			}
+		}
+
+		if (best < currentLevel.orbit.size()) {
+			element = multiply(element, currentLevel.transversal[best]);
+		}
+	}
+
+	return element;
+}
+
+const StabilizerChain::permutation_t *
+	StabilizerChain::findTransversal(std::size_t level, point_t point, const permutation_t &identity) const {
+	if (point == level) {
+		return &identity;
+	}
+
+	if (level >= m_levels.size()) {
+		return nullptr;
+	}
+
+	const Level &currentLevel = m_levels[level];
+
+	for (std::size_t i = 0; i < currentLevel.orbit.size(); ++i) {
+		if (currentLevel.orbit[i] == point) {
+			return &currentLevel.transversal[i];
+		}
+	}
+
+	return nullptr;
+}
+
+std::size_t StabilizerChain::sift(permutation_t &permutation, std::size_t startLevel) const {
+	const permutation_t id = identity(m_degree);
+
+	for (std::size_t level = startLevel; level < m_degree; ++level) {
+		const point_t image = permutation[level];
+
+		if (image == level) {
+			continue;
+		}
+
+		const permutation_t *transversal = findTransversal(level, image, id);
+
+		if (transversal == nullptr) {
+			return level;
+		}
+
+		permutation = multiply(invert(*transversal), permutation);
+	}
+
+	return m_degree;
+}
+
+void StabilizerChain::complete(std::size_t startLevel) {
+	// The deterministic Schreier-Sims algorithm: the strong generating set is complete if all Schreier generators
+	// of every level can be sifted through the levels below it. If one can't, its residue is added as a new strong
+	// generator and the levels it affects are checked again.
+	const permutation_t id = identity(m_degree);
+	std::size_t level      = startLevel + 1;
+
+	while (level > 0) {
+		const std::size_t currentLevel = level - 1;
+		const point_t basePoint        = static_cast< point_t >(currentLevel);
+		bool extended                  = false;
+
+		for (std::size_t i = 0; i <= m_levels[currentLevel].orbit.size() && !extended; ++i) {
+			const point_t currentPoint = i == 0 ? basePoint : m_levels[currentLevel].orbit[i - 1];
+
+			for (std::size_t j = 0; j < m_strongGenerators.size(); ++j) {
+				if (m_strongGenerators[j].second < currentLevel) {
+					continue;
+				}
+
+				const permutation_t &generator = m_strongGenerators[j].first;
+
+				// The Schreier generator u_{g(p)}^-1 * g * u_p fixes the base point of the current level
+				permutation_t schreierGenerator =
+					multiply(invert(*findTransversal(currentLevel, generator[currentPoint], id)),
+							 multiply(generator, *findTransversal(currentLevel, currentPoint, id)));
+
+				const std::size_t depth = sift(schreierGenerator, currentLevel + 1);
+
+				if (depth < m_degree) {
+					m_strongGenerators.push_back({ std::move(schreierGenerator), depth });
+
+					for (std::size_t k = currentLevel + 1; k <= depth; ++k) {
+						computeOrbit(k);
+					}
+
+					level    = depth + 1;
+					extended = true;
+					break;
+				}
+			}
+		}
+
+		if (!extended) {
+			--level;
+		}
+	}
+}
+
+}; // namespace Contractor::Terms
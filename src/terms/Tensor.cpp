@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <stdexcept>
 
 #include <boost/range/join.hpp>
 
@@ -44,6 +45,10 @@ Tensor::Tensor(const std::string_view name, Tensor::index_list_t &&indices, Perm
 }
 
 bool operator==(const Tensor &lhs, const Tensor &rhs) {
+	if (lhs.getHash() != rhs.getHash()) {
+		return false;
+	}
+
 	return lhs.m_name == rhs.m_name && lhs.m_symmetry == rhs.m_symmetry
 		   && lhs.m_symmetry.getCanonicalRepresentation() == rhs.m_symmetry.getCanonicalRepresentation()
 		   && lhs.m_symmetry.getCanonicalRepresentationFactor() == rhs.m_symmetry.getCanonicalRepresentationFactor();
@@ -54,8 +59,8 @@ bool operator!=(const Tensor &lhs, const Tensor &rhs) {
 }
 
 bool operator<(const Tensor &lhs, const Tensor &rhs) {
-	if (lhs.getName() != rhs.getName()) {
-		return lhs.getName() < rhs.getName();
+	if (lhs.m_name != rhs.m_name) {
+		return lhs.m_name < rhs.m_name;
 	}
 
 	if (lhs.getIndices().size() != rhs.getIndices().size()) {
@@ -87,30 +92,100 @@ const Tensor::index_list_t &Tensor::getIndices() const {
 	return m_indices;
 }
 
-Tensor::index_list_t &Tensor::getIndices() {
-	return m_indices;
+void Tensor::setIndices(index_list_t indices, PermutationGroup symmetry) {
+	assert(symmetry.contains(indices));
+
+	m_indices  = std::move(indices);
+	m_symmetry = std::move(symmetry);
+
+	updateHashes();
 }
 
 const std::string_view Tensor::getName() const {
+	return m_name.str();
+}
+
+const TensorName &Tensor::getInternedName() const {
 	return m_name;
 }
 
 void Tensor::setName(const std::string_view &name) {
+	m_name = TensorName(name);
+
+	updateHashes();
+}
+
+void Tensor::setName(const TensorName &name) {
 	m_name = name;
+
+	updateHashes();
 }
 
 const PermutationGroup &Tensor::getSymmetry() const {
 	return m_symmetry;
 }
 
-PermutationGroup &Tensor::accessSymmetry() {
-	return m_symmetry;
+Tensor::SymmetryAccess Tensor::accessSymmetry() {
+	return SymmetryAccess(*this);
 }
 
 void Tensor::setSymmetry(const PermutationGroup &symmetry) {
 	assert(symmetry.contains(m_indices));
 
 	m_symmetry = symmetry;
+
+	updateHashes();
+}
+
+void Tensor::updateHashes() {
+	m_hash        = computeHash();
+	m_elementHash = computeElementHash();
+}
+
+std::size_t Tensor::getHash() const {
+	// A mismatch means that a modification of this Tensor didn't call updateHashes
+	assert(m_hash == computeHash());
+
+	return m_hash;
+}
+
+std::size_t Tensor::getElementHash() const {
+	assert(m_elementHash == computeElementHash());
+
+	return m_elementHash;
+}
+
+std::size_t Tensor::computeHash() const {
+	std::size_t hash = 0;
+	for (std::size_t i = 0; i < m_indices.size(); ++i) {
+		// Include the position of the index in order to ensure that a different index sequence will result
+		// in a different hash value. In order for symmetry-equivalent tensors to arrive at the same hash,
+		// we use the "canonical" index sequence for this Tensor
+		hash += std::hash< Index >{}(m_symmetry.getCanonicalRepresentation()[i]) ^ std::hash< std::size_t >{}(i);
+	}
+
+	hash ^= m_name.hash() << 1;
+	hash ^= std::hash< PermutationGroup >{}(m_symmetry) << 2;
+
+	return hash;
+}
+
+std::size_t Tensor::computeElementHash() const {
+	std::size_t hash = 0;
+	for (std::size_t i = 0; i < m_indices.size(); ++i) {
+		// Include the position of the index in order to ensure that a different index sequence will result
+		// in a different hash value. In order for symmetry-equivalent tensors to arrive at the same hash,
+		// we use the "canonical" index sequence for this Tensor
+		const Index &currentIndex = m_symmetry.getCanonicalRepresentation()[i];
+		// We only care about an Index's space and spin as the explicit name is not important for the tensor
+		// element
+		hash += (std::hash< IndexSpace >{}(currentIndex.getSpace()) << 0)
+				^ (std::hash< Index::Spin >{}(currentIndex.getSpin()) << 1) ^ std::hash< std::size_t >{}(i);
+	}
+
+	hash ^= m_name.hash() << 1;
+
+	return hash;
 }
 
 int Tensor::getS() const {
@@ -250,7 +325,11 @@ bool Tensor::hasPartialColumnSymmetry() const {
 }
 
 bool Tensor::refersToSameElement(const Tensor &other, bool accountForSymmetry) const {
-	if (m_indices.size() != other.m_indices.size() || getName() != other.getName()) {
+	if (m_indices.size() != other.m_indices.size() || m_name != other.m_name) {
+		return false;
+	}
+	if (accountForSymmetry && getElementHash() != other.getElementHash()) {
+		// Tensors referring to the same element have the same element hash
 		return false;
 	}
 	if (accountForSymmetry && (m_symmetry.size() != other.getSymmetry().size())) {
@@ -329,7 +408,7 @@ ContractionResult Tensor::contract(const Tensor &other, const Utils::IndexSpaceR
 	ContractionResult result;
 	result.cost = 1;
 
-	std::vector< Index > contractedIndices;
+	IndexList contractedIndices;
 	Tensor::index_list_t resultIndices;
 
 	for (const Index &currentIndex : m_indices) {
@@ -364,19 +443,6 @@ ContractionResult Tensor::contract(const Tensor &other, const Utils::IndexSpaceR
 		}
 	}
 
-	// Auto-generate the name in such a way that it will result in the same name regardless of the order
-	// of the contraction. In order to achieve that, we sort the name parts alphabetically.
-	std::string resultName;
-	if (getName().compare(other.getName()) > 0) {
-		resultName.append(other.getName());
-		resultName.append("_");
-		resultName.append(getName());
-	} else {
-		resultName.append(getName());
-		resultName.append("_");
-		resultName.append(other.getName());
-	}
-
 	// Until here we have computed the cost of evaluating a single element in the
 	// result Tensor. However for the total operation cost we now also have to figure
 	// out how expensive it is to compute all entries in the result tensor
@@ -386,16 +452,21 @@ ContractionResult Tensor::contract(const Tensor &other, const Utils::IndexSpaceR
 		result.cost *= resolver.getMeta(currentResultIndex.getSpace()).getSize();
 	}
 
-	result.resultTensor = Tensor(resultName, std::move(resultIndices));
+	result.resultTensor = Tensor(std::string_view(), std::move(resultIndices));
+	// Auto-generate the name in such a way that it will result in the same name regardless of the order
+	// of the contraction
+	result.resultTensor.setName(TensorName::join(m_name, other.m_name));
 
 	// As a final step we want to figure out whether any of the index symmetries from the original Tensors still apply
 	// to the result Tensor.
 	// Note that the indices in the result are the same as in the Tensors it consists of. There is also no ambiguity for
 	// where each index came from since indices that occur in both Tensors are being contracted and thus no longer
 	// show in the result Tensor.
+	const std::vector< IndexSubstitution > generators      = m_symmetry.getGenerators();
+	const std::vector< IndexSubstitution > otherGenerators = other.getSymmetry().getGenerators();
+
 	PermutationGroup resultSymmetry(result.resultTensor.getIndices());
-	for (const IndexSubstitution &currentSymmetry :
-		 boost::join(m_symmetry.getGenerators(), other.getSymmetry().getGenerators())) {
+	for (const IndexSubstitution &currentSymmetry : boost::join(generators, otherGenerators)) {
 		if (currentSymmetry.appliesTo(result.resultTensor)) {
 			resultSymmetry.addGenerator(currentSymmetry, false);
 		}
@@ -408,6 +479,43 @@ ContractionResult Tensor::contract(const Tensor &other, const Utils::IndexSpaceR
 	return result;
 }
 
+ContractionResult::cost_t Tensor::getSymmetryReducedCost(const Tensor &other, const ContractionResult &result) const {
+	IndexList contractedIndices;
+	for (const Index &currentIndex : m_indices) {
+		if (std::any_of(other.m_indices.begin(), other.m_indices.end(),
+						[&currentIndex](const Index &other) { return Index::isSame(currentIndex, other); })) {
+			contractedIndices.push_back(currentIndex);
+		}
+	}
+
+	// Permutations of the contracted indices with respect to which both Tensors have the same symmetry lead to
+	// equivalent contributions to the sum, so that only one of them has to be evaluated. These permutations form the
+	// intersection of both symmetry groups (restricted to the contracted indices), which is found among the elements of
+	// the smaller group.
+	const PermutationGroup &smallerGroup = m_symmetry.size() <= other.m_symmetry.size() ? m_symmetry : other.m_symmetry;
+	const PermutationGroup &biggerGroup  = &smallerGroup == &m_symmetry ? other.m_symmetry : m_symmetry;
+
+	// The identity is always part of the intersection
+	std::size_t contractionSymmetrySize = 1;
+	auto countCommonOperation           = [&](const IndexSubstitution &currentOperation) {
+		if (!currentOperation.isIdentity() && currentOperation.appliesTo(contractedIndices)
+			&& biggerGroup.contains(currentOperation)) {
+			contractionSymmetrySize++;
+		}
+	};
+
+	for (const IndexSubstitution &currentOperation : smallerGroup.getGenerators()) {
+		countCommonOperation(currentOperation);
+	}
+	for (const IndexSubstitution &currentOperation : smallerGroup.getAdditionalSymmetryOperations()) {
+		countCommonOperation(currentOperation);
+	}
+
+	// Every symmetry-unique element of the result stands for as many elements as there are operations in its symmetry
+	// group (and the same goes for the summation)
+	return result.cost / (result.resultTensor.getSymmetry().size() * contractionSymmetrySize);
+}
+
 bool canonical_index_less(const Index &lhs, const Index &rhs) {
 	return lhs.getType() < rhs.getType();
 }
@@ -416,6 +524,8 @@ void Tensor::sortIndices() {
 	std::stable_sort(m_indices.begin(), m_indices.end(), canonical_index_less);
 
 	m_symmetry.setRootSequence(m_indices);
+
+	updateHashes();
 }
 
 bool Tensor::hasCanonicalIndexSequence() const {
@@ -427,6 +537,8 @@ int Tensor::canonicalizeIndices() {
 		return 1;
 	}
 
+	// Indices that can be reached by means of the symmetry have the same canonical representation and thus the
+	// hashes remain valid
 	m_indices = m_symmetry.getCanonicalRepresentation();
 
 	int factor = m_symmetry.getCanonicalRepresentationFactor();
@@ -436,5 +548,20 @@ int Tensor::canonicalizeIndices() {
 	return factor;
 }
 
+int Tensor::setIndexSequence(const index_list_t &sequence) {
+	const std::optional< int > factor = m_symmetry.getFactor(sequence);
+
+	if (!factor) {
+		throw std::invalid_argument("The given index sequence can't be reached by means of the Tensor's symmetry");
+	}
+
+	// As the new sequence is reachable by means of the symmetry, the hashes remain valid
+	m_indices = sequence;
+
+	m_symmetry.setRootSequence(m_indices);
+
+	return *factor;
+}
+
 
 }; // namespace Contractor::Terms
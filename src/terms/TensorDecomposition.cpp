@@ -4,7 +4,6 @@
 
 #include <algorithm>
 #include <cassert>
-#include <limits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -104,7 +103,7 @@ GeneralTerm makeIndicesUnique(const GeneralTerm &substitution, const Term &term)
 		// Keep increasing the ID until there is no index in this space that already uses this ID
 		Index::id_t newID = 0;
 		while (indexIDs.find(newID) != indexIDs.end()) {
-			assert(newID < std::numeric_limits< Index::id_t >::max() - 1);
+			assert(newID < Index::maxID);
 			newID++;
 		}
 
@@ -0,0 +1,115 @@
+#include "terms/TensorName.hpp"
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace Contractor::Terms {
+
+struct TensorName::Table {
+	struct pair_hash {
+		std::size_t operator()(const std::pair< const Entry *, const Entry * > &pair) const {
+			return std::hash< const Entry * >{}(pair.first) ^ (std::hash< const Entry * >{}(pair.second) << 1);
+		}
+	};
+
+	using join_cache_t = std::unordered_map< std::pair< const Entry *, const Entry * >, const Entry *, pair_hash >;
+
+	std::shared_mutex mutex;
+	/**
+	 * All interned names. The keys are views on the names stored in the (heap-allocated and thus stable) entries.
+	 */
+	std::unordered_map< std::string_view, std::unique_ptr< const Entry > > entries;
+	/**
+	 * The names obtained by joining pairs of names
+	 */
+	join_cache_t joinedNames;
+};
+
+TensorName::TensorName(std::string_view name) : m_entry(intern(name)) {
+}
+
+TensorName TensorName::join(const TensorName &lhs, const TensorName &rhs) {
+	const std::pair< const Entry *, const Entry * > key(lhs.m_entry, rhs.m_entry);
+
+	// Every thread keeps its own copy of the joined names it has used before, so that the shared table (and its lock)
+	// is only accessed for new pairs of names
+	thread_local Table::join_cache_t localCache;
+
+	auto localIt = localCache.find(key);
+	if (localIt != localCache.end()) {
+		return TensorName(localIt->second);
+	}
+
+	Table &table = getTable();
+	const Entry *joined;
+	{
+		std::shared_lock< std::shared_mutex > lock(table.mutex);
+
+		auto it = table.joinedNames.find(key);
+		joined  = it != table.joinedNames.end() ? it->second : nullptr;
+	}
+
+	if (!joined) {
+		const bool swap = lhs.str().compare(rhs.str()) > 0;
+
+		std::string name(swap ? rhs.str() : lhs.str());
+		name.append("_");
+		name.append(swap ? lhs.str() : rhs.str());
+
+		joined = intern(name);
+
+		std::unique_lock< std::shared_mutex > lock(table.mutex);
+		table.joinedNames.emplace(key, joined);
+	}
+
+	localCache.emplace(key, joined);
+
+	return TensorName(joined);
+}
+
+TensorName::Table &TensorName::getTable() {
+	static Table table;
+
+	return table;
+}
+
+const TensorName::Entry *TensorName::getEmptyEntry() {
+	static const Entry emptyEntry("");
+
+	return &emptyEntry;
+}
+
+const TensorName::Entry *TensorName::intern(std::string_view name) {
+	if (name.empty()) {
+		// Default-constructed names are very common, so we don't want them to go through the table
+		return getEmptyEntry();
+	}
+
+	Table &table = getTable();
+	{
+		std::shared_lock< std::shared_mutex > lock(table.mutex);
+
+		auto it = table.entries.find(name);
+		if (it != table.entries.end()) {
+			return it->second.get();
+		}
+	}
+
+	std::unique_lock< std::shared_mutex > lock(table.mutex);
+
+	// Another thread might have inserted the name in the meantime
+	auto it = table.entries.find(name);
+	if (it == table.entries.end()) {
+		std::unique_ptr< const Entry > entry = std::make_unique< const Entry >(name);
+		const std::string_view key           = entry->name;
+
+		it = table.entries.emplace(key, std::move(entry)).first;
+	}
+
+	return it->second.get();
+}
+
+}; // namespace Contractor::Terms
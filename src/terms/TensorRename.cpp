@@ -19,7 +19,8 @@ TensorRename::TensorRename(Tensor &&tensor, std::string &&newName)
 }
 
 bool TensorRename::appliesTo(const Tensor &tensor) const {
-	if (m_tensor.getName() != tensor.getName() || m_tensor.getIndices().size() != tensor.getIndices().size()) {
+	if (m_tensor.getInternedName() != tensor.getInternedName()
+		|| m_tensor.getIndices().size() != tensor.getIndices().size()) {
 		return false;
 	}
 
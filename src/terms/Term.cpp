@@ -68,28 +68,12 @@ void Term::setPrefactor(Term::factor_t prefactor) {
 	m_prefactor = prefactor;
 }
 
-Iterable< const Tensor > Term::getTensors() const {
-	// Get a function pointer to UnoptimizedTerm::get with which we can create the Iterable object that is to
-	// be returned. Note that thanks to that get function not being overloaded, we don't have to perform any
-	// overload resolution with evil looking casts :)
-	typedef const Tensor &(Term::*const_getter_t)(std::size_t) const;
-
-	std::function< const Tensor &(std::size_t) > getterFunction =
-		std::bind(static_cast< const_getter_t >(&Term::get), this, std::placeholders::_1);
-
-	return Iterable< const Tensor >(0, size(), getterFunction, this);
+Span< const Tensor > Term::getTensors() const {
+	return getTensorStorage();
 }
 
-Iterable< Tensor > Term::accessTensors() {
-	// Get a function pointer to UnoptimizedTerm::get with which we can create the Iterable object that is to
-	// be returned. Note that thanks to that get function not being overloaded, we don't have to perform any
-	// overload resolution with evil looking casts :)
-	typedef Tensor &(Term::*getter_t)(std::size_t);
-
-	std::function< Tensor &(std::size_t) > getterFunction =
-		std::bind(static_cast< getter_t >(&Term::get), this, std::placeholders::_1);
-
-	return Iterable< Tensor >(0, size(), getterFunction, this);
+Span< Tensor > Term::accessTensors() {
+	return accessTensorStorage();
 }
 
 bool Term::equals(const Term &other, std::underlying_type_t< CompareOption::Options > options) const {
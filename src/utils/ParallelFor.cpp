@@ -0,0 +1,68 @@
+#include "utils/ParallelFor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Contractor::Utils {
+
+void parallelFor(std::size_t count, std::size_t jobs,
+				 const std::function< void(std::size_t index, std::size_t threadIndex) > &function) {
+	if (jobs <= 1 || count <= 1) {
+		for (std::size_t i = 0; i < count; ++i) {
+			function(i, 0);
+		}
+
+		return;
+	}
+
+	std::atomic< std::size_t > nextIndex(0);
+	std::atomic< bool > aborted(false);
+	std::exception_ptr firstException;
+	std::mutex exceptionMutex;
+
+	auto worker = [&](std::size_t threadIndex) {
+		while (!aborted) {
+			std::size_t currentIndex = nextIndex++;
+
+			if (currentIndex >= count) {
+				return;
+			}
+
+			try {
+				function(currentIndex, threadIndex);
+			} catch (...) {
+				std::lock_guard< std::mutex > guard(exceptionMutex);
+
+				if (!firstException) {
+					firstException = std::current_exception();
+				}
+
+				aborted = true;
+			}
+		}
+	};
+
+	std::vector< std::thread > threads;
+	threads.reserve(std::min(jobs, count) - 1);
+
+	for (std::size_t i = 1; i < std::min(jobs, count); ++i) {
+		threads.emplace_back(worker, i);
+	}
+
+	// The calling thread also takes part in processing the work items
+	worker(0);
+
+	for (std::thread &currentThread : threads) {
+		currentThread.join();
+	}
+
+	if (firstException) {
+		std::rethrow_exception(firstException);
+	}
+}
+
+}; // namespace Contractor::Utils
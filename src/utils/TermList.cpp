@@ -113,7 +113,7 @@ void TermList::sortTerms() {
 	std::size_t iterations   = 0;
 
 	while (currentIndex < m_terms.size()) {
-		Iterable< const ct::Tensor > refTensors = m_terms[currentIndex]->getTensors();
+		Span< const ct::Tensor > refTensors = m_terms[currentIndex]->getTensors();
 
 		bool swapped = false;
 		for (std::size_t i = currentIndex + 1; i < m_terms.size(); ++i) {
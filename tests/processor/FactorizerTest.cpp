@@ -1,4 +1,5 @@
 #include "processor/Factorizer.hpp"
+#include "processor/LayoutCost.hpp"
 #include "processor/Simplifier.hpp"
 #include "terms/BinaryTerm.hpp"
 #include "terms/GeneralTerm.hpp"
@@ -8,6 +9,10 @@
 
 #include "IndexHelper.hpp"
 
+#include <regex>
+#include <sstream>
+#include <string>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -44,17 +49,17 @@ TEST(FactorizerTest, factorize) {
 
 		ct::Tensor resultTensor("LCCD");
 
-		ct::Tensor intermediateResult1("H_T", { ct::Index(l), ct::Index(i) });
-		ct::Tensor intermediateResult2("T_T", { ct::Index(i), ct::Index(l) });
+		ct::Tensor intermediateResult1("H_T", { ct::Index(i), ct::Index(l) });
+		ct::Tensor intermediateResult2("T_T", { ct::Index(l), ct::Index(i) });
 
 		ct::ContractionResult::cost_t expectedContractionCost = 0;
-		// T_T[il] = T[ikdc] T[cdlk]    N_o^3 N_v^2
+		// T_T[li] = T[ikdc] T[cdlk]    N_o^3 N_v^2
 		ct::BinaryTerm intermdediate1(intermediateResult2, 1.0, ct::Tensor(tensors[0]), ct::Tensor(tensors[3]));
 		expectedContractionCost += pow(occupiedSize, 3) * pow(virtualSize, 2);
-		// H_T[li] = H[jlba] T[abji]    N_o^3 N_v^2
+		// H_T[il] = H[jlba] T[abji]    N_o^3 N_v^2
 		ct::BinaryTerm intermdediate2(intermediateResult1, 1.0, ct::Tensor(tensors[1]), ct::Tensor(tensors[2]));
 		expectedContractionCost += pow(occupiedSize, 3) * pow(virtualSize, 2);
-		// LCCD[] = H_T[li] T_T[il]    N_o^2
+		// LCCD[] = H_T[il] T_T[li]    N_o^2
 		ct::BinaryTerm expectedResult(resultTensor, 2.0, ct::Tensor(intermediateResult1),
 									  ct::Tensor(intermediateResult2));
 		expectedContractionCost += pow(occupiedSize, 2);
@@ -145,7 +150,7 @@ TEST(FactorizerTest, factorize) {
 		// result indices)
 
 		ct::ContractionResult::cost_t expectedCost = 0;
-		ct::Tensor intermediate("G_T", { idx("k"), idx("l"), idx("i"), idx("j") });
+		ct::Tensor intermediate("G_T", { idx("i"), idx("j"), idx("k"), idx("l") });
 		expectedCost += static_cast< int >(std::pow(resolver.getMeta(idx("i").getSpace()).getSize(), 4))
 						* static_cast< int >(std::pow(resolver.getMeta(idx("a").getSpace()).getSize(), 2));
 		ct::BinaryTerm intermediateTerm(ct::Tensor(intermediate), 1.0, ct::Tensor(G), ct::Tensor(T2));
@@ -228,7 +233,7 @@ TEST(FactorizerTest, resultTensorCollisions) {
 								   ct::Tensor(T2),
 							   });
 
-		ct::Tensor intermediate("G_T", { idx("k"), idx("l"), idx("i"), idx("j") });
+		ct::Tensor intermediate("G_T", { idx("i"), idx("j"), idx("k"), idx("l") });
 		ct::BinaryTerm intermediateTerm(ct::Tensor(intermediate), 1.0, ct::Tensor(G), ct::Tensor(T2));
 		ct::BinaryTerm result(ct::Tensor(O), 1.0, ct::Tensor(intermediate), ct::Tensor(T1));
 
@@ -262,8 +267,8 @@ TEST(FactorizerTest, resultTensorCollisions) {
 								   ct::Tensor(T2),
 							   });
 
-		ct::Tensor originalIntermediate("G_T", { idx("k"), idx("l"), idx("i"), idx("j") });
-		ct::Tensor intermediate("G_T'", { idx("k"), idx("l"), idx("i"), idx("j") });
+		ct::Tensor originalIntermediate("G_T", { idx("i"), idx("j"), idx("k"), idx("l") });
+		ct::Tensor intermediate("G_T'", { idx("i"), idx("j"), idx("k"), idx("l") });
 		ct::BinaryTerm intermediateTerm(ct::Tensor(intermediate), 1.0, ct::Tensor(G), ct::Tensor(T2));
 		ct::BinaryTerm result(ct::Tensor(O), 1.0, ct::Tensor(intermediate), ct::Tensor(T1));
 
@@ -287,3 +292,710 @@ TEST(FactorizerTest, resultTensorCollisions) {
 		ASSERT_THAT(factorizedTerms, ::testing::UnorderedElementsAre(intermediateTerm, result));
 	}
 }
+
+TEST(FactorizerTest, dynamicProgrammingEngine) {
+	cp::Factorizer exhaustiveFactorizer(resolver, cp::Factorizer::Engine::Exhaustive);
+	cp::Factorizer dpFactorizer(resolver, cp::Factorizer::Engine::DynamicProgramming);
+
+	ASSERT_EQ(exhaustiveFactorizer.getEngine(), cp::Factorizer::Engine::Exhaustive);
+	ASSERT_EQ(dpFactorizer.getEngine(), cp::Factorizer::Engine::DynamicProgramming);
+
+	std::vector< ct::GeneralTerm > terms = {
+		// T[a] = 2 * H[a]
+		ct::GeneralTerm(ct::Tensor("O", { idx("a+"), idx("i") }), 2.0,
+						{ ct::Tensor("H", { idx("a+"), idx("i") }) }),
+		// LCCD[] = T[ikdc] H[jlba] T[abji] T[cdlk]
+		ct::GeneralTerm(ct::Tensor("LCCD"), 2.0,
+						{ ct::Tensor("T", { idx("i+"), idx("k+"), idx("d"), idx("c") }),
+						  ct::Tensor("H", { idx("j+"), idx("l+"), idx("b"), idx("a") }),
+						  ct::Tensor("T", { idx("a+"), idx("b+"), idx("j"), idx("i") }),
+						  ct::Tensor("T", { idx("c+"), idx("d+"), idx("l"), idx("k") }) }),
+		// O[a⁺b⁺i⁻j⁻] += 0.5 * B[k⁺d⁻qⁿ] * B[l⁺c⁻qⁿ] * T[c⁺d⁺k⁻i⁻] * T[a⁺b⁺l⁻j⁻]
+		ct::GeneralTerm(ct::Tensor("O", { idx("a+"), idx("b+"), idx("i"), idx("j") }), 0.5,
+						{ ct::Tensor("B", { idx("k+"), idx("d"), idx("q!") }),
+						  ct::Tensor("B", { idx("l+"), idx("c"), idx("q!") }),
+						  ct::Tensor("T", { idx("c+"), idx("d+"), idx("k"), idx("i") }),
+						  ct::Tensor("T", { idx("a+"), idx("b+"), idx("l"), idx("j") }) }),
+		// O[a⁺b⁺i⁻j⁻] += H[k⁺l⁺c⁻d⁻] T[c⁺k⁻] T[d⁺l⁻] T[a⁺i⁻] T[b⁺j⁻]
+		ct::GeneralTerm(ct::Tensor("O", { idx("a+"), idx("b+"), idx("i"), idx("j") }), 1.0,
+						{ ct::Tensor("H", { idx("k+"), idx("l+"), idx("c"), idx("d") }),
+						  ct::Tensor("T", { idx("c+"), idx("k") }), ct::Tensor("T", { idx("d+"), idx("l") }),
+						  ct::Tensor("T", { idx("a+"), idx("i") }), ct::Tensor("T", { idx("b+"), idx("j") }) }),
+		// Completely equivalent contraction orders -> the tie has to be broken the same way as in the exhaustive search
+		ct::GeneralTerm(ct::Tensor("O", { idx("a+"), idx("i") }), 1.0,
+						{ ct::Tensor("T", { idx("a+"), idx("j") }), ct::Tensor("T", { idx("b+"), idx("i") }),
+						  ct::Tensor("F", { idx("j+"), idx("b") }) }),
+	};
+
+	for (const ct::GeneralTerm &currentTerm : terms) {
+		std::vector< ct::BinaryTerm > producedTerms;
+
+		for (int iteration = 0; iteration < 2; ++iteration) {
+			// The second iteration makes sure that the name clash avoidance also works the same in both engines
+			std::vector< ct::BinaryTerm > expected = exhaustiveFactorizer.factorize(currentTerm, producedTerms);
+			std::vector< ct::BinaryTerm > actual   = dpFactorizer.factorize(currentTerm, producedTerms);
+
+			ASSERT_EQ(actual, expected);
+			ASSERT_EQ(dpFactorizer.getLastFactorizationCost(), exhaustiveFactorizer.getLastFactorizationCost());
+			ASSERT_EQ(dpFactorizer.getLastBiggestIntermediateSize(),
+					  exhaustiveFactorizer.getLastBiggestIntermediateSize());
+
+			producedTerms.insert(producedTerms.end(), expected.begin(), expected.end());
+		}
+	}
+}
+
+TEST(FactorizerTest, searchStatistics) {
+	cp::Factorizer factorizer(resolver);
+
+	// O[a⁺b⁺i⁻j⁻] += H[k⁺l⁺c⁻d⁻] T[c⁺k⁻] T[d⁺l⁻] T[a⁺i⁻] T[b⁺j⁻]
+	ct::GeneralTerm term(ct::Tensor("O", { idx("a+"), idx("b+"), idx("i"), idx("j") }), 1.0,
+						 { ct::Tensor("H", { idx("k+"), idx("l+"), idx("c"), idx("d") }),
+						   ct::Tensor("T", { idx("c+"), idx("k") }), ct::Tensor("T", { idx("d+"), idx("l") }),
+						   ct::Tensor("T", { idx("a+"), idx("i") }), ct::Tensor("T", { idx("b+"), idx("j") }) });
+
+	factorizer.factorize(term);
+
+	// Without any pruning, 10 * 6 * 3 * 1 contraction sequences (plus their partial sequences) would be explored
+	ASSERT_GT(factorizer.getLastSearchStatistics().expandedNodes, 0);
+	ASSERT_GT(factorizer.getLastSearchStatistics().prunedNodes, 0);
+	ASSERT_LT(factorizer.getLastSearchStatistics().expandedNodes, 10 + 10 * 6 + 10 * 6 * 3 + 10 * 6 * 3 * 1);
+
+	// A single Tensor can't be factorized any further -> there is nothing to search
+	factorizer.factorize(ct::GeneralTerm(ct::Tensor("O", { idx("a+"), idx("i") }), 2.0,
+										 { ct::Tensor("H", { idx("a+"), idx("i") }) }));
+
+	ASSERT_EQ(factorizer.getLastSearchStatistics().expandedNodes, 0);
+	ASSERT_EQ(factorizer.getLastSearchStatistics().prunedNodes, 0);
+}
+
+TEST(FactorizerTest, concurrentSearch) {
+	cp::Factorizer serialFactorizer(resolver);
+	cp::Factorizer concurrentFactorizer(resolver);
+	concurrentFactorizer.setJobs(4);
+
+	ASSERT_EQ(serialFactorizer.getJobs(), 1);
+	ASSERT_EQ(concurrentFactorizer.getJobs(), 4);
+
+	std::vector< ct::GeneralTerm > terms = {
+		// LCCD[] = T[ikdc] H[jlba] T[abji] T[cdlk]
+		ct::GeneralTerm(ct::Tensor("LCCD"), 2.0,
+						{ ct::Tensor("T", { idx("i+"), idx("k+"), idx("d"), idx("c") }),
+						  ct::Tensor("H", { idx("j+"), idx("l+"), idx("b"), idx("a") }),
+						  ct::Tensor("T", { idx("a+"), idx("b+"), idx("j"), idx("i") }),
+						  ct::Tensor("T", { idx("c+"), idx("d+"), idx("l"), idx("k") }) }),
+		// O[a⁺b⁺i⁻j⁻] += H[k⁺l⁺c⁻d⁻] T[c⁺k⁻] T[d⁺l⁻] T[a⁺i⁻] T[b⁺j⁻]
+		ct::GeneralTerm(ct::Tensor("O", { idx("a+"), idx("b+"), idx("i"), idx("j") }), 1.0,
+						{ ct::Tensor("H", { idx("k+"), idx("l+"), idx("c"), idx("d") }),
+						  ct::Tensor("T", { idx("c+"), idx("k") }), ct::Tensor("T", { idx("d+"), idx("l") }),
+						  ct::Tensor("T", { idx("a+"), idx("i") }), ct::Tensor("T", { idx("b+"), idx("j") }) }),
+		// Many equivalent contraction orders -> the tie has to be broken the same way as in the serial search
+		ct::GeneralTerm(ct::Tensor("O", { idx("a+"), idx("i") }), 1.0,
+						{ ct::Tensor("T", { idx("a+"), idx("j") }), ct::Tensor("F", { idx("j+"), idx("k") }),
+						  ct::Tensor("F", { idx("k+"), idx("l") }), ct::Tensor("T", { idx("l+"), idx("i") }) }),
+	};
+
+	for (const ct::GeneralTerm &currentTerm : terms) {
+		std::vector< ct::BinaryTerm > producedTerms;
+
+		for (int iteration = 0; iteration < 2; ++iteration) {
+			std::vector< ct::BinaryTerm > expected = serialFactorizer.factorize(currentTerm, producedTerms);
+			std::vector< ct::BinaryTerm > actual   = concurrentFactorizer.factorize(currentTerm, producedTerms);
+
+			ASSERT_EQ(actual, expected);
+			ASSERT_EQ(concurrentFactorizer.getLastFactorizationCost(), serialFactorizer.getLastFactorizationCost());
+			ASSERT_EQ(concurrentFactorizer.getLastBiggestIntermediateSize(),
+					  serialFactorizer.getLastBiggestIntermediateSize());
+
+			producedTerms.insert(producedTerms.end(), expected.begin(), expected.end());
+		}
+	}
+}
+
+TEST(FactorizerTest, cache) {
+	cp::Factorizer factorizer(resolver);
+	cp::Factorizer uncachedFactorizer(resolver);
+
+	// O[a⁺b⁺i⁻j⁻] += H[k⁺l⁺c⁻d⁻] T[c⁺k⁻] T[d⁺l⁻] T[a⁺i⁻] T[b⁺j⁻]
+	ct::GeneralTerm term(ct::Tensor("O", { idx("a+"), idx("b+"), idx("i"), idx("j") }), 1.0,
+						 { ct::Tensor("H", { idx("k+"), idx("l+"), idx("c"), idx("d") }),
+						   ct::Tensor("T", { idx("c+"), idx("k") }), ct::Tensor("T", { idx("d+"), idx("l") }),
+						   ct::Tensor("T", { idx("a+"), idx("i") }), ct::Tensor("T", { idx("b+"), idx("j") }) });
+	// Same shape, but different names for the Tensors and indices
+	ct::GeneralTerm renamedTerm(ct::Tensor("R", { idx("c+"), idx("d+"), idx("k"), idx("l") }), 1.0,
+								{ ct::Tensor("G", { idx("i+"), idx("j+"), idx("a"), idx("b") }),
+								  ct::Tensor("U", { idx("a+"), idx("i") }), ct::Tensor("U", { idx("b+"), idx("j") }),
+								  ct::Tensor("U", { idx("c+"), idx("k") }), ct::Tensor("U", { idx("d+"), idx("l") }) });
+	// Same Tensors but connected differently
+	ct::GeneralTerm otherTerm(ct::Tensor("O", { idx("a+"), idx("b+"), idx("i"), idx("j") }), 1.0,
+							  { ct::Tensor("H", { idx("k+"), idx("l+"), idx("c"), idx("d") }),
+								ct::Tensor("T", { idx("c+"), idx("i") }), ct::Tensor("T", { idx("d+"), idx("j") }),
+								ct::Tensor("T", { idx("a+"), idx("k") }), ct::Tensor("T", { idx("b+"), idx("l") }) });
+
+	std::vector< ct::BinaryTerm > producedTerms;
+
+	for (const ct::GeneralTerm &currentTerm : { term, renamedTerm, term, otherTerm }) {
+		std::vector< ct::BinaryTerm > expected = uncachedFactorizer.factorize(currentTerm, producedTerms);
+		uncachedFactorizer.clearCache();
+
+		std::vector< ct::BinaryTerm > actual = factorizer.factorize(currentTerm, producedTerms);
+
+		ASSERT_EQ(actual, expected);
+		ASSERT_EQ(factorizer.getLastFactorizationCost(), uncachedFactorizer.getLastFactorizationCost());
+		ASSERT_EQ(factorizer.getLastBiggestIntermediateSize(), uncachedFactorizer.getLastBiggestIntermediateSize());
+
+		producedTerms.insert(producedTerms.end(), expected.begin(), expected.end());
+	}
+
+	ASSERT_EQ(factorizer.getCacheHits(), 2);
+	ASSERT_EQ(factorizer.getCacheMisses(), 2);
+
+	// Every factorization reports its lookups along with the statistics of the search a miss required
+	factorizer.clearCache();
+
+	factorizer.factorize(term);
+	ASSERT_EQ(factorizer.getLastCacheLookups().size(), 1);
+	const cp::Factorizer::CacheLookup miss = factorizer.getLastCacheLookups()[0];
+	ASSERT_FALSE(miss.hit);
+	ASSERT_EQ(miss.sizePoint, 0);
+	ASSERT_GT(miss.statistics.expandedNodes, 0);
+	ASSERT_EQ(miss.statistics.expandedNodes, factorizer.getLastSearchStatistics().expandedNodes);
+	ASSERT_EQ(miss.statistics.prunedNodes, factorizer.getLastSearchStatistics().prunedNodes);
+
+	factorizer.factorize(renamedTerm);
+	ASSERT_EQ(factorizer.getLastCacheLookups().size(), 1);
+	const cp::Factorizer::CacheLookup hit = factorizer.getLastCacheLookups()[0];
+	ASSERT_TRUE(hit.hit);
+	ASSERT_EQ(hit.signature, miss.signature);
+	ASSERT_EQ(hit.statistics.expandedNodes, 0);
+	ASSERT_EQ(factorizer.getLastSearchStatistics().expandedNodes, 0);
+
+	// The order in which the Tensors are written doesn't matter either
+	ct::GeneralTerm reorderedTerm(ct::Tensor("O", { idx("a+"), idx("b+"), idx("i"), idx("j") }), 1.0,
+								  { ct::Tensor("T", { idx("b+"), idx("j") }), ct::Tensor("T", { idx("c+"), idx("k") }),
+									ct::Tensor("T", { idx("a+"), idx("i") }),
+									ct::Tensor("H", { idx("k+"), idx("l+"), idx("c"), idx("d") }),
+									ct::Tensor("T", { idx("d+"), idx("l") }) });
+
+	std::vector< ct::BinaryTerm > replayed = factorizer.factorize(reorderedTerm);
+	ASSERT_EQ(factorizer.getLastCacheLookups().size(), 1);
+	ASSERT_TRUE(factorizer.getLastCacheLookups()[0].hit);
+	ASSERT_EQ(factorizer.getLastCacheLookups()[0].signature, miss.signature);
+
+	uncachedFactorizer.clearCache();
+	ASSERT_EQ(replayed, uncachedFactorizer.factorize(reorderedTerm));
+	ASSERT_EQ(factorizer.getLastFactorizationCost(), uncachedFactorizer.getLastFactorizationCost());
+	ASSERT_EQ(factorizer.getLastBiggestIntermediateSize(), uncachedFactorizer.getLastBiggestIntermediateSize());
+	ASSERT_EQ(replayed.size(), reorderedTerm.size() - 1);
+	ASSERT_EQ(replayed.back().getResult(), reorderedTerm.getResult());
+
+	// R[il] += A[ij] B[jk] C[kl] can be factorized as (A B) C or as A (B C) at the same cost. Which of the two is
+	// found must not depend on whether the reordered Term is looked up in the cache or searched for.
+	ct::GeneralTerm chain(ct::Tensor("R", { idx("i"), idx("l") }), 1.0,
+						  { ct::Tensor("A", { idx("i"), idx("j") }), ct::Tensor("B", { idx("j"), idx("k") }),
+							ct::Tensor("C", { idx("k"), idx("l") }) });
+	ct::GeneralTerm reversedChain(ct::Tensor("R", { idx("i"), idx("l") }), 1.0,
+								  { ct::Tensor("C", { idx("k"), idx("l") }), ct::Tensor("B", { idx("j"), idx("k") }),
+									ct::Tensor("A", { idx("i"), idx("j") }) });
+
+	factorizer.clearCache();
+	factorizer.factorize(chain);
+	std::vector< ct::BinaryTerm > cachedChain = factorizer.factorize(reversedChain);
+	ASSERT_TRUE(factorizer.getLastCacheLookups()[0].hit);
+
+	uncachedFactorizer.clearCache();
+	ASSERT_EQ(cachedChain, uncachedFactorizer.factorize(reversedChain));
+	ASSERT_FALSE(uncachedFactorizer.getLastCacheLookups()[0].hit);
+
+	factorizer.clearCache();
+
+	ASSERT_EQ(factorizer.getCacheHits(), 0);
+	ASSERT_EQ(factorizer.getCacheMisses(), 0);
+}
+
+TEST(FactorizerTest, persistentCache) {
+	// O[a⁺b⁺i⁻j⁻] += 0.5 * B[k⁺d⁻qⁿ] * B[l⁺c⁻qⁿ] * T[c⁺d⁺k⁻i⁻] * T[a⁺b⁺l⁻j⁻]
+	ct::GeneralTerm term(ct::Tensor("O", { idx("a+"), idx("b+"), idx("i"), idx("j") }), 0.5,
+						 { ct::Tensor("B", { idx("k+"), idx("d"), idx("q!") }),
+						   ct::Tensor("B", { idx("l+"), idx("c"), idx("q!") }),
+						   ct::Tensor("T", { idx("c+"), idx("d+"), idx("k"), idx("i") }),
+						   ct::Tensor("T", { idx("a+"), idx("b+"), idx("l"), idx("j") }) });
+
+	cp::Factorizer writingFactorizer(resolver);
+	std::vector< ct::BinaryTerm > expected = writingFactorizer.factorize(term);
+
+	std::stringstream stream;
+	writingFactorizer.writeCache(stream);
+
+	{
+		cp::Factorizer readingFactorizer(resolver);
+		ASSERT_TRUE(readingFactorizer.readCache(stream));
+		ASSERT_EQ(readingFactorizer.getCacheSize(), 1);
+
+		ASSERT_EQ(readingFactorizer.factorize(term), expected);
+		ASSERT_EQ(readingFactorizer.getLastFactorizationCost(), writingFactorizer.getLastFactorizationCost());
+		ASSERT_EQ(readingFactorizer.getLastBiggestIntermediateSize(),
+				  writingFactorizer.getLastBiggestIntermediateSize());
+		ASSERT_EQ(readingFactorizer.getCacheHits(), 1);
+		ASSERT_EQ(readingFactorizer.getCacheMisses(), 0);
+	}
+	{
+		// Changing the size of any index space invalidates the cache
+		std::string modifiedCache = std::regex_replace(stream.str(), std::regex("\"size\": [0-9]+"), "\"size\": 12345",
+													   std::regex_constants::format_first_only);
+		ASSERT_NE(modifiedCache, stream.str());
+
+		std::stringstream cacheStream(modifiedCache);
+		cp::Factorizer readingFactorizer(resolver);
+		ASSERT_FALSE(readingFactorizer.readCache(cacheStream));
+		ASSERT_EQ(readingFactorizer.getCacheSize(), 0);
+	}
+	{
+		std::stringstream brokenStream("{ \"version\": ");
+		cp::Factorizer readingFactorizer(resolver);
+		ASSERT_FALSE(readingFactorizer.readCache(brokenStream));
+		ASSERT_EQ(readingFactorizer.getCacheSize(), 0);
+	}
+	{
+		// Contractions referring to Tensors that don't exist are rejected
+		std::string modifiedCache =
+			std::regex_replace(stream.str(), std::regex("\"order\": \\["), "\"order\": [[0, 99], ",
+							   std::regex_constants::format_first_only);
+		ASSERT_NE(modifiedCache, stream.str());
+
+		std::stringstream cacheStream(modifiedCache);
+		cp::Factorizer readingFactorizer(resolver);
+		ASSERT_FALSE(readingFactorizer.readCache(cacheStream));
+		ASSERT_EQ(readingFactorizer.getCacheSize(), 0);
+	}
+	{
+		// An order that is valid in itself but doesn't fit the Term is treated as a cache miss
+		std::string modifiedCache =
+			std::regex_replace(stream.str(), std::regex("\"order\": \\["), "\"order\": [[0, 1]], \"unused\": [",
+							   std::regex_constants::format_first_only);
+		ASSERT_NE(modifiedCache, stream.str());
+
+		std::stringstream cacheStream(modifiedCache);
+		cp::Factorizer readingFactorizer(resolver);
+		ASSERT_TRUE(readingFactorizer.readCache(cacheStream));
+		ASSERT_EQ(readingFactorizer.getCacheSize(), 1);
+
+		ASSERT_EQ(readingFactorizer.factorize(term), expected);
+		ASSERT_EQ(readingFactorizer.getLastFactorizationCost(), writingFactorizer.getLastFactorizationCost());
+		ASSERT_EQ(readingFactorizer.getCacheHits(), 0);
+		ASSERT_EQ(readingFactorizer.getCacheMisses(), 1);
+	}
+	{
+		// Factorizations found with a different cost model are not reused
+		cp::Factorizer layoutAwareFactorizer(resolver);
+		layoutAwareFactorizer.setLayoutAware(true);
+		layoutAwareFactorizer.factorize(term);
+
+		std::stringstream layoutStream;
+		layoutAwareFactorizer.writeCache(layoutStream);
+
+		cp::Factorizer readingFactorizer(resolver);
+		readingFactorizer.setLayoutAware(true);
+		readingFactorizer.setSymmetryAware(true);
+		ASSERT_FALSE(readingFactorizer.readCache(layoutStream));
+		ASSERT_EQ(readingFactorizer.getCacheSize(), 0);
+
+		// The same holds for factorizations kept in memory
+		layoutAwareFactorizer.setSymmetryAware(true);
+		layoutAwareFactorizer.factorize(term);
+		ASSERT_EQ(layoutAwareFactorizer.getCacheHits(), 0);
+		ASSERT_EQ(layoutAwareFactorizer.getCacheMisses(), 2);
+	}
+}
+
+TEST(FactorizerTest, reuseAwareFactorization) {
+	cp::Factorizer factorizer(resolver);
+	cp::Factorizer reuseAwareFactorizer(resolver);
+	reuseAwareFactorizer.setReuseAware(true);
+
+	ASSERT_FALSE(factorizer.isReuseAware());
+	ASSERT_TRUE(reuseAwareFactorizer.isReuseAware());
+
+	// O[ij] = A[ia] B[ab] C[bj]
+	// Both contraction orders are equally expensive and without reuse, (A * B) * C is picked
+	ct::Tensor O("O", { idx("i"), idx("j") });
+	ct::Tensor A("A", { idx("i"), idx("a") });
+	ct::Tensor B("B", { idx("a"), idx("b") });
+	ct::Tensor C("C", { idx("b"), idx("j") });
+	ct::GeneralTerm inTerm(ct::Tensor(O), 1.0, { ct::Tensor(A), ct::Tensor(B), ct::Tensor(C) });
+
+	// A previous Term computes B * C already (under a different name than the Factorizer would choose)
+	ct::Tensor intermediate("X", { idx("a"), idx("j") });
+	ct::BinaryTerm intermediateTerm(ct::Tensor(intermediate), 1.0, ct::Tensor(B), ct::Tensor(C));
+	ct::BinaryTerm result(ct::Tensor(O), 1.0, ct::Tensor(A), ct::Tensor(intermediate));
+
+	intermediateTerm.sort();
+	cp::canonicalizeIndexIDs(intermediateTerm);
+	result.sort();
+	cp::canonicalizeIndexIDs(result);
+
+	const std::vector< ct::BinaryTerm > previousTerms = { intermediateTerm };
+
+	factorizer.factorize(inTerm, previousTerms);
+
+	ASSERT_EQ(factorizer.getLastFactorizationCost(), 10 * 100 * 100 + 10 * 100 * 10);
+	ASSERT_EQ(factorizer.getLastReuseSavings(), 0);
+
+	std::vector< ct::BinaryTerm > factorizedTerms = reuseAwareFactorizer.factorize(inTerm, previousTerms);
+
+	ASSERT_THAT(factorizedTerms, ::testing::ElementsAre(intermediateTerm, result));
+	ASSERT_EQ(reuseAwareFactorizer.getLastFactorizationCost(), 10 * 100 * 10);
+	ASSERT_EQ(reuseAwareFactorizer.getLastReuseSavings(), 100 * 100 * 10);
+	// Factorizations depending on the available intermediates are not cached
+	ASSERT_EQ(reuseAwareFactorizer.getCacheMisses(), 0);
+
+	// The result of the final contraction of a previous Term of the same composite can't be reused
+	reuseAwareFactorizer.factorize(
+		ct::GeneralTerm(ct::Tensor(O), 1.0, { ct::Tensor(A), ct::Tensor(B), ct::Tensor(C) }),
+		{ ct::BinaryTerm(ct::Tensor(O), 1.0, ct::Tensor(B), ct::Tensor(C)) });
+
+	ASSERT_EQ(reuseAwareFactorizer.getLastReuseSavings(), 0);
+
+	// The concurrent search has to come to the same conclusion
+	cp::Factorizer concurrentFactorizer(resolver);
+	concurrentFactorizer.setReuseAware(true);
+	concurrentFactorizer.setJobs(4);
+
+	// O[ij] = A[ia] B[ab] C[bc] D[cj]
+	ct::Tensor D("D", { idx("c"), idx("j") });
+	ct::Tensor otherC("C", { idx("b"), idx("c") });
+	ct::GeneralTerm biggerTerm(ct::Tensor(O), 1.0,
+							   { ct::Tensor(A), ct::Tensor(B), ct::Tensor(otherC), ct::Tensor(D) });
+
+	ct::BinaryTerm otherIntermediateTerm(ct::Tensor("X", { idx("b"), idx("j") }), 1.0, ct::Tensor(otherC),
+										 ct::Tensor(D));
+	otherIntermediateTerm.sort();
+	cp::canonicalizeIndexIDs(otherIntermediateTerm);
+
+	std::vector< ct::BinaryTerm > expected = reuseAwareFactorizer.factorize(biggerTerm, { otherIntermediateTerm });
+	std::vector< ct::BinaryTerm > actual   = concurrentFactorizer.factorize(biggerTerm, { otherIntermediateTerm });
+
+	ASSERT_EQ(actual, expected);
+	ASSERT_GT(reuseAwareFactorizer.getLastReuseSavings(), 0);
+	ASSERT_EQ(concurrentFactorizer.getLastReuseSavings(), reuseAwareFactorizer.getLastReuseSavings());
+	ASSERT_EQ(concurrentFactorizer.getLastFactorizationCost(), reuseAwareFactorizer.getLastFactorizationCost());
+}
+
+TEST(FactorizerTest, maxIntermediateSize) {
+	cp::Factorizer factorizer(resolver);
+
+	ASSERT_FALSE(factorizer.hasIntermediateSizeLimit());
+
+	// O[dl] = A[b] B[bjq] C[jlq] D[d]
+	// The optimal factorization first contracts A with B which produces an intermediate with 2000 elements
+	ct::GeneralTerm term(ct::Tensor("O", { idx("d"), idx("l") }), 1.0,
+						 { ct::Tensor("A", { idx("b") }), ct::Tensor("B", { idx("b"), idx("j"), idx("q!") }),
+						   ct::Tensor("C", { idx("j"), idx("l"), idx("q!") }), ct::Tensor("D", { idx("d") }) });
+
+	factorizer.factorize(term);
+
+	ASSERT_EQ(factorizer.getLastFactorizationCost(), 100 * 10 * 200 + 10 * 10 * 200 + 100 * 10);
+
+	// When limiting intermediates to 1000 elements, B has to be contracted with C first
+	cp::Factorizer limitedFactorizer(resolver);
+	limitedFactorizer.setMaxIntermediateSize(1000);
+
+	ASSERT_TRUE(limitedFactorizer.hasIntermediateSizeLimit());
+	ASSERT_EQ(limitedFactorizer.getMaxIntermediateSize(), 1000);
+
+	std::vector< ct::BinaryTerm > limitedTerms = limitedFactorizer.factorize(term);
+
+	ASSERT_EQ(limitedFactorizer.getLastFactorizationCost(), 100 * 10 * 10 * 200 + 100 * 10 + 100 * 10);
+	ASSERT_EQ(limitedFactorizer.getLastBiggestIntermediateSize(), 1000);
+
+	// The same has to hold for the other engine and for the concurrent search
+	cp::Factorizer dpFactorizer(resolver, cp::Factorizer::Engine::DynamicProgramming);
+	dpFactorizer.setMaxIntermediateSize(1000);
+	cp::Factorizer concurrentFactorizer(resolver);
+	concurrentFactorizer.setMaxIntermediateSize(1000);
+	concurrentFactorizer.setJobs(4);
+
+	for (cp::Factorizer *currentFactorizer : { &dpFactorizer, &concurrentFactorizer }) {
+		ASSERT_EQ(currentFactorizer->factorize(term), limitedTerms);
+		ASSERT_EQ(currentFactorizer->getLastFactorizationCost(), limitedFactorizer.getLastFactorizationCost());
+	}
+
+	// The cached factorization of the unlimited search must not be used for the limited one (and vice versa)
+	factorizer.setMaxIntermediateSize(1000);
+	ASSERT_EQ(factorizer.factorize(term), limitedTerms);
+	ASSERT_EQ(factorizer.getCacheHits(), 0);
+
+	// If there is no way to stay within the limit, factorizing fails
+	limitedFactorizer.setMaxIntermediateSize(100);
+
+	ASSERT_THROW(limitedFactorizer.factorize(term), cp::FactorizationException);
+}
+
+TEST(FactorizerTest, paretoFront) {
+	cp::Factorizer factorizer(resolver);
+
+	ASSERT_EQ(factorizer.getPolicy(), cp::Factorizer::Policy::MinimumCost);
+	ASSERT_FALSE(factorizer.isRecordingParetoFront());
+
+	// O[dl] = A[b] B[bjq] C[jlq] D[d]
+	// Contracting A with B first is cheapest but produces an intermediate with 2000 elements whereas contracting B
+	// with C first only produces intermediates as big as the result (1000 elements) but is more expensive
+	ct::GeneralTerm term(ct::Tensor("O", { idx("d"), idx("l") }), 1.0,
+						 { ct::Tensor("A", { idx("b") }), ct::Tensor("B", { idx("b"), idx("j"), idx("q!") }),
+						   ct::Tensor("C", { idx("j"), idx("l"), idx("q!") }), ct::Tensor("D", { idx("d") }) });
+
+	const std::vector< ct::BinaryTerm > cheapestTerms = factorizer.factorize(term);
+	ASSERT_TRUE(factorizer.getLastParetoFront().empty());
+
+	cp::Factorizer limitedFactorizer(resolver);
+	limitedFactorizer.setMaxIntermediateSize(1000);
+	const std::vector< ct::BinaryTerm > smallestTerms = limitedFactorizer.factorize(term);
+
+	factorizer.setRecordParetoFront(true);
+	ASSERT_EQ(factorizer.factorize(term), cheapestTerms);
+
+	const std::vector< cp::Factorizer::ParetoPoint > &front = factorizer.getLastParetoFront();
+	ASSERT_EQ(front.size(), 2);
+	ASSERT_EQ(factorizer.getLastParetoChoice(), 0);
+
+	ASSERT_EQ(front[0].terms, cheapestTerms);
+	ASSERT_EQ(front[0].cost, 221000);
+	ASSERT_EQ(front[0].biggestIntermediate, 2000);
+	ASSERT_EQ(front[1].terms, smallestTerms);
+	ASSERT_EQ(front[1].cost, 2002000);
+	ASSERT_EQ(front[1].biggestIntermediate, 1000);
+
+	// The search for the front must not change the Factorizer's own limit
+	ASSERT_FALSE(factorizer.hasIntermediateSizeLimit());
+
+	factorizer.setPolicy(cp::Factorizer::Policy::MinimumMemory);
+	ASSERT_EQ(factorizer.factorize(term), smallestTerms);
+	ASSERT_EQ(factorizer.getLastParetoChoice(), 1);
+	ASSERT_EQ(factorizer.getLastFactorizationCost(), 2002000);
+	ASSERT_EQ(factorizer.getLastBiggestIntermediateSize(), 1000);
+
+	// 221000 * 2000 < 2002000 * 1000
+	factorizer.setPolicy(cp::Factorizer::Policy::Balanced);
+	ASSERT_EQ(factorizer.factorize(term), cheapestTerms);
+	ASSERT_EQ(factorizer.getLastParetoChoice(), 0);
+
+	// An explicit limit cuts off the front
+	factorizer.setMaxIntermediateSize(1000);
+	factorizer.factorize(term);
+	ASSERT_EQ(factorizer.getLastParetoFront().size(), 1);
+	ASSERT_EQ(factorizer.getLastFactorizationCost(), 2002000);
+	ASSERT_EQ(factorizer.getMaxIntermediateSize(), 1000);
+
+	factorizer.setMaxIntermediateSize(100);
+	ASSERT_THROW(factorizer.factorize(term), cp::FactorizationException);
+	ASSERT_EQ(factorizer.getMaxIntermediateSize(), 100);
+}
+
+TEST(FactorizerTest, sizePoints) {
+	cp::Factorizer factorizer(resolver);
+
+	ASSERT_EQ(factorizer.getSizePointCount(), 0);
+
+	// O[aj] = A[ai] B[ib] C[bj]
+	// Contracting B with C first costs 2 N_P N_H^2 whereas contracting A with B first costs 2 N_P^2 N_H
+	ct::GeneralTerm term(ct::Tensor("O", { idx("a"), idx("j") }), 1.0,
+						 { ct::Tensor("A", { idx("a"), idx("i") }), ct::Tensor("B", { idx("i"), idx("b") }),
+						   ct::Tensor("C", { idx("b"), idx("j") }) });
+
+	const ct::IndexSpace virt = resolver.resolve("virtual");
+	const ct::IndexSpace occ  = resolver.resolve("occupied");
+
+	const std::vector< ct::BinaryTerm > nominalTerms = factorizer.factorize(term);
+
+	ASSERT_EQ(factorizer.getLastFactorizationCost(), 2 * 100 * 10 * 10);
+	ASSERT_EQ(factorizer.getLastCostPolynomial(), ct::CostPolynomial({ { virt, 1 }, { occ, 2 } }, 2));
+	ASSERT_EQ(factorizer.getLastWorstCostRatio(), 1);
+
+	// With a much bigger occupied space, the other factorization becomes optimal
+	cu::IndexSpaceResolver::meta_list_t metas = resolver.getMetaList();
+	for (ct::IndexSpaceMeta &currentMeta : metas) {
+		if (currentMeta.getSpace() == occ) {
+			currentMeta.setSize(2000);
+		}
+	}
+	cu::IndexSpaceResolver bigResolver(metas);
+
+	cp::Factorizer bigFactorizer(bigResolver);
+	const std::vector< ct::BinaryTerm > bigTerms = bigFactorizer.factorize(term);
+
+	ASSERT_NE(bigTerms, nominalTerms);
+	ASSERT_EQ(bigFactorizer.getLastCostPolynomial(), ct::CostPolynomial({ { virt, 2 }, { occ, 1 } }, 2));
+
+	// The factorization that is optimal for the nominal sizes is 20 times as expensive as the optimum for the big
+	// occupied space while the other one is only 10 times as expensive as the optimum for the nominal sizes
+	factorizer.setSizePoints({ bigResolver });
+	ASSERT_EQ(factorizer.getSizePointCount(), 1);
+
+	ASSERT_EQ(factorizer.factorize(term), bigTerms);
+	ASSERT_EQ(factorizer.getLastFactorizationCost(), 2 * 100 * 100 * 10);
+	ASSERT_EQ(factorizer.getLastCostPolynomial(), ct::CostPolynomial({ { virt, 2 }, { occ, 1 } }, 2));
+	ASSERT_DOUBLE_EQ(factorizer.getLastWorstCostRatio(), 10);
+
+	// The lookups of the size point's Factorizer are reported as well
+	ASSERT_EQ(factorizer.getLastCacheLookups().size(), 2);
+	ASSERT_EQ(factorizer.getLastCacheLookups()[0].sizePoint, 0);
+	ASSERT_TRUE(factorizer.getLastCacheLookups()[0].hit);
+	ASSERT_EQ(factorizer.getLastCacheLookups()[1].sizePoint, 1);
+	ASSERT_FALSE(factorizer.getLastCacheLookups()[1].hit);
+
+	// The same happens when copying the Factorizer
+	cp::Factorizer copy = factorizer;
+	ASSERT_EQ(copy.factorize(term), bigTerms);
+
+	// The intermediate size limit only applies to the nominal sizes and rules out the alternative factorization. The
+	// ratios are only determined with respect to the admissible factorizations.
+	factorizer.setMaxIntermediateSize(100);
+	ASSERT_EQ(factorizer.factorize(term), nominalTerms);
+	ASSERT_DOUBLE_EQ(factorizer.getLastWorstCostRatio(), 1);
+
+	factorizer.setMaxIntermediateSize(std::numeric_limits< ct::ContractionResult::cost_t >::max());
+	factorizer.setSizePoints({});
+	ASSERT_EQ(factorizer.getSizePointCount(), 0);
+	ASSERT_EQ(factorizer.factorize(term), nominalTerms);
+}
+
+TEST(FactorizerTest, symmetryAwareCost) {
+	cp::Factorizer factorizer(resolver);
+
+	ASSERT_FALSE(factorizer.isSymmetryAware());
+
+	// O[] = A[ij] B[ijk] C[k] with B being antisymmetric with respect to i <-> j
+	ct::Tensor B("B", { idx("i"), idx("j"), idx("k") });
+	ct::PermutationGroup symmetry(B.getIndices());
+	symmetry.addGenerator(ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } }, -1));
+	B.setSymmetry(symmetry);
+
+	ct::GeneralTerm term(ct::Tensor("O"), 1.0,
+						 { ct::Tensor("A", { idx("i"), idx("j") }), B, ct::Tensor("C", { idx("k") }) });
+
+	// Contracting A with B first is cheaper if the symmetry is not exploited
+	const std::vector< ct::BinaryTerm > denseTerms = factorizer.factorize(term);
+
+	ASSERT_EQ(factorizer.getLastFactorizationCost(), 10 * 10 * 10 + 10);
+	ASSERT_EQ(factorizer.getLastDenseCost(), factorizer.getLastFactorizationCost());
+	ASSERT_EQ(factorizer.getLastSymmetryReducedCost(), factorizer.getLastFactorizationCost());
+
+	// Contracting B with C first yields an intermediate that is antisymmetric in i <-> j (and thus only half of its
+	// elements have to be computed)
+	cp::Factorizer symmetryAwareFactorizer(resolver);
+	symmetryAwareFactorizer.setSymmetryAware(true);
+	ASSERT_TRUE(symmetryAwareFactorizer.isSymmetryAware());
+
+	const std::vector< ct::BinaryTerm > symmetricTerms = symmetryAwareFactorizer.factorize(term);
+
+	ASSERT_NE(symmetricTerms, denseTerms);
+	ASSERT_EQ(symmetryAwareFactorizer.getLastFactorizationCost(), 10 * 10 * 10 / 2 + 10 * 10);
+	ASSERT_EQ(symmetryAwareFactorizer.getLastSymmetryReducedCost(),
+			  symmetryAwareFactorizer.getLastFactorizationCost());
+	ASSERT_EQ(symmetryAwareFactorizer.getLastDenseCost(), 10 * 10 * 10 + 10 * 10);
+
+	// The DynamicProgramming engine falls back to the exhaustive search
+	cp::Factorizer dpFactorizer(resolver, cp::Factorizer::Engine::DynamicProgramming);
+	dpFactorizer.setSymmetryAware(true);
+	ASSERT_EQ(dpFactorizer.factorize(term), symmetricTerms);
+
+	// The cached dense factorization must not be used for the symmetry-aware one
+	factorizer.setSymmetryAware(true);
+	ASSERT_EQ(factorizer.factorize(term), symmetricTerms);
+	ASSERT_EQ(factorizer.getCacheHits(), 0);
+	ASSERT_EQ(factorizer.factorize(term), symmetricTerms);
+	ASSERT_EQ(factorizer.getCacheHits(), 1);
+}
+
+TEST(FactorizerTest, layoutAwareFactorization) {
+	cp::Factorizer factorizer(resolver);
+
+	ASSERT_FALSE(factorizer.isLayoutAware());
+
+	// O[ilm] = A[nl] B[knm] C[ki] can be factorized as (A B) C or as A (B C) at the same cost but the two differ in the
+	// amount of Tensor elements that have to be transposed in order to carry them out as GEMMs
+	ct::GeneralTerm term(ct::Tensor("O", { idx("i"), idx("l"), idx("m") }), 1.0,
+						 { ct::Tensor("A", { idx("n"), idx("l") }), ct::Tensor("B", { idx("k"), idx("n"), idx("m") }),
+						   ct::Tensor("C", { idx("k"), idx("i") }) });
+
+	const std::vector< ct::BinaryTerm > defaultTerms = factorizer.factorize(term);
+
+	ct::ContractionResult::cost_t defaultTransposeCost = 0;
+	for (const ct::BinaryTerm &currentTerm : defaultTerms) {
+		defaultTransposeCost += cp::getTransposeCost(currentTerm, resolver);
+	}
+
+	ASSERT_EQ(factorizer.getLastTransposeCost(), defaultTransposeCost);
+	ASSERT_EQ(defaultTransposeCost, 2 * 10 * 10 * 10);
+
+	cp::Factorizer layoutAwareFactorizer(resolver);
+	layoutAwareFactorizer.setLayoutAware(true);
+	ASSERT_TRUE(layoutAwareFactorizer.isLayoutAware());
+
+	const std::vector< ct::BinaryTerm > layoutTerms = layoutAwareFactorizer.factorize(term);
+
+	ASSERT_NE(layoutTerms, defaultTerms);
+	ASSERT_EQ(layoutAwareFactorizer.getLastFactorizationCost(), factorizer.getLastFactorizationCost());
+	ASSERT_EQ(layoutAwareFactorizer.getLastTransposeCost(), 10 * 10 * 10);
+
+	// Both orders of the operands are considered, so the order in which the Tensors are written doesn't matter
+	ct::GeneralTerm reversedTerm(ct::Tensor("O", { idx("i"), idx("l"), idx("m") }), 1.0,
+								 { ct::Tensor("C", { idx("k"), idx("i") }),
+								   ct::Tensor("B", { idx("k"), idx("n"), idx("m") }),
+								   ct::Tensor("A", { idx("n"), idx("l") }) });
+	cp::Factorizer reversedFactorizer(resolver);
+	reversedFactorizer.setLayoutAware(true);
+	ASSERT_EQ(reversedFactorizer.factorize(reversedTerm), layoutTerms);
+	ASSERT_EQ(reversedFactorizer.getLastTransposeCost(), 10 * 10 * 10);
+
+	// The DynamicProgramming engine falls back to the exhaustive search
+	cp::Factorizer dpFactorizer(resolver, cp::Factorizer::Engine::DynamicProgramming);
+	dpFactorizer.setLayoutAware(true);
+	ASSERT_EQ(dpFactorizer.factorize(term), layoutTerms);
+
+	// The cached factorization must not be used for the layout-aware one
+	factorizer.setLayoutAware(true);
+	ASSERT_EQ(factorizer.factorize(term), layoutTerms);
+	ASSERT_EQ(factorizer.getCacheHits(), 0);
+	ASSERT_EQ(factorizer.factorize(term), layoutTerms);
+	ASSERT_EQ(factorizer.getCacheHits(), 1);
+}
+
+TEST(FactorizerTest, symmetryAndLayoutAwareFactorization) {
+	cp::Factorizer factorizer(resolver);
+	factorizer.setSymmetryAware(true);
+	factorizer.setLayoutAware(true);
+
+	// O[abij] = A[kb] B[kl] C[laij] with O being antisymmetric with respect to a <-> b. The final contraction could be
+	// carried out as a GEMM without transposition if the result was written as O[baij], but the Term producing the
+	// final result must keep the result's index sequence.
+	ct::Tensor O("O", { idx("a"), idx("b"), idx("i"), idx("j") });
+	ct::PermutationGroup symmetry(O.getIndices());
+	symmetry.addGenerator(ct::IndexSubstitution::createPermutation({ { idx("a"), idx("b") } }, -1));
+	O.setSymmetry(symmetry);
+
+	ct::GeneralTerm term(O, 1.0,
+						 { ct::Tensor("A", { idx("k"), idx("b") }), ct::Tensor("B", { idx("k"), idx("l") }),
+						   ct::Tensor("C", { idx("l"), idx("a"), idx("i"), idx("j") }) });
+
+	const std::vector< ct::BinaryTerm > factorizedTerms = factorizer.factorize(term);
+
+	ASSERT_EQ(factorizedTerms.size(), 2);
+	ASSERT_EQ(factorizedTerms.back().getResult(), term.getResult());
+	ASSERT_EQ(factorizedTerms.back().getResult().getIndices(), term.getResult().getIndices());
+	ASSERT_EQ(factorizedTerms.back().getPrefactor(), term.getPrefactor());
+	ASSERT_EQ(factorizer.getLastSymmetryReducedCost(), factorizer.getLastFactorizationCost());
+	ASSERT_EQ(factorizer.getLastTransposeCost(), cp::getTransposeCost(factorizedTerms[0], resolver)
+													 + cp::getTransposeCost(factorizedTerms[1], resolver));
+
+	// The same holds for a Term that consists of a single contraction
+	ct::GeneralTerm binaryTerm(O, 1.0,
+							   { ct::Tensor("A", { idx("k"), idx("b") }),
+								 ct::Tensor("C", { idx("k"), idx("a"), idx("i"), idx("j") }) });
+
+	const std::vector< ct::BinaryTerm > binaryTerms = factorizer.factorize(binaryTerm);
+
+	ASSERT_EQ(binaryTerms.size(), 1);
+	ASSERT_EQ(binaryTerms[0].getResult().getIndices(), binaryTerm.getResult().getIndices());
+	ASSERT_EQ(binaryTerms[0].getPrefactor(), binaryTerm.getPrefactor());
+}
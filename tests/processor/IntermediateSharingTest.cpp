@@ -0,0 +1,131 @@
+#include "processor/IntermediateSharing.hpp"
+#include "terms/BinaryTerm.hpp"
+#include "terms/CompositeTerm.hpp"
+#include "terms/GeneralTerm.hpp"
+#include "terms/Tensor.hpp"
+#include "terms/TermGroup.hpp"
+
+#include "IndexHelper.hpp"
+
+#include <string_view>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ct  = Contractor::Terms;
+namespace cpr = Contractor::Processor;
+
+static bool isIntermediate(std::string_view name) {
+	return name != "H" && name != "T" && name != "R1" && name != "R2" && name != "R3";
+}
+
+TEST(IntermediateSharingTest, operationCount) {
+	// 100 * 100 * 10
+	ct::BinaryTerm term(ct::Tensor("X", { idx("a+"), idx("i") }), 1.0, ct::Tensor("H", { idx("a+"), idx("b") }),
+						ct::Tensor("T", { idx("b+"), idx("i") }));
+
+	ASSERT_EQ(cpr::getOperationCount(term, resolver), 100000);
+}
+
+TEST(IntermediateSharingTest, shareIntermediates) {
+	// X[ai] = H[ab] T[bi]
+	ct::BinaryTerm intermediate(ct::Tensor("X", { idx("a+"), idx("i") }), 1.0,
+								ct::Tensor("H", { idx("a+"), idx("b") }), ct::Tensor("T", { idx("b+"), idx("i") }));
+	// Y[ai] = 2 * H[ab] T[bi] = 2 * X[ai]
+	ct::BinaryTerm relatedIntermediate(ct::Tensor("Y", { idx("a+"), idx("i") }), 2.0,
+									   ct::Tensor("H", { idx("a+"), idx("b") }),
+									   ct::Tensor("T", { idx("b+"), idx("i") }));
+	// Z[ai] = H[ab] H[bi]
+	ct::BinaryTerm unrelatedIntermediate(ct::Tensor("Z", { idx("a+"), idx("i") }), 1.0,
+										 ct::Tensor("H", { idx("a+"), idx("b") }),
+										 ct::Tensor("H", { idx("b+"), idx("i") }));
+
+	std::vector< ct::BinaryTermGroup > groups;
+	{
+		// R1[ij] = X[ai] T[aj]
+		ct::BinaryTerm result(ct::Tensor("R1", { idx("i+"), idx("j") }), 1.0, ct::Tensor("X", { idx("a+"), idx("i") }),
+							  ct::Tensor("T", { idx("a+"), idx("j") }));
+		ct::BinaryTermGroup group(ct::GeneralTerm(ct::Tensor("R1", { idx("i+"), idx("j") }), 1.0, {}));
+		group.addTerm(intermediate);
+		group.addTerm(result);
+		groups.push_back(std::move(group));
+	}
+	{
+		// R2[ij] = Y[ai] T[aj] (Y is related to X)
+		ct::BinaryTerm result(ct::Tensor("R2", { idx("i+"), idx("j") }), 1.0, ct::Tensor("Y", { idx("a+"), idx("i") }),
+							  ct::Tensor("T", { idx("a+"), idx("j") }));
+		ct::BinaryTermGroup group(ct::GeneralTerm(ct::Tensor("R2", { idx("i+"), idx("j") }), 1.0, {}));
+		group.addTerm(relatedIntermediate);
+		group.addTerm(result);
+		groups.push_back(std::move(group));
+	}
+	{
+		// R3[ij] = Z[ai] T[aj] (Z is not related to X)
+		ct::BinaryTerm result(ct::Tensor("R3", { idx("i+"), idx("j") }), 1.0, ct::Tensor("Z", { idx("a+"), idx("i") }),
+							  ct::Tensor("T", { idx("a+"), idx("j") }));
+		ct::BinaryTermGroup group(ct::GeneralTerm(ct::Tensor("R3", { idx("i+"), idx("j") }), 1.0, {}));
+		group.addTerm(unrelatedIntermediate);
+		group.addTerm(result);
+		groups.push_back(std::move(group));
+	}
+
+	std::vector< ct::BinaryTermGroup > expectedGroups = groups;
+	// The calculation of Y is dropped and R2 uses X instead
+	expectedGroups[1].accessTerms().erase(expectedGroups[1].accessTerms().begin());
+	expectedGroups[1][0][0] =
+		ct::BinaryTerm(ct::Tensor("R2", { idx("i+"), idx("j") }), 2.0, ct::Tensor("X", { idx("a+"), idx("i") }),
+					   ct::Tensor("T", { idx("a+"), idx("j") }));
+
+	ct::ContractionResult::cost_t savedOperations = cpr::shareIntermediates(groups, resolver, isIntermediate);
+
+	ASSERT_EQ(savedOperations, cpr::getOperationCount(relatedIntermediate, resolver));
+	ASSERT_EQ(groups, expectedGroups);
+
+	// Running the elimination again does not find anything new
+	ASSERT_EQ(cpr::shareIntermediates(groups, resolver, isIntermediate), 0);
+	ASSERT_EQ(groups, expectedGroups);
+}
+
+TEST(IntermediateSharingTest, sharePermutedIntermediates) {
+	// X[i⁺j⁺a⁻k⁻] = - H[i⁺j⁺a⁻b⁻] T[b⁺k⁻]
+	ct::BinaryTerm intermediate(ct::Tensor("X", { idx("i+"), idx("j+"), idx("a-"), idx("k-") }), -1.0,
+								ct::Tensor("H", { idx("i+"), idx("j+"), idx("a-"), idx("b-") }),
+								ct::Tensor("T", { idx("b+"), idx("k-") }));
+	// Y[i⁺j⁺a⁻k⁻] = H[j⁺i⁺a⁻b⁻] T[b⁺k⁻] = - X[j⁺i⁺a⁻k⁻]
+	ct::BinaryTerm permutedIntermediate(ct::Tensor("Y", { idx("i+"), idx("j+"), idx("a-"), idx("k-") }), 1.0,
+										ct::Tensor("H", { idx("j+"), idx("i+"), idx("a-"), idx("b-") }),
+										ct::Tensor("T", { idx("b+"), idx("k-") }));
+
+	std::vector< ct::BinaryTermGroup > groups;
+	{
+		// R1[i⁺j⁺a⁻k⁻] = X[i⁺j⁺a⁻k⁻]
+		ct::Tensor resultTensor("R1", { idx("i+"), idx("j+"), idx("a-"), idx("k-") });
+		ct::BinaryTerm result(resultTensor, 1.0, ct::Tensor("X", { idx("i+"), idx("j+"), idx("a-"), idx("k-") }));
+		ct::BinaryTermGroup group(ct::GeneralTerm(resultTensor, 1.0, {}));
+		group.addTerm(intermediate);
+		group.addTerm(result);
+		groups.push_back(std::move(group));
+	}
+	{
+		// R2[i⁺j⁺a⁻k⁻] = Y[i⁺j⁺a⁻k⁻]
+		ct::Tensor resultTensor("R2", { idx("i+"), idx("j+"), idx("a-"), idx("k-") });
+		ct::BinaryTerm result(resultTensor, 1.0, ct::Tensor("Y", { idx("i+"), idx("j+"), idx("a-"), idx("k-") }));
+		ct::BinaryTermGroup group(ct::GeneralTerm(resultTensor, 1.0, {}));
+		group.addTerm(permutedIntermediate);
+		group.addTerm(result);
+		groups.push_back(std::move(group));
+	}
+
+	std::vector< ct::BinaryTermGroup > expectedGroups = groups;
+	// The calculation of Y is dropped and R2 uses X (with permuted indices) instead
+	expectedGroups[1].accessTerms().erase(expectedGroups[1].accessTerms().begin());
+	expectedGroups[1][0][0] =
+		ct::BinaryTerm(ct::Tensor("R2", { idx("i+"), idx("j+"), idx("a-"), idx("k-") }), -1.0,
+					   ct::Tensor("X", { idx("j+"), idx("i+"), idx("a-"), idx("k-") }));
+
+	ct::ContractionResult::cost_t savedOperations = cpr::shareIntermediates(groups, resolver, isIntermediate);
+
+	ASSERT_EQ(savedOperations, cpr::getOperationCount(permutedIntermediate, resolver));
+	ASSERT_EQ(groups, expectedGroups);
+}
@@ -0,0 +1,61 @@
+#include "processor/LayoutCost.hpp"
+#include "terms/BinaryTerm.hpp"
+#include "terms/Index.hpp"
+#include "terms/Tensor.hpp"
+
+#include "IndexHelper.hpp"
+
+#include <gtest/gtest.h>
+
+namespace ct = Contractor::Terms;
+namespace cp = Contractor::Processor;
+
+TEST(LayoutCostTest, singleTensor) {
+	// Indices that are summed over don't affect the layout of the result
+	ASSERT_EQ(cp::getTransposeCost({ idx("i"), idx("j") }, { idx("i"), idx("j") }, resolver), 0);
+	ASSERT_EQ(cp::getTransposeCost({ idx("i"), idx("j") }, { idx("i"), idx("a"), idx("j") }, resolver), 0);
+
+	ASSERT_EQ(cp::getTransposeCost({ idx("j"), idx("i") }, { idx("i"), idx("j") }, resolver), 10 * 10);
+	ASSERT_EQ(cp::getTransposeCost({ idx("j"), idx("i") }, { idx("i"), idx("a"), idx("j") }, resolver), 10 * 100 * 10);
+}
+
+TEST(LayoutCostTest, contraction) {
+	const ct::Index a = idx("a");
+	const ct::Index b = idx("b");
+	const ct::Index i = idx("i");
+	const ct::Index j = idx("j");
+	const ct::Index k = idx("k");
+
+	// O[ij] = A[ik] B[kj] is a plain GEMM
+	ASSERT_EQ(cp::getTransposeCost({ i, j }, { i, k }, { k, j }, resolver), 0);
+
+	// Transposed operands and results can be handled by the GEMM itself
+	ASSERT_EQ(cp::getTransposeCost({ i, j }, { k, i }, { j, k }, resolver), 0);
+	ASSERT_EQ(cp::getTransposeCost({ j, i }, { i, k }, { k, j }, resolver), 0);
+
+	// Blocks of multiple indices have to appear in the same order everywhere
+	ASSERT_EQ(cp::getTransposeCost({ i, a, j }, { i, a, k, b }, { k, b, j }, resolver), 0);
+	ASSERT_EQ(cp::getTransposeCost({ i, a, j }, { i, a, k, b }, { b, k, j }, resolver), 100 * 10 * 10);
+	ASSERT_EQ(cp::getTransposeCost({ a, i, j }, { i, a, k, b }, { k, b, j }, resolver), 100 * 10 * 10);
+
+	// The contracted indices of A are not contiguous, so A has to be transposed no matter what
+	ASSERT_EQ(cp::getTransposeCost({ i, a }, { k, i, b }, { b, k, a }, resolver), 10 * 10 * 100);
+
+	// Outer products
+	ASSERT_EQ(cp::getTransposeCost({ i, j }, { i }, { j }, resolver), 0);
+	ASSERT_EQ(cp::getTransposeCost({ i, j, k }, { i, k }, { j }, resolver), 10 * 10 * 10);
+}
+
+TEST(LayoutCostTest, binaryTerm) {
+	ct::BinaryTerm gemm(ct::Tensor("O", { idx("i"), idx("j") }), 1.0, ct::Tensor("A", { idx("i"), idx("k") }),
+						ct::Tensor("B", { idx("k"), idx("j") }));
+	ASSERT_EQ(cp::getTransposeCost(gemm, resolver), 0);
+
+	ct::BinaryTerm nonGemm(ct::Tensor("O", { idx("i"), idx("a") }), 1.0,
+						   ct::Tensor("A", { idx("k"), idx("i"), idx("b") }),
+						   ct::Tensor("B", { idx("b"), idx("k"), idx("a") }));
+	ASSERT_EQ(cp::getTransposeCost(nonGemm, resolver), 10 * 10 * 100);
+
+	ct::BinaryTerm copy(ct::Tensor("O", { idx("j"), idx("i") }), 1.0, ct::Tensor("A", { idx("i"), idx("j") }));
+	ASSERT_EQ(cp::getTransposeCost(copy, resolver), 10 * 10);
+}
@@ -1,7 +1,11 @@
+#include "processor/LayoutCost.hpp"
 #include "processor/Simplifier.hpp"
+#include "terms/BinaryTerm.hpp"
 #include "terms/GeneralTerm.hpp"
 
 #include "terms/Tensor.hpp"
+#include "terms/TensorSubstitution.hpp"
+#include <optional>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -12,7 +16,7 @@
 namespace ct  = Contractor::Terms;
 namespace cpr = Contractor::Processor;
 
-ct::GeneralTerm createTerm(const std::vector< std::vector< ct::Index > > &indices,
+ct::GeneralTerm createTerm(const std::vector< ct::IndexList > &indices,
 						   ct::GeneralTerm::factor_t factor = 1) {
 	char tensorName = 'A';
 
@@ -194,6 +198,42 @@ TEST(SimplifierTest, canonicalizeIndexSequences) {
 	}
 }
 
+TEST(SimplifierTest, canonicalizeIndexSequencesForLayout) {
+	{
+		// Tensors without symmetry keep their index sequences
+		ct::BinaryTerm term(ct::Tensor("O", { idx("i"), idx("j") }), 1, ct::Tensor("A", { idx("k"), idx("i") }),
+							ct::Tensor("B", { idx("j"), idx("k") }));
+		ct::BinaryTerm expectedTerm = term;
+
+		ASSERT_FALSE(cpr::canonicalizeIndexSequences(term, resolver));
+		ASSERT_EQ(term, expectedTerm);
+	}
+	{
+		// O[ijl] = A[ik] B[jkl] can't be carried out as a GEMM without transposing B but B's antisymmetry in j <-> k
+		// allows to use B[kjl] instead
+		ct::Tensor B("B", { idx("j"), idx("k"), idx("l") });
+		B.accessSymmetry().addGenerator(ct::IndexSubstitution::createPermutation({ { idx("j"), idx("k") } }, -1));
+
+		ct::BinaryTerm term(ct::Tensor("O", { idx("i"), idx("j"), idx("l") }), 1,
+							ct::Tensor("A", { idx("i"), idx("k") }), B);
+
+		ASSERT_GT(cpr::getTransposeCost(term, resolver), 0);
+
+		ASSERT_TRUE(cpr::canonicalizeIndexSequences(term, resolver));
+
+		ct::Tensor expectedB = B;
+		ASSERT_EQ(expectedB.setIndexSequence({ idx("k"), idx("j"), idx("l") }), -1);
+		ct::BinaryTerm expectedTerm(term.getResult(), -1, ct::Tensor("A", { idx("i"), idx("k") }), expectedB);
+
+		ASSERT_EQ(term, expectedTerm);
+		ASSERT_EQ(cpr::getTransposeCost(term, resolver), 0);
+
+		// Reordering the indices once more doesn't change anything
+		cpr::canonicalizeIndexSequences(term, resolver);
+		ASSERT_EQ(term, expectedTerm);
+	}
+}
+
 TEST(SimplifierTest, simplifyTerms) {
 	{
 		// Two unrelated Terms -> nothing should change
@@ -409,4 +449,72 @@ TEST(SimplifierTest, simplifyCompositeTerms) {
 		ASSERT_EQ(composites.size(), 3);
 		ASSERT_THAT(composites, ::testing::UnorderedElementsAre(composite1, composite2, expectedResultComposite));
 	}
+	{
+		// Composites that are only related if the indices of the result Tensor are permuted
+		//
+		// - 1: {
+		//   H_T1[i⁺j⁺a⁻k⁻] += - H[i⁺j⁺a⁻b⁻] * T1[b⁺k⁻]
+		// }
+		// - 2: {
+		//   H_T1'[i⁺j⁺a⁻k⁻] += H[j⁺i⁺a⁻b⁻] * T1[b⁺k⁻]
+		// }
+		// - 3: {
+		//   O[i⁺j⁺a⁻k⁻] += H_T1'[i⁺j⁺a⁻k⁻]
+		// }
+		ct::Tensor H_T1("H_T1", { idx("i+"), idx("j+"), idx("a-"), idx("k-") });
+		ct::Tensor H_T1_prime("H_T1'", { idx("i+"), idx("j+"), idx("a-"), idx("k-") });
+		ct::Tensor T1("T1", { idx("b+"), idx("k-") });
+		ct::Tensor O("O", { idx("i+"), idx("j+"), idx("a-"), idx("k-") });
+
+		ct::GeneralCompositeTerm composite1(
+			ct::GeneralTerm(H_T1, -1, { ct::Tensor("H", { idx("i+"), idx("j+"), idx("a-"), idx("b-") }), T1 }));
+		ct::GeneralCompositeTerm composite2(
+			ct::GeneralTerm(H_T1_prime, 1, { ct::Tensor("H", { idx("j+"), idx("i+"), idx("a-"), idx("b-") }), T1 }));
+		ct::GeneralCompositeTerm composite3(ct::GeneralTerm(O, 1, { H_T1_prime }));
+
+		std::vector< ct::GeneralCompositeTerm > composites = { composite1, composite2, composite3 };
+
+		ASSERT_FALSE(composite2.isRelatedTo(composite1));
+
+		std::optional< ct::TensorSubstitution > relation = cpr::findPermutedRelation(composite2, composite1);
+
+		ASSERT_TRUE(relation.has_value());
+		// H_T1'[j⁺i⁺a⁻k⁻] = - H_T1[i⁺j⁺a⁻k⁻]
+		ASSERT_EQ(relation->getTensor(), ct::Tensor("H_T1'", { idx("j+"), idx("i+"), idx("a-"), idx("k-") }));
+		ASSERT_EQ(relation->getSubstitution(), H_T1);
+		ASSERT_EQ(relation->getFactor(), -1);
+
+		// The result Tensors of the composites can't be related to one another
+		ASSERT_FALSE(cpr::findPermutedRelation(composite3, composite1).has_value());
+
+		ct::GeneralCompositeTerm expectedResultComposite(
+			ct::GeneralTerm(O, -1, { ct::Tensor("H_T1", { idx("j+"), idx("i+"), idx("a-"), idx("k-") }) }));
+
+		bool changed = cpr::simplify(composites);
+
+		ASSERT_TRUE(changed);
+		ASSERT_THAT(composites, ::testing::ElementsAre(composite1, expectedResultComposite));
+	}
+	{
+		// Composites that only become related after another relation has been substituted. The remaining composites
+		// keep their original order.
+		ct::GeneralCompositeTerm composite1(ct::GeneralTerm(ct::Tensor("A"), 1, { ct::Tensor("K") }));
+		ct::GeneralCompositeTerm composite2(
+			ct::GeneralTerm(ct::Tensor("X"), 1, { ct::Tensor("A"), ct::Tensor("L") }));
+		ct::GeneralCompositeTerm composite3(ct::GeneralTerm(ct::Tensor("B"), 2, { ct::Tensor("K") }));
+		ct::GeneralCompositeTerm composite4(
+			ct::GeneralTerm(ct::Tensor("Y"), 1, { ct::Tensor("B"), ct::Tensor("L") }));
+		ct::GeneralCompositeTerm composite5(ct::GeneralTerm(ct::Tensor("Z"), 1, { ct::Tensor("Y") }));
+
+		std::vector< ct::GeneralCompositeTerm > composites = { composite1, composite2, composite3, composite4,
+															   composite5 };
+
+		// B = 2 * A and therefore Y = 2 * X
+		ct::GeneralCompositeTerm expectedResultComposite(ct::GeneralTerm(ct::Tensor("Z"), 2, { ct::Tensor("X") }));
+
+		bool changed = cpr::simplify(composites);
+
+		ASSERT_TRUE(changed);
+		ASSERT_THAT(composites, ::testing::ElementsAre(composite1, composite2, expectedResultComposite));
+	}
 }
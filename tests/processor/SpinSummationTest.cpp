@@ -23,7 +23,7 @@ namespace cp = Contractor::Processor;
 // have to be transformed into spin-free indices as well. Same goes for contraction indices. This can lead to weird
 // looking terms that have to be "unmapped" to their original form in order to recognize their validity.
 
-ct::Tensor createAntisymmetricTensor(std::string_view name, const std::vector< ct::Index > &indices,
+ct::Tensor createAntisymmetricTensor(std::string_view name, const ct::IndexList &indices,
 									 bool fullyAntisymmetric) {
 	ct::Tensor tensor(name, indices);
 	if (indices.size() != 4) {
@@ -0,0 +1,210 @@
+#include "terms/CanonicalLabelling.hpp"
+#include "terms/GeneralTerm.hpp"
+#include "terms/IndexSubstitution.hpp"
+#include "terms/Tensor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "IndexHelper.hpp"
+
+namespace ct = Contractor::Terms;
+
+static ct::Tensor antisymmetricTensor(std::string_view name, const ct::IndexList &indices) {
+	// Exchanging the first two indices yields a factor of -1
+	ct::Tensor tensor(name, indices);
+	tensor.accessSymmetry().addGenerator(
+		ct::IndexSubstitution::createPermutation({ { tensor.getIndices()[0], tensor.getIndices()[1] } }, -1));
+
+	return tensor;
+}
+
+static ct::Tensor doublyAntisymmetricTensor(std::string_view name, const ct::IndexList &indices) {
+	// Exchanging the first two or the last two indices yields a factor of -1
+	ct::Tensor tensor = antisymmetricTensor(name, indices);
+	tensor.accessSymmetry().addGenerator(
+		ct::IndexSubstitution::createPermutation({ { tensor.getIndices()[2], tensor.getIndices()[3] } }, -1));
+
+	return tensor;
+}
+
+static ct::Tensor pairSymmetricTensor(std::string_view name, const ct::IndexList &indices) {
+	// Exchanging the first two and the last two indices at the same time leaves the Tensor unchanged
+	ct::Tensor tensor(name, indices);
+	tensor.accessSymmetry().addGenerator(ct::IndexSubstitution::createPermutation(
+		{ { tensor.getIndices()[0], tensor.getIndices()[1] }, { tensor.getIndices()[2], tensor.getIndices()[3] } }, 1));
+
+	return tensor;
+}
+
+static void assertEquivalent(const ct::GeneralTerm &lhs, const ct::GeneralTerm &rhs, ct::Term::factor_t factor) {
+	const ct::CanonicalLabelling lhsLabelling(lhs);
+	const ct::CanonicalLabelling rhsLabelling(rhs);
+
+	ASSERT_EQ(lhsLabelling.getKey(), rhsLabelling.getKey());
+	ASSERT_EQ(lhsLabelling.getHash(), rhsLabelling.getHash());
+
+	ct::GeneralTerm canonicalLhs = lhs;
+	ct::GeneralTerm canonicalRhs = rhs;
+	lhsLabelling.apply(canonicalLhs);
+	rhsLabelling.apply(canonicalRhs);
+
+	ASSERT_EQ(canonicalLhs.getResult(), canonicalRhs.getResult());
+	ASSERT_TRUE(std::equal(canonicalLhs.getTensors().begin(), canonicalLhs.getTensors().end(),
+						   canonicalRhs.getTensors().begin(), canonicalRhs.getTensors().end()))
+		<< canonicalLhs << " vs. " << canonicalRhs;
+
+	ASSERT_EQ(canonicalLhs.getPrefactor(), lhs.getPrefactor() * lhsLabelling.getFactor());
+	ASSERT_EQ(canonicalRhs.getPrefactor(), rhs.getPrefactor() * rhsLabelling.getFactor());
+	ASSERT_EQ(canonicalLhs.getPrefactor() * factor, canonicalRhs.getPrefactor());
+}
+
+TEST(CanonicalLabellingTest, tensorOrderAndIndexNames) {
+	const ct::Tensor result("R", { idx("i+"), idx("a-") });
+
+	const ct::GeneralTerm term(result, 1,
+							   { ct::Tensor("H", { idx("i+"), idx("b-") }), ct::Tensor("T", { idx("b+"), idx("j-") }),
+								 ct::Tensor("U", { idx("j+"), idx("a-") }) });
+	const ct::GeneralTerm reordered(result, 1,
+									{ ct::Tensor("U", { idx("k+"), idx("a-") }),
+									  ct::Tensor("H", { idx("i+"), idx("c-") }),
+									  ct::Tensor("T", { idx("c+"), idx("k-") }) });
+
+	assertEquivalent(term, reordered, 1);
+
+	// Connecting the Tensors differently yields a different key
+	const ct::GeneralTerm other(result, 1,
+								{ ct::Tensor("H", { idx("j+"), idx("b-") }), ct::Tensor("T", { idx("b+"), idx("j-") }),
+								  ct::Tensor("U", { idx("i+"), idx("a-") }) });
+
+	ASSERT_NE(ct::CanonicalLabelling(term).getKey(), ct::CanonicalLabelling(other).getKey());
+}
+
+TEST(CanonicalLabellingTest, symmetry) {
+	const ct::Tensor result("R", { idx("i+"), idx("j+") });
+
+	const ct::GeneralTerm term(result, 1,
+							   { antisymmetricTensor("H", { idx("i+"), idx("j+"), idx("a-"), idx("b-") }),
+								 ct::Tensor("T", { idx("a+") }), ct::Tensor("T", { idx("b+") }) });
+	const ct::GeneralTerm permuted(result, 2,
+								   { antisymmetricTensor("H", { idx("j+"), idx("i+"), idx("c-"), idx("a-") }),
+									 ct::Tensor("T", { idx("a+") }), ct::Tensor("T", { idx("c+") }) });
+
+	assertEquivalent(term, permuted, -2);
+
+	// Without the symmetry, the Terms are no longer equivalent
+	const ct::GeneralTerm unsymmetric(result, 1,
+									  { ct::Tensor("H", { idx("j+"), idx("i+"), idx("c-"), idx("a-") }),
+										ct::Tensor("T", { idx("a+") }), ct::Tensor("T", { idx("c+") }) });
+
+	ASSERT_NE(ct::CanonicalLabelling(term).getKey(), ct::CanonicalLabelling(unsymmetric).getKey());
+}
+
+TEST(CanonicalLabellingTest, closedNetwork) {
+	// The two ways of contracting B with T1 in the CC2 energy
+	const ct::Tensor result("E", {});
+
+	const ct::GeneralTerm term(result, -0.5,
+							   { ct::Tensor("B", { idx("i+"), idx("a-"), idx("q!") }),
+								 ct::Tensor("B", { idx("j+"), idx("b-"), idx("q!") }),
+								 ct::Tensor("T1", { idx("b+"), idx("i-") }),
+								 ct::Tensor("T1", { idx("a+"), idx("j-") }) });
+	const ct::GeneralTerm renamed(result, -0.5,
+								  { ct::Tensor("T1", { idx("c+"), idx("k-") }),
+									ct::Tensor("B", { idx("k+"), idx("d-"), idx("r!") }),
+									ct::Tensor("T1", { idx("d+"), idx("l-") }),
+									ct::Tensor("B", { idx("l+"), idx("c-"), idx("r!") }) });
+
+	assertEquivalent(term, renamed, 1);
+
+	// Closing the loop differently gives a different network
+	const ct::GeneralTerm disconnected(result, -0.5,
+									   { ct::Tensor("B", { idx("i+"), idx("a-"), idx("q!") }),
+										 ct::Tensor("B", { idx("j+"), idx("b-"), idx("q!") }),
+										 ct::Tensor("T1", { idx("a+"), idx("i-") }),
+										 ct::Tensor("T1", { idx("b+"), idx("j-") }) });
+
+	ASSERT_NE(ct::CanonicalLabelling(term).getKey(), ct::CanonicalLabelling(disconnected).getKey());
+}
+
+TEST(CanonicalLabellingTest, tiedChoices) {
+	// Every index sequence of H yields the same encoding, but only some of them allow for the smallest encoding of T
+	const ct::Tensor result("E", {});
+
+	const ct::GeneralTerm term(result, 0.125,
+							   { doublyAntisymmetricTensor("H", { idx("i+"), idx("j+"), idx("a-"), idx("b-") }),
+								 pairSymmetricTensor("T", { idx("a+"), idx("b+"), idx("i-"), idx("j-") }) });
+	const ct::GeneralTerm permuted(result, 0.125,
+								   { doublyAntisymmetricTensor("H", { idx("i+"), idx("j+"), idx("a-"), idx("b-") }),
+									 pairSymmetricTensor("T", { idx("a+"), idx("b+"), idx("j-"), idx("i-") }) });
+
+	assertEquivalent(term, permuted, -1);
+}
+
+TEST(CanonicalLabellingTest, symmetryDescription) {
+	// Both versions of H have a symmetry group of order 2, but the groups act on different slots
+	const ct::Tensor result("E", {});
+
+	ct::Tensor otherH("H", { idx("i+"), idx("j+"), idx("a-"), idx("b-") });
+	otherH.accessSymmetry().addGenerator(ct::IndexSubstitution::createPermutation({ { idx("a-"), idx("b-") } }, -1));
+
+	const ct::GeneralTerm term(result, 1,
+							   { antisymmetricTensor("H", { idx("i+"), idx("j+"), idx("a-"), idx("b-") }),
+								 ct::Tensor("T", { idx("a+"), idx("b+"), idx("i-"), idx("j-") }) });
+	const ct::GeneralTerm other(result, 1, { otherH, ct::Tensor("T", { idx("a+"), idx("b+"), idx("i-"), idx("j-") }) });
+
+	ASSERT_NE(ct::CanonicalLabelling(term).getKey(), ct::CanonicalLabelling(other).getKey());
+}
+
+TEST(CanonicalLabellingTest, options) {
+	const ct::GeneralTerm term(ct::Tensor("R", { idx("i+"), idx("j-") }), 1,
+							   { ct::Tensor("A", { idx("i+"), idx("a-") }), ct::Tensor("B", { idx("a+"), idx("j-") }) });
+	const ct::GeneralTerm renamed(
+		ct::Tensor("R", { idx("i+"), idx("j-") }), 1,
+		{ ct::Tensor("X", { idx("i+"), idx("a-") }), ct::Tensor("Y", { idx("a+"), idx("j-") }) });
+
+	ct::CanonicalLabelling::Options withoutNames;
+	withoutNames.names = false;
+
+	ASSERT_NE(ct::CanonicalLabelling(term).getKey(), ct::CanonicalLabelling(renamed).getKey());
+	ASSERT_EQ(ct::CanonicalLabelling(term, withoutNames).getKey(),
+			  ct::CanonicalLabelling(renamed, withoutNames).getKey());
+
+	// The same contraction, but with the indices of the result exchanged
+	const ct::Tensor pairResult("R", { idx("i+"), idx("j+") });
+	const ct::GeneralTerm pair(pairResult, 1,
+							   { ct::Tensor("A", { idx("i+"), idx("a-") }), ct::Tensor("B", { idx("j+"), idx("a+") }) });
+	const ct::GeneralTerm exchanged(
+		pairResult, 1, { ct::Tensor("A", { idx("j+"), idx("a-") }), ct::Tensor("B", { idx("i+"), idx("a+") }) });
+
+	ct::CanonicalLabelling::Options withoutPositions;
+	withoutPositions.resultPositions = false;
+
+	ASSERT_NE(ct::CanonicalLabelling(pair).getKey(), ct::CanonicalLabelling(exchanged).getKey());
+	ASSERT_EQ(ct::CanonicalLabelling(pair, withoutPositions).getKey(),
+			  ct::CanonicalLabelling(exchanged, withoutPositions).getKey());
+}
+
+TEST(CanonicalLabellingTest, order) {
+	const ct::Tensor result("R", { idx("i+"), idx("l-") });
+
+	const ct::GeneralTerm term(result, 1,
+							   { ct::Tensor("A", { idx("i+"), idx("j-") }), ct::Tensor("B", { idx("j+"), idx("k-") }),
+								 ct::Tensor("C", { idx("k+"), idx("l-") }) });
+	const ct::GeneralTerm reversed(result, 1,
+								   { ct::Tensor("C", { idx("k+"), idx("l-") }),
+									 ct::Tensor("B", { idx("j+"), idx("k-") }),
+									 ct::Tensor("A", { idx("i+"), idx("j-") }) });
+
+	const ct::CanonicalLabelling termLabelling(term);
+	const ct::CanonicalLabelling reversedLabelling(reversed);
+
+	ASSERT_EQ(termLabelling.getOrder().size(), 3);
+	ASSERT_EQ(reversedLabelling.getOrder().size(), 3);
+
+	for (std::size_t i = 0; i < 3; ++i) {
+		ASSERT_EQ(term.getTensors()[termLabelling.getOrder()[i]],
+				  reversed.getTensors()[reversedLabelling.getOrder()[i]]);
+	}
+}
@@ -0,0 +1,81 @@
+#include "terms/CostPolynomial.hpp"
+#include "terms/IndexSpace.hpp"
+#include "terms/IndexSpaceMeta.hpp"
+#include "utils/IndexSpaceResolver.hpp"
+
+#include <gtest/gtest.h>
+
+#include <unordered_map>
+
+namespace ct = Contractor::Terms;
+namespace cu = Contractor::Utils;
+
+TEST(CostPolynomialTest, construction) {
+	ct::CostPolynomial zero;
+	ASSERT_TRUE(zero.isZero());
+	ASSERT_EQ(zero.getDegree(), 0);
+
+	ct::IndexSpace first(0);
+	ct::IndexSpace third(2);
+
+	ct::CostPolynomial monomial({ { first, 2 }, { third, 1 } }, 3);
+	ASSERT_FALSE(monomial.isZero());
+	ASSERT_EQ(monomial.getDegree(), 3);
+	ASSERT_EQ(monomial.getMonomials().size(), 1);
+	ASSERT_EQ(monomial.getMonomials().begin()->first, ct::CostPolynomial::exponent_list_t({ 2, 0, 1 }));
+	ASSERT_EQ(monomial.getMonomials().begin()->second, 3);
+
+	// Zero exponents don't matter
+	ASSERT_EQ(ct::CostPolynomial({ { first, 2 }, { ct::IndexSpace(1), 0 }, { third, 1 } }, 3), monomial);
+
+	// A zero coefficient yields the zero polynomial
+	ASSERT_EQ(ct::CostPolynomial({ { first, 2 } }, 0), zero);
+
+	// A monomial without any exponents is a constant
+	ct::CostPolynomial constant({}, 5);
+	ASSERT_EQ(constant.getDegree(), 0);
+	ASSERT_EQ(constant.evaluate(ct::CostPolynomial::size_point_t{}), 5);
+}
+
+TEST(CostPolynomialTest, addition) {
+	ct::IndexSpace first(0);
+	ct::IndexSpace second(1);
+
+	ct::CostPolynomial polynomial({ { first, 2 }, { second, 1 } });
+	polynomial += ct::CostPolynomial({ { first, 1 }, { second, 2 } });
+	polynomial += ct::CostPolynomial({ { first, 2 }, { second, 1 } });
+
+	ASSERT_EQ(polynomial.getMonomials().size(), 2);
+	ASSERT_EQ(polynomial.getMonomials().at({ 2, 1 }), 2);
+	ASSERT_EQ(polynomial.getMonomials().at({ 1, 2 }), 1);
+	ASSERT_EQ(polynomial.getDegree(), 3);
+
+	ct::CostPolynomial sum =
+		ct::CostPolynomial({ { first, 2 }, { second, 1 } }, 2) + ct::CostPolynomial({ { first, 1 }, { second, 2 } });
+	ASSERT_EQ(sum, polynomial);
+	ASSERT_NE(ct::CostPolynomial({ { first, 2 }, { second, 1 } }, 2), polynomial);
+}
+
+TEST(CostPolynomialTest, evaluate) {
+	cu::IndexSpaceResolver resolver({
+		ct::IndexSpaceMeta("virtual", 'P', 100, ct::Index::Spin::Both),
+		ct::IndexSpaceMeta("occupied", 'H', 10, ct::Index::Spin::Both),
+	});
+
+	ct::IndexSpace virt = resolver.resolve("virtual");
+	ct::IndexSpace occ  = resolver.resolve("occupied");
+
+	// 2 N_P^4 N_H^2 + N_P^3 N_H^3
+	ct::CostPolynomial polynomial({ { virt, 4 }, { occ, 2 } }, 2);
+	polynomial += ct::CostPolynomial({ { virt, 3 }, { occ, 3 } });
+
+	ASSERT_EQ(polynomial.evaluate(resolver), 2 * 10000000000ULL + 1000000000ULL);
+
+	ct::CostPolynomial::size_point_t sizes = ct::CostPolynomial::getSizePoint(resolver);
+	ASSERT_EQ(polynomial.evaluate(sizes), polynomial.evaluate(resolver));
+
+	// The same polynomial evaluated at different sizes
+	sizes[virt.getID()] = 10;
+	sizes[occ.getID()]  = 100;
+	ASSERT_EQ(polynomial.evaluate(sizes), 2 * 10000 * 10000 + 1000 * 1000000);
+}
@@ -0,0 +1,112 @@
+#include "terms/Cost.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace ct = Contractor::Terms;
+
+TEST(CostTest, arithmetic) {
+	ct::Cost cost = 5;
+	cost += 10;
+	ASSERT_EQ(cost, 15);
+	cost *= 4;
+	ASSERT_EQ(cost, 60);
+	cost -= 20;
+	ASSERT_EQ(cost, 40);
+
+	ASSERT_EQ(cost + 2, 42);
+	ASSERT_EQ(2 * cost, 80);
+	ASSERT_EQ(cost - cost, 0);
+	ASSERT_EQ(cost / 3, 13);
+	ASSERT_EQ(cost / cost, 1);
+	ASSERT_EQ(pow(cost, 0), 1);
+	ASSERT_EQ(pow(cost, 3), 64000);
+
+	ASSERT_LT(cost, 41);
+	ASSERT_GT(cost, 39);
+	ASSERT_LE(cost, 40);
+	ASSERT_GE(cost, 40);
+	ASSERT_NE(cost, 41);
+
+	ASSERT_THROW(ct::Cost(-1), std::range_error);
+	ASSERT_THROW(cost / 0, std::overflow_error);
+}
+
+TEST(CostTest, overflow) {
+	// The biggest number whose square still fits into the native representation
+	const ct::Cost big((ct::Cost::multiprecision_t(1) << (ct::Cost::nativeBits / 2)) - 1);
+	ASSERT_TRUE(big.isNative());
+
+	ct::Cost square = big * big;
+	ASSERT_TRUE(square.isNative());
+	ASSERT_EQ(square.str(), (big.toMultiprecision() * big.toMultiprecision()).str());
+	if (ct::Cost::nativeBits == 128) {
+		ASSERT_EQ(square.str(), "340282366920938463426481119284349108225");
+	}
+
+	// Anything bigger requires the multiprecision representation
+	ct::Cost cube = square * big;
+	ASSERT_FALSE(cube.isNative());
+	ASSERT_EQ(cube.str(), (square.toMultiprecision() * big.toMultiprecision()).str());
+	ASSERT_EQ(cube.toMultiprecision(), square.toMultiprecision() * big.toMultiprecision());
+
+	// Multiplying by built-in integers overflows the same way
+	ct::Cost product = square;
+	product *= big.convert_to< std::uint64_t >();
+	ASSERT_FALSE(product.isNative());
+	ASSERT_EQ(product, cube);
+	product = big;
+	product *= big.convert_to< std::uint64_t >();
+	ASSERT_TRUE(product.isNative());
+	ASSERT_EQ(product, square);
+
+	ct::Cost sum = square + square + square;
+	ASSERT_FALSE(sum.isNative());
+	ASSERT_EQ(sum.toMultiprecision(), 3 * square.toMultiprecision());
+
+	// Values that fit into the native representation again use it
+	sum -= square;
+	sum -= square;
+	ASSERT_TRUE(sum.isNative());
+	ASSERT_EQ(sum, square);
+
+	ASSERT_EQ(cube / big, square);
+	ASSERT_TRUE((cube / big).isNative());
+	ASSERT_EQ(cube / cube, 1);
+
+	// Comparisons work across representations
+	ASSERT_LT(square, cube);
+	ASSERT_GT(cube, square);
+	ASSERT_NE(square, cube);
+	ASSERT_LT(cube, cube + 1);
+	ASSERT_EQ(cube, ct::Cost(cube.toMultiprecision()));
+
+	ct::Cost copy = cube;
+	ASSERT_EQ(copy, cube);
+	copy = square;
+	ASSERT_EQ(copy, square);
+	ASSERT_TRUE(copy.isNative());
+
+	ASSERT_EQ(std::numeric_limits< ct::Cost >::max().toMultiprecision(),
+			  std::numeric_limits< ct::Cost::multiprecision_t >::max());
+	ASSERT_LT(cube, std::numeric_limits< ct::Cost >::max());
+}
+
+TEST(CostTest, conversion) {
+	ASSERT_EQ(ct::Cost(0).str(), "0");
+	ASSERT_EQ(ct::Cost(1234567).str(), "1234567");
+
+	ASSERT_EQ(ct::Cost(std::string("1234567")), 1234567);
+	const std::string hugeNumber = "123456789012345678901234567890123456789012345678901234567890";
+	ASSERT_EQ(ct::Cost(hugeNumber).str(), hugeNumber);
+	ASSERT_FALSE(ct::Cost(hugeNumber).isNative());
+
+	ASSERT_THROW(ct::Cost(std::string("12abc")), std::runtime_error);
+
+	ASSERT_DOUBLE_EQ(ct::Cost(1000).convert_to< double >(), 1000.0);
+	ASSERT_DOUBLE_EQ(ct::Cost(hugeNumber).convert_to< double >(), 1.2345678901234568e59);
+}
@@ -151,7 +151,7 @@ TEST(IndexSubstitutionTest, appliesTo) {
 }
 
 TEST(IndexSubstitutionTest, multiply) {
-	std::vector< ct::Index > indices = { idx("i+"), idx("j+"), idx("a"), idx("b") };
+	ct::IndexList indices = { idx("i+"), idx("j+"), idx("a"), idx("b") };
 
 	{
 		// i->j and j->i (== exchange i and j)
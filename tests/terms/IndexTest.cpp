@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+
 namespace ct = Contractor::Terms;
 
 TEST(IndexTest, getter) {
@@ -119,3 +121,41 @@ TEST(IndexTest, move) {
 
 	ASSERT_EQ(copy, moved);
 }
+
+TEST(IndexTest, ordering) {
+	const ct::Index creator(ct::IndexSpace(1), 3, ct::Index::Type::Creator, ct::Index::Spin::Both);
+	const ct::Index annihilator(ct::IndexSpace(0), 0, ct::Index::Type::Annihilator, ct::Index::Spin::None);
+	const ct::Index occupied(ct::IndexSpace(0), 5, ct::Index::Type::Annihilator, ct::Index::Spin::Alpha);
+	const ct::Index virtualIndex(ct::IndexSpace(1), 0, ct::Index::Type::Annihilator, ct::Index::Spin::None);
+	const ct::Index beta(ct::IndexSpace(0), 1, ct::Index::Type::Annihilator, ct::Index::Spin::Beta);
+
+	// Indices are ordered by type, then by space, then by spin and finally by ID
+	ASSERT_LT(creator, annihilator);
+	ASSERT_LT(annihilator, occupied);
+	ASSERT_LT(occupied, beta);
+	ASSERT_LT(beta, virtualIndex);
+	ASSERT_FALSE(virtualIndex < virtualIndex);
+}
+
+TEST(IndexTest, hashing) {
+	const ct::Index creator(ct::IndexSpace(2), 7, ct::Index::Type::Creator, ct::Index::Spin::Alpha);
+	const ct::Index annihilator(ct::IndexSpace(2), 7, ct::Index::Type::Annihilator, ct::Index::Spin::Alpha);
+	const ct::Index beta(ct::IndexSpace(2), 7, ct::Index::Type::Annihilator, ct::Index::Spin::Beta);
+
+	ASSERT_EQ(ct::Index::type_insensitive_hasher{}(creator), ct::Index::type_insensitive_hasher{}(annihilator));
+	ASSERT_NE(ct::Index::type_insensitive_hasher{}(annihilator), ct::Index::type_insensitive_hasher{}(beta));
+	ASSERT_EQ(ct::Index::type_and_spin_insensitive_hasher{}(creator),
+			  ct::Index::type_and_spin_insensitive_hasher{}(beta));
+	ASSERT_TRUE(ct::Index::index_has_same_name{}(creator, beta));
+	ASSERT_FALSE(ct::Index::index_has_same_name{}(creator, ct::Index(ct::IndexSpace(2), 6)));
+}
+
+TEST(IndexTest, range) {
+	ASSERT_THROW(ct::Index(ct::IndexSpace(0), 1 << 16), std::out_of_range);
+	ASSERT_THROW(ct::Index(ct::IndexSpace(1 << 12), 0), std::out_of_range);
+
+	ct::Index index(ct::IndexSpace(0), (1 << 16) - 1);
+	ASSERT_EQ(index.getID(), (1 << 16) - 1);
+	ASSERT_EQ(index.getID(), ct::Index::maxID);
+	ASSERT_THROW(index.setID(ct::Index::maxID + 1), std::out_of_range);
+}
@@ -3,6 +3,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
 #include "IndexHelper.hpp"
@@ -10,7 +12,7 @@
 namespace ct = Contractor::Terms;
 
 TEST(PermutationGroupTest, contains) {
-	std::vector< ct::Index > startSequence = { idx("i+"), idx("j+"), idx("a"), idx("b") };
+	ct::IndexList startSequence = { idx("i+"), idx("j+"), idx("a"), idx("b") };
 
 	const ct::IndexSubstitution identity;
 
@@ -28,7 +30,7 @@ TEST(PermutationGroupTest, contains) {
 		ct::IndexSubstitution sym = ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } });
 		group.addGenerator(sym);
 
-		std::vector< ct::Index > permutation = startSequence;
+		ct::IndexList permutation = startSequence;
 		sym.apply(permutation);
 
 		ASSERT_TRUE(group.contains(startSequence));
@@ -50,9 +52,9 @@ TEST(PermutationGroupTest, contains) {
 		ASSERT_TRUE((generator * implicitSym01).isIdentity());
 		ASSERT_NE(implicitSym01, generator);
 
-		std::vector< ct::Index > permutation01 = startSequence;
+		ct::IndexList permutation01 = startSequence;
 		generator.apply(permutation01);
-		std::vector< ct::Index > permutation02 = startSequence;
+		ct::IndexList permutation02 = startSequence;
 		implicitSym01.apply(permutation02);
 
 		ASSERT_TRUE(group.contains(startSequence));
@@ -78,11 +80,11 @@ TEST(PermutationGroupTest, contains) {
 		ASSERT_EQ(implicitSym01,
 				  ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") }, { idx("a"), idx("b") } }, +1));
 
-		std::vector< ct::Index > permutation01 = startSequence;
+		ct::IndexList permutation01 = startSequence;
 		generator01.apply(permutation01);
-		std::vector< ct::Index > permutation02 = startSequence;
+		ct::IndexList permutation02 = startSequence;
 		generator02.apply(permutation02);
-		std::vector< ct::Index > permutation03 = startSequence;
+		ct::IndexList permutation03 = startSequence;
 		implicitSym01.apply(permutation03);
 
 		ASSERT_TRUE(group.contains(startSequence));
@@ -98,7 +100,7 @@ TEST(PermutationGroupTest, contains) {
 }
 
 TEST(PermutationGroupTest, equality) {
-	std::vector< ct::Index > sequence = { idx("i+"), idx("j+"), idx("a"), idx("b") };
+	ct::IndexList sequence = { idx("i+"), idx("j+"), idx("a"), idx("b") };
 
 	{
 		ct::PermutationGroup first;
@@ -113,7 +115,7 @@ TEST(PermutationGroupTest, equality) {
 		ASSERT_EQ(first, second);
 	}
 	{
-		std::vector< ct::Index > otherSequence = { idx("j+"), idx("i+"), idx("a"), idx("b") };
+		ct::IndexList otherSequence = { idx("j+"), idx("i+"), idx("a"), idx("b") };
 		ct::PermutationGroup first(sequence);
 		ct::PermutationGroup second(otherSequence);
 
@@ -122,7 +124,7 @@ TEST(PermutationGroupTest, equality) {
 	{
 		// Here the symmetry operation allows transformation between sequence and otherSequence and therefore
 		// both groups are the same again
-		std::vector< ct::Index > otherSequence = { idx("j+"), idx("i+"), idx("a"), idx("b") };
+		ct::IndexList otherSequence = { idx("j+"), idx("i+"), idx("a"), idx("b") };
 		ct::IndexSubstitution sym              = ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } });
 		ct::PermutationGroup first(sequence);
 		first.addGenerator(sym);
@@ -141,7 +143,7 @@ TEST(PermutationGroupTest, equality) {
 		ASSERT_EQ(particleOneTwoSym * asymm1, asymm2);
 		ASSERT_EQ(particleOneTwoSym * asymm2, asymm1);
 
-		std::vector< ct::Index > otherSequence = { idx("j+"), idx("i+"), idx("b"), idx("a") };
+		ct::IndexList otherSequence = { idx("j+"), idx("i+"), idx("b"), idx("a") };
 
 		ct::PermutationGroup first(sequence);
 		first.addGenerator(asymm1);
@@ -153,3 +155,207 @@ TEST(PermutationGroupTest, equality) {
 		ASSERT_EQ(first, second);
 	}
 }
+
+TEST(PermutationGroupTest, largeGroups) {
+	// A fully antisymmetric Tensor with 8 indices has 8! index permutations
+	ct::IndexList sequence = { idx("a"), idx("b"), idx("c"), idx("d"), idx("e"), idx("f"), idx("g"), idx("h") };
+
+	ct::PermutationGroup group(sequence);
+	group.addGenerator(ct::IndexSubstitution::createPermutation({ { idx("a"), idx("b") } }, -1));
+	group.addGenerator(ct::IndexSubstitution::createCyclicPermutation(sequence, -1));
+
+	ASSERT_EQ(group.size(), 40320);
+	ASSERT_EQ(group.getGenerators().size(), 3);
+
+	// Exchanging any two indices is contained with a factor of -1
+	ASSERT_TRUE(group.contains(ct::IndexSubstitution::createPermutation({ { idx("c"), idx("h") } }, -1)));
+	ASSERT_FALSE(group.contains(ct::IndexSubstitution::createPermutation({ { idx("c"), idx("h") } }, 1)));
+	ASSERT_TRUE(
+		group.contains(ct::IndexSubstitution::createPermutation({ { idx("c"), idx("h") }, { idx("a"), idx("e") } })));
+
+	// Reversing the sequence involves 4 exchanges
+	ct::IndexList reversed(sequence.rbegin(), sequence.rend());
+	ASSERT_TRUE(group.contains(reversed));
+
+	ct::PermutationGroup reversedGroup(reversed);
+	reversedGroup.addGenerator(ct::IndexSubstitution::createPermutation({ { idx("g"), idx("h") } }, -1));
+	reversedGroup.addGenerator(ct::IndexSubstitution::createCyclicPermutation(reversed, -1));
+
+	ASSERT_EQ(reversedGroup.getCanonicalRepresentation(), sequence);
+	ASSERT_EQ(reversedGroup.getCanonicalRepresentationFactor(), 1);
+	ASSERT_EQ(group, reversedGroup);
+	ASSERT_EQ(std::hash< ct::PermutationGroup >{}(group), std::hash< ct::PermutationGroup >{}(reversedGroup));
+
+	// Swapping the first two indices of the sequence leads to the canonical sequence with a factor of -1
+	ct::IndexList swapped = sequence;
+	std::swap(swapped[0], swapped[1]);
+	reversedGroup.setRootSequence(swapped);
+
+	ASSERT_EQ(reversedGroup.getCanonicalRepresentation(), sequence);
+	ASSERT_EQ(reversedGroup.getCanonicalRepresentationFactor(), -1);
+}
+
+TEST(PermutationGroupTest, indexPermutations) {
+	// Antisymmetry with respect to i<->j and particle-exchange symmetry (ia)<->(jb)
+	ct::IndexList sequence = { idx("j+"), idx("i+"), idx("b"), idx("a") };
+
+	ct::PermutationGroup group(sequence);
+	group.addGenerator(ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } }, -1));
+	group.addGenerator(ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") }, { idx("a"), idx("b") } }));
+
+	const std::vector< ct::PermutationGroup::Element > permutations = group.getIndexPermutations();
+
+	ASSERT_EQ(permutations.size(), group.size());
+	ASSERT_EQ(group.size(), 4);
+	ASSERT_EQ(permutations[0].indexSequence, group.getCanonicalRepresentation());
+	ASSERT_TRUE(std::is_sorted(permutations.begin(), permutations.end()));
+
+	for (const ct::PermutationGroup::Element &currentElement : permutations) {
+		ASSERT_TRUE(group.contains(currentElement.indexSequence));
+	}
+
+	const ct::IndexList canonical = { idx("i+"), idx("j+"), idx("a"), idx("b") };
+	ASSERT_EQ(group.getCanonicalRepresentation(), canonical);
+	// (ji)(ba) -> (ij)(ab) is the particle exchange with a factor of +1
+	ASSERT_EQ(group.getCanonicalRepresentationFactor(), 1);
+
+	const ct::IndexList swappedOccupied = { idx("i+"), idx("j+"), idx("b"), idx("a") };
+	ASSERT_EQ(std::count_if(permutations.begin(), permutations.end(),
+							[&](const ct::PermutationGroup::Element &current) {
+								return current.indexSequence == swappedOccupied && current.factor == -1;
+							}),
+			  1);
+	ASSERT_EQ(group.getAdditionalSymmetryOperations().size(), 1);
+}
+
+TEST(PermutationGroupTest, copiesAndRootChanges) {
+	ct::IndexList sequence = { idx("i+"), idx("j+"), idx("a"), idx("b") };
+	ct::IndexSubstitution antisymmetry = ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } }, -1);
+	ct::IndexSubstitution columnSymmetry =
+		ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") }, { idx("a"), idx("b") } });
+
+	ct::PermutationGroup original(sequence);
+	original.addGenerator(antisymmetry);
+
+	// Extending a copy must not affect the group it has been copied from
+	ct::PermutationGroup copy = original;
+	copy.addGenerator(columnSymmetry);
+
+	ASSERT_EQ(original.size(), 2);
+	ASSERT_EQ(copy.size(), 4);
+	ASSERT_FALSE(original.contains(columnSymmetry));
+	ASSERT_TRUE(copy.contains(columnSymmetry));
+	ASSERT_NE(original, copy);
+
+	// The generators are expressed in terms of the indices of the root sequence
+	ASSERT_EQ(original.getGenerators(),
+			  std::vector< ct::IndexSubstitution >({ ct::IndexSubstitution::identity(), antisymmetry }));
+
+	// Changing the root sequence to a permutation of the previous one doesn't change the operations in the group
+	ct::IndexList permuted = { idx("a"), idx("j+"), idx("b"), idx("i+") };
+	copy.setRootSequence(permuted);
+
+	ASSERT_EQ(copy.size(), 4);
+	ASSERT_TRUE(copy.contains(antisymmetry));
+	ASSERT_TRUE(copy.contains(columnSymmetry));
+	ASSERT_FALSE(copy.contains(ct::IndexSubstitution::createPermutation({ { idx("a"), idx("b") } }, 1)));
+
+	ct::IndexList reachable = permuted;
+	antisymmetry.apply(reachable);
+	ASSERT_TRUE(copy.contains(reachable));
+	ASSERT_FALSE(copy.contains(sequence));
+
+	// Groups with the same symmetry on different indices are not the same
+	ct::IndexList otherSequence = { idx("k+"), idx("l+"), idx("c"), idx("d") };
+	ct::PermutationGroup other(otherSequence);
+	other.addGenerator(ct::IndexSubstitution::createPermutation({ { idx("k"), idx("l") } }, -1));
+
+	ASSERT_EQ(other.size(), original.size());
+	ASSERT_NE(other, original);
+}
+
+TEST(PermutationGroupTest, factorsAndMinimalElements) {
+	ct::IndexList sequence = { idx("i+"), idx("j+"), idx("a"), idx("b") };
+
+	ct::PermutationGroup group(sequence);
+	group.addGenerator(ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } }, -1));
+	group.addGenerator(ct::IndexSubstitution::createPermutation({ { idx("a"), idx("b") } }, -1));
+
+	const std::vector< ct::PermutationGroup::Element > permutations = group.getIndexPermutations();
+	ASSERT_EQ(permutations.size(), 4);
+
+	for (const ct::PermutationGroup::Element &currentElement : permutations) {
+		ASSERT_EQ(group.getFactor(currentElement.indexSequence), currentElement.factor);
+	}
+
+	ASSERT_FALSE(group.getFactor({ idx("a"), idx("j+"), idx("i+"), idx("b") }).has_value());
+	ASSERT_FALSE(group.getFactor({ idx("i+"), idx("j+"), idx("a") }).has_value());
+
+	// If all indices are considered equal, every element of the group is minimal
+	std::vector< ct::PermutationGroup::Element > minimal =
+		group.getMinimalElements([](const ct::IndexList &, std::size_t) { return std::uint64_t(0); });
+	std::sort(minimal.begin(), minimal.end());
+	ASSERT_EQ(minimal, permutations);
+
+	// Prefer j and b over the other indices: there is exactly one such sequence
+	auto preferJB = [](const ct::IndexList &current, std::size_t slot) {
+		return std::uint64_t(current[slot] == idx("j+") || current[slot] == idx("b") ? 0 : 1);
+	};
+	minimal = group.getMinimalElements(preferJB);
+	ASSERT_EQ(minimal.size(), 1);
+	ASSERT_EQ(minimal[0].indexSequence, ct::IndexList({ idx("j+"), idx("i+"), idx("b"), idx("a") }));
+	ASSERT_EQ(minimal[0].factor, 1);
+
+	// Only prefer j: the order of a and b is left open
+	minimal = group.getMinimalElements([](const ct::IndexList &current, std::size_t slot) {
+		return std::uint64_t(current[slot] == idx("j+") ? 0 : 1);
+	});
+	ASSERT_EQ(minimal.size(), 2);
+	for (const ct::PermutationGroup::Element &currentElement : minimal) {
+		ASSERT_EQ(currentElement.indexSequence[0], idx("j+"));
+		ASSERT_EQ(group.getFactor(currentElement.indexSequence), currentElement.factor);
+	}
+}
+
+TEST(PermutationGroupTest, slotDescription) {
+	ct::IndexList sequence = { idx("i+"), idx("j+"), idx("a"), idx("b") };
+	ct::IndexSubstitution occupiedAntisymmetry =
+		ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } }, -1);
+	ct::IndexSubstitution virtualAntisymmetry =
+		ct::IndexSubstitution::createPermutation({ { idx("a"), idx("b") } }, -1);
+	ct::IndexSubstitution columnSymmetry =
+		ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") }, { idx("a"), idx("b") } });
+
+	ct::PermutationGroup first(sequence);
+	first.addGenerator(occupiedAntisymmetry);
+	first.addGenerator(virtualAntisymmetry);
+
+	// The same group, generated differently
+	ct::PermutationGroup second(sequence);
+	second.addGenerator(occupiedAntisymmetry);
+	second.addGenerator(columnSymmetry);
+
+	ASSERT_TRUE(first.getSlotDescription().has_value());
+	ASSERT_EQ(first.getSlotDescription(), second.getSlotDescription());
+
+	// The description doesn't depend on which of the reachable sequences is used as the root
+	ct::IndexList reachable = sequence;
+	occupiedAntisymmetry.apply(reachable);
+	second.setRootSequence(reachable);
+	ASSERT_EQ(first.getSlotDescription(), second.getSlotDescription());
+
+	// Same permutations, but a different sign
+	ct::PermutationGroup symmetric(sequence);
+	symmetric.addGenerator(ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } }, 1));
+	symmetric.addGenerator(virtualAntisymmetry);
+	ASSERT_EQ(symmetric.size(), first.size());
+	ASSERT_NE(symmetric.getSlotDescription(), first.getSlotDescription());
+
+	// Same size, but different permutations
+	ct::PermutationGroup column(sequence);
+	column.addGenerator(columnSymmetry);
+	ct::PermutationGroup occupied(sequence);
+	occupied.addGenerator(occupiedAntisymmetry);
+	ASSERT_EQ(column.size(), occupied.size());
+	ASSERT_NE(column.getSlotDescription(), occupied.getSlotDescription());
+}
@@ -0,0 +1,99 @@
+#include "terms/IndexSubstitution.hpp"
+#include "terms/SlotPermutation.hpp"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+
+#include "IndexHelper.hpp"
+
+namespace ct = Contractor::Terms;
+
+TEST(SlotPermutationTest, arithmetic) {
+	const ct::SlotPermutation identity(3);
+	const ct::SlotPermutation cycle({ 1, 2, 0 });
+	const ct::SlotPermutation exchange({ 1, 0, 2 }, -1);
+
+	ASSERT_TRUE(identity.isIdentity());
+	ASSERT_FALSE(cycle.isIdentity());
+	ASSERT_FALSE(ct::SlotPermutation(3, -1).isIdentity());
+	ASSERT_EQ(cycle.getRank(), 3);
+
+	ASSERT_EQ(cycle * cycle * cycle, identity);
+	ASSERT_EQ(cycle * cycle.inverse(), identity);
+	ASSERT_EQ(exchange * exchange, identity);
+	ASSERT_EQ(exchange.inverse(), exchange);
+
+	// Apply exchange first, then cycle: 0 -> 1 -> 2, 1 -> 0 -> 1, 2 -> 2 -> 0
+	ASSERT_EQ(cycle * exchange, ct::SlotPermutation({ 2, 1, 0 }, -1));
+	ASSERT_NE(cycle * exchange, exchange * cycle);
+
+	ASSERT_NE(exchange, ct::SlotPermutation({ 1, 0, 2 }, 1));
+	ASSERT_NE(std::hash< ct::SlotPermutation >{}(exchange),
+			  std::hash< ct::SlotPermutation >{}(ct::SlotPermutation({ 1, 0, 2 }, 1)));
+	ASSERT_EQ(std::hash< ct::SlotPermutation >{}(cycle * cycle), std::hash< ct::SlotPermutation >{}(cycle.inverse()));
+}
+
+TEST(SlotPermutationTest, apply) {
+	ct::IndexList sequence = { idx("i+"), idx("j+"), idx("a-"), idx("b-") };
+
+	ct::IndexList permuted = sequence;
+	ASSERT_EQ(ct::SlotPermutation({ 1, 0, 3, 2 }, -1).apply(permuted), -1);
+	ASSERT_EQ(permuted, ct::IndexList({ idx("j+"), idx("i+"), idx("b-"), idx("a-") }));
+
+	// The type of the index in every slot remains the same
+	permuted = sequence;
+	ct::SlotPermutation({ 2, 3, 0, 1 }).apply(permuted);
+	ASSERT_EQ(permuted, ct::IndexList({ idx("a+"), idx("b+"), idx("i-"), idx("j-") }));
+
+	// Applying p and then q is the same as applying p * q
+	const ct::SlotPermutation p({ 1, 2, 0, 3 });
+	const ct::SlotPermutation q({ 0, 1, 3, 2 });
+	ct::IndexList sequential = sequence;
+	p.apply(sequential);
+	q.apply(sequential);
+	ct::IndexList combined = sequence;
+	(p * q).apply(combined);
+	ASSERT_EQ(sequential, combined);
+}
+
+TEST(SlotPermutationTest, substitutionAdapter) {
+	ct::IndexList reference = { idx("i+"), idx("j+"), idx("a-"), idx("b-") };
+
+	ct::IndexSubstitution antisymmetry = ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } }, -1);
+	ct::IndexSubstitution columnSymmetry =
+		ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") }, { idx("a"), idx("b") } });
+
+	auto antisymmetryPermutation = ct::SlotPermutation::fromSubstitution(antisymmetry, reference);
+	auto columnPermutation       = ct::SlotPermutation::fromSubstitution(columnSymmetry, reference);
+
+	ASSERT_TRUE(antisymmetryPermutation.has_value());
+	ASSERT_TRUE(columnPermutation.has_value());
+	ASSERT_EQ(*antisymmetryPermutation, ct::SlotPermutation({ 1, 0, 2, 3 }, -1));
+	ASSERT_EQ(*columnPermutation, ct::SlotPermutation({ 1, 0, 3, 2 }, 1));
+
+	// Both representations have the same effect on the reference sequence
+	ct::IndexList substituted = reference;
+	ct::IndexList permuted    = reference;
+	ASSERT_EQ(columnSymmetry.apply(substituted), columnPermutation->apply(permuted));
+	ASSERT_EQ(substituted, permuted);
+
+	// Products are compatible
+	ASSERT_EQ(*ct::SlotPermutation::fromSubstitution(antisymmetry * columnSymmetry, reference),
+			  *antisymmetryPermutation * *columnPermutation);
+
+	// Round trip
+	ASSERT_EQ(antisymmetryPermutation->toSubstitution(reference), antisymmetry);
+	ASSERT_EQ(columnPermutation->toSubstitution(reference), columnSymmetry);
+	ASSERT_TRUE(ct::SlotPermutation(4).toSubstitution(reference).isIdentity());
+
+	// Substitutions that don't apply or that don't merely permute the reference can't be converted
+	ASSERT_FALSE(ct::SlotPermutation::fromSubstitution(
+					 ct::IndexSubstitution::createPermutation({ { idx("i"), idx("k") } }), reference)
+					 .has_value());
+	ASSERT_FALSE(
+		ct::SlotPermutation::fromSubstitution(ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } }, 2),
+											  reference)
+			.has_value());
+	ASSERT_FALSE(ct::SlotPermutation::fromSubstitution(antisymmetry, { idx("i+"), idx("j+"), idx("i-") }).has_value());
+}
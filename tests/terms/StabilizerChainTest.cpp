@@ -0,0 +1,223 @@
+#include "terms/StabilizerChain.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <vector>
+
+namespace ct = Contractor::Terms;
+
+using permutation_t = ct::StabilizerChain::permutation_t;
+
+/**
+ * Generates all elements of the group spanned by the given generators by brute force
+ */
+std::set< std::vector< ct::StabilizerChain::point_t > > closure(const std::vector< permutation_t > &generators,
+																std::size_t degree) {
+	std::set< std::vector< ct::StabilizerChain::point_t > > elements;
+	std::vector< permutation_t > queue = { ct::StabilizerChain::identity(degree) };
+
+	while (!queue.empty()) {
+		permutation_t current = queue.back();
+		queue.pop_back();
+
+		if (!elements.insert({ current.begin(), current.end() }).second) {
+			continue;
+		}
+
+		for (const permutation_t &currentGenerator : generators) {
+			queue.push_back(ct::StabilizerChain::multiply(currentGenerator, current));
+		}
+	}
+
+	return elements;
+}
+
+TEST(StabilizerChainTest, arithmetic) {
+	const permutation_t cycle = { 1, 2, 0 };
+	const permutation_t swap  = { 1, 0, 2 };
+
+	ASSERT_EQ(ct::StabilizerChain::identity(3), permutation_t({ 0, 1, 2 }));
+	ASSERT_EQ(ct::StabilizerChain::multiply(cycle, ct::StabilizerChain::invert(cycle)),
+			  ct::StabilizerChain::identity(3));
+	// Apply swap first, then cycle: 0 -> 1 -> 2, 1 -> 0 -> 1, 2 -> 2 -> 0
+	ASSERT_EQ(ct::StabilizerChain::multiply(cycle, swap), permutation_t({ 2, 1, 0 }));
+}
+
+TEST(StabilizerChainTest, order) {
+	{
+		ct::StabilizerChain trivial(5);
+
+		ASSERT_EQ(trivial.order(), 1);
+		ASSERT_TRUE(trivial.contains(ct::StabilizerChain::identity(5)));
+		ASSERT_FALSE(trivial.contains({ 1, 0, 2, 3, 4 }));
+	}
+	{
+		// The symmetric group S4 generated by a transposition and a 4-cycle
+		ct::StabilizerChain group(4);
+
+		ASSERT_TRUE(group.addGenerator({ 1, 0, 2, 3 }));
+		ASSERT_TRUE(group.addGenerator({ 1, 2, 3, 0 }));
+		// Already contained
+		ASSERT_FALSE(group.addGenerator({ 0, 1, 3, 2 }));
+
+		ASSERT_EQ(group.order(), 24);
+	}
+	{
+		// A cyclic group of order 5
+		ct::StabilizerChain group(5);
+		group.addGenerator({ 1, 2, 3, 4, 0 });
+
+		ASSERT_EQ(group.order(), 5);
+		ASSERT_TRUE(group.contains({ 2, 3, 4, 0, 1 }));
+		ASSERT_FALSE(group.contains({ 1, 0, 2, 3, 4 }));
+	}
+	{
+		// Two independent transpositions
+		ct::StabilizerChain group(6);
+		group.addGenerator({ 1, 0, 2, 3, 4, 5 });
+		group.addGenerator({ 0, 1, 2, 3, 5, 4 });
+
+		ASSERT_EQ(group.order(), 4);
+		ASSERT_TRUE(group.contains({ 1, 0, 2, 3, 5, 4 }));
+		ASSERT_FALSE(group.contains({ 0, 1, 3, 2, 4, 5 }));
+	}
+}
+
+TEST(StabilizerChainTest, againstBruteForce) {
+	const std::vector< std::vector< permutation_t > > generatorSets = {
+		// Exchange of index pairs (e.g. (ia) <-> (jb)) together with the antisymmetry within pairs
+		{ { 1, 0, 3, 2, 4, 5 }, { 2, 1, 0, 3, 5, 4 }, { 0, 3, 2, 1, 5, 4 } },
+		// The dihedral group of a hexagon
+		{ { 1, 2, 3, 4, 5, 0 }, { 5, 4, 3, 2, 1, 0 } },
+		// The alternating group A5 (generated by two 3-cycles on overlapping points)
+		{ { 1, 2, 0, 3, 4 }, { 0, 1, 3, 4, 2 }, { 0, 2, 3, 1, 4 } },
+	};
+
+	for (const std::vector< permutation_t > &currentGenerators : generatorSets) {
+		const std::size_t degree = currentGenerators.front().size();
+
+		ct::StabilizerChain group(degree);
+		for (const permutation_t &currentGenerator : currentGenerators) {
+			group.addGenerator(currentGenerator);
+		}
+
+		const auto expectedElements = closure(currentGenerators, degree);
+
+		ASSERT_EQ(group.order(), expectedElements.size());
+
+		std::set< std::vector< ct::StabilizerChain::point_t > > elements;
+		group.forEachElement([&](const permutation_t &current) {
+			ASSERT_TRUE(group.contains(current));
+			elements.insert({ current.begin(), current.end() });
+		});
+
+		ASSERT_EQ(elements, expectedElements);
+
+		// The minimal element with respect to the reversed order of points maps the first point onto the largest
+		// possible one, etc.
+		const permutation_t minimal = group.findMinimalElement(std::greater< ct::StabilizerChain::point_t >{});
+		const auto expectedMinimal =
+			std::max_element(expectedElements.begin(), expectedElements.end());
+
+		ASSERT_EQ(std::vector< ct::StabilizerChain::point_t >(minimal.begin(), minimal.end()), *expectedMinimal);
+	}
+}
+
+TEST(StabilizerChainTest, minimalElements) {
+	const std::vector< std::vector< permutation_t > > generatorSets = {
+		{ { 1, 0, 3, 2, 4, 5 }, { 2, 1, 0, 3, 5, 4 }, { 0, 3, 2, 1, 5, 4 } },
+		{ { 1, 2, 3, 4, 5, 0 }, { 5, 4, 3, 2, 1, 0 } },
+		{ { 1, 0, 2, 3, 4, 5 }, { 1, 2, 3, 4, 5, 0 } },
+	};
+	// Several points share the same weight, such that there are ties to be resolved by later positions
+	const std::vector< std::uint64_t > weights = { 1, 0, 1, 0, 2, 0 };
+
+	// The first value function only depends on the image of the given position, the second one also on the image of
+	// the previous position
+	const std::vector< std::function< std::uint64_t(const permutation_t &, std::size_t) > > valueFunctions = {
+		[&](const permutation_t &element, std::size_t position) { return weights[element[position]]; },
+		[&](const permutation_t &element, std::size_t position) -> std::uint64_t {
+			if (position == 0) {
+				return weights[element[0]];
+			}
+
+			return (weights[element[position]] + element[position - 1]) % 3;
+		},
+	};
+
+	for (const std::vector< permutation_t > &currentGenerators : generatorSets) {
+		const std::size_t degree = currentGenerators.front().size();
+
+		ct::StabilizerChain group(degree);
+		for (const permutation_t &currentGenerator : currentGenerators) {
+			group.addGenerator(currentGenerator);
+		}
+
+		for (const auto &currentValue : valueFunctions) {
+			auto getValues = [&](const permutation_t &element) {
+				std::vector< std::uint64_t > values;
+				for (std::size_t i = 0; i < degree; ++i) {
+					values.push_back(currentValue(element, i));
+				}
+
+				return values;
+			};
+
+			std::vector< std::uint64_t > minimalValues;
+			std::set< std::vector< ct::StabilizerChain::point_t > > expectedElements;
+			for (const std::vector< ct::StabilizerChain::point_t > &current : closure(currentGenerators, degree)) {
+				const std::vector< std::uint64_t > values = getValues(permutation_t(current.begin(), current.end()));
+
+				if (expectedElements.empty() || values < minimalValues) {
+					expectedElements.clear();
+					minimalValues = values;
+				} else if (values > minimalValues) {
+					continue;
+				}
+
+				expectedElements.insert(current);
+			}
+
+			const std::vector< permutation_t > minimal = group.findMinimalElements(currentValue);
+
+			std::set< std::vector< ct::StabilizerChain::point_t > > elements;
+			for (const permutation_t &current : minimal) {
+				ASSERT_EQ(getValues(current), minimalValues);
+				elements.insert({ current.begin(), current.end() });
+			}
+
+			ASSERT_EQ(minimal.size(), elements.size());
+			ASSERT_EQ(elements, expectedElements);
+		}
+	}
+}
+
+TEST(StabilizerChainTest, canonicalTransversals) {
+	// S4 generated by a transposition and a 4-cycle vs. generated by all adjacent transpositions
+	ct::StabilizerChain first(4);
+	first.addGenerator({ 1, 0, 2, 3 });
+	first.addGenerator({ 1, 2, 3, 0 });
+
+	ct::StabilizerChain second(4);
+	second.addGenerator({ 0, 1, 3, 2 });
+	second.addGenerator({ 0, 2, 1, 3 });
+	second.addGenerator({ 1, 0, 2, 3 });
+
+	ASSERT_EQ(first.getCanonicalTransversals(), second.getCanonicalTransversals());
+
+	// The Klein four-group generated by different pairs of its elements
+	ct::StabilizerChain third(4);
+	third.addGenerator({ 1, 0, 3, 2 });
+	third.addGenerator({ 2, 3, 0, 1 });
+
+	ct::StabilizerChain fourth(4);
+	fourth.addGenerator({ 3, 2, 1, 0 });
+	fourth.addGenerator({ 1, 0, 3, 2 });
+
+	ASSERT_EQ(third.getCanonicalTransversals(), fourth.getCanonicalTransversals());
+	ASSERT_NE(first.getCanonicalTransversals(), third.getCanonicalTransversals());
+}
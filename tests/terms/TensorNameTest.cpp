@@ -0,0 +1,49 @@
+#include "terms/TensorName.hpp"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace ct = Contractor::Terms;
+
+TEST(TensorNameTest, interning) {
+	const ct::TensorName name("H");
+	std::string otherString = "H";
+	const ct::TensorName other(otherString);
+
+	ASSERT_EQ(name, other);
+	ASSERT_EQ(name.str(), "H");
+	// The interned name doesn't depend on the lifetime of the string it has been created from
+	otherString = "T2";
+	ASSERT_EQ(other.str(), "H");
+	ASSERT_EQ(name.str().data(), other.str().data());
+
+	ASSERT_NE(name, ct::TensorName("T2"));
+	ASSERT_EQ(ct::TensorName(), ct::TensorName(""));
+	ASSERT_EQ(ct::TensorName().str(), "");
+
+	ASSERT_EQ(name.hash(), std::hash< std::string_view >{}("H"));
+	ASSERT_EQ(std::hash< ct::TensorName >{}(name), name.hash());
+}
+
+TEST(TensorNameTest, ordering) {
+	const ct::TensorName first("H");
+	const ct::TensorName second("T2");
+
+	// Names are ordered alphabetically, regardless of the order in which they have been interned
+	ASSERT_LT(ct::TensorName("A"), ct::TensorName("Aa"));
+	ASSERT_LT(first, second);
+	ASSERT_FALSE(second < first);
+	ASSERT_FALSE(first < first);
+}
+
+TEST(TensorNameTest, join) {
+	const ct::TensorName H("H");
+	const ct::TensorName T2("T2");
+
+	ASSERT_EQ(ct::TensorName::join(H, T2), ct::TensorName("H_T2"));
+	ASSERT_EQ(ct::TensorName::join(T2, H), ct::TensorName("H_T2"));
+	ASSERT_EQ(ct::TensorName::join(ct::TensorName::join(T2, H), ct::TensorName("T1")), ct::TensorName("H_T2_T1"));
+}
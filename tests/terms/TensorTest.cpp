@@ -612,6 +612,82 @@ TEST(TensorTest, contractWithSymmetry) {
 	}
 }
 
+TEST(TensorTest, contractSymmetryReducedCost) {
+	ct::ContractionResult::cost_t occupiedSize = resolver.getMeta(idx("i").getSpace()).getSize();
+	ct::ContractionResult::cost_t virtualSize  = resolver.getMeta(idx("a").getSpace()).getSize();
+
+	ct::IndexSubstitution permAB = ct::IndexSubstitution::createPermutation({ { idx("a"), idx("b") } }, -1);
+	ct::IndexSubstitution permCD = ct::IndexSubstitution::createPermutation({ { idx("c"), idx("d") } }, -1);
+	ct::IndexSubstitution permIJ = ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } }, -1);
+
+	ct::Tensor T("T", { idx("c+"), idx("d+"), idx("i"), idx("j") });
+	ct::PermutationGroup symT(T.getIndices());
+	symT.addGenerator(permCD);
+	symT.addGenerator(permIJ);
+	T.setSymmetry(symT);
+
+	const ct::ContractionResult::cost_t denseCost = pow(virtualSize, 4) * pow(occupiedSize, 2);
+	{
+		// Without any symmetry, there is nothing to be saved
+		ct::Tensor V("V", { idx("a+"), idx("b+"), idx("c"), idx("d") });
+		ct::Tensor W("W", { idx("c+"), idx("d+"), idx("i"), idx("j") });
+
+		ct::ContractionResult result = V.contract(W, resolver);
+
+		ASSERT_EQ(result.cost, denseCost);
+		ASSERT_EQ(V.getSymmetryReducedCost(W, result), denseCost);
+	}
+	{
+		// R[ab,ij] = V[ab,cd] T[cd,ij] with both operands being antisymmetric in c <-> d: Only a quarter of the result
+		// is unique and only half of the summation has to be carried out
+		ct::Tensor V("V", { idx("a+"), idx("b+"), idx("c"), idx("d") });
+		ct::PermutationGroup symV(V.getIndices());
+		symV.addGenerator(permAB);
+		symV.addGenerator(permCD);
+		V.setSymmetry(symV);
+
+		ct::ContractionResult result = V.contract(T, resolver);
+
+		ASSERT_EQ(result.cost, denseCost);
+		ASSERT_EQ(V.getSymmetryReducedCost(T, result), denseCost / 8);
+	}
+	{
+		// If only one of the operands is antisymmetric in c <-> d, the summation can't be reduced
+		ct::Tensor V("V", { idx("a+"), idx("b+"), idx("c"), idx("d") });
+		ct::PermutationGroup symV(V.getIndices());
+		symV.addGenerator(permAB);
+		V.setSymmetry(symV);
+
+		ct::ContractionResult result = V.contract(T, resolver);
+
+		ASSERT_EQ(result.cost, denseCost);
+		ASSERT_EQ(V.getSymmetryReducedCost(T, result), denseCost / 4);
+	}
+	{
+		// R[ab,ij] = V[ab,cd] W[cd,ij] where W's antisymmetry in c <-> d is only the product of its generators. The
+		// reduction of the summation must not depend on which operand comes first.
+		ct::Tensor V("V", { idx("a+"), idx("b+"), idx("c"), idx("d") });
+		ct::PermutationGroup symV(V.getIndices());
+		symV.addGenerator(permCD);
+		V.setSymmetry(symV);
+
+		ct::Tensor W("W", { idx("c+"), idx("d+"), idx("i"), idx("j") });
+		ct::PermutationGroup symW(W.getIndices());
+		symW.addGenerator(ct::IndexSubstitution::createPermutation({ { idx("c"), idx("d") }, { idx("i"), idx("j") } }));
+		symW.addGenerator(permIJ);
+		W.setSymmetry(symW);
+
+		ct::ContractionResult result        = V.contract(W, resolver);
+		ct::ContractionResult swappedResult = W.contract(V, resolver);
+
+		ASSERT_EQ(result.cost, denseCost);
+		ASSERT_EQ(swappedResult.cost, denseCost);
+		ASSERT_EQ(result.resultTensor.getSymmetry().size(), swappedResult.resultTensor.getSymmetry().size());
+		ASSERT_EQ(V.getSymmetryReducedCost(W, result), denseCost / (2 * result.resultTensor.getSymmetry().size()));
+		ASSERT_EQ(W.getSymmetryReducedCost(V, swappedResult), V.getSymmetryReducedCost(W, result));
+	}
+}
+
 TEST(TensorTest, antisymmetric) {
 	{
 		// There are no exchanges possible and thus 100% of all exchanges are allowed
@@ -715,3 +791,54 @@ TEST(TensorTest, canonicalizeIndices) {
 		ASSERT_THAT(tensor.getIndices(), ::testing::ElementsAre(idx("a+"), idx("b+")));
 	}
 }
+
+TEST(TensorTest, cachedHash) {
+	ct::Tensor tensor("T", { idx("i+"), idx("j+"), idx("a-"), idx("b-") });
+	tensor.accessSymmetry().addGenerator(ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } }, -1));
+
+	const std::size_t hash        = tensor.getHash();
+	const std::size_t elementHash = tensor.getElementHash();
+	ASSERT_EQ(std::hash< ct::Tensor >{}(tensor), hash);
+	ASSERT_EQ(ct::Tensor::tensor_element_hash{}(tensor), elementHash);
+
+	// Symmetry-equivalent index sequences don't change the hashes
+	ct::Tensor permuted = tensor;
+	permuted.setIndexSequence({ idx("j+"), idx("i+"), idx("a-"), idx("b-") });
+	ASSERT_EQ(permuted.getHash(), hash);
+	ASSERT_EQ(permuted.getElementHash(), elementHash);
+
+	// Modifications update the hashes
+	ct::Tensor renamed = tensor;
+	renamed.setName("U");
+	ASSERT_NE(renamed, tensor);
+	ASSERT_NE(renamed.getHash(), hash);
+	ASSERT_NE(renamed.getElementHash(), elementHash);
+
+	ct::Tensor relabeled                       = tensor;
+	ct::Tensor::index_list_t relabeledIndices = tensor.getIndices();
+	relabeledIndices[2]                        = idx("c-");
+	ct::PermutationGroup relabeledSymmetry(relabeledIndices);
+	relabeledSymmetry.addGenerator(ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } }, -1));
+	relabeled.setIndices(relabeledIndices, relabeledSymmetry);
+	ASSERT_NE(relabeled.getHash(), hash);
+	ASSERT_EQ(relabeled.getElementHash(), elementHash);
+	ASSERT_NE(relabeled, tensor);
+	ASSERT_TRUE(relabeled.refersToSameElement(tensor));
+
+	ct::Tensor unsymmetric = tensor;
+	unsymmetric.setSymmetry(ct::PermutationGroup(tensor.getIndices()));
+	ASSERT_NE(unsymmetric.getHash(), hash);
+	ASSERT_NE(unsymmetric, tensor);
+	ASSERT_FALSE(unsymmetric.refersToSameElement(tensor));
+
+	// Modifying the symmetry in place updates the hashes as well
+	unsymmetric.accessSymmetry().addGenerator(ct::IndexSubstitution::createPermutation({ { idx("i"), idx("j") } }, -1));
+	ASSERT_EQ(unsymmetric.getHash(), hash);
+	ASSERT_EQ(unsymmetric, tensor);
+
+	// Obtaining the hashes doesn't modify a Tensor and neither does reading its indices through a non-const Tensor
+	ct::Tensor copy = tensor;
+	ASSERT_EQ(copy.getIndices(), tensor.getIndices());
+	ASSERT_EQ(copy.getHash(), hash);
+	ASSERT_EQ(copy.getElementHash(), elementHash);
+}
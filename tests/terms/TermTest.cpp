@@ -24,8 +24,12 @@ struct DummyTerm : public ct::Term {
 
 	virtual std::size_t size() const override { return m_tensors.size(); }
 
-	virtual const ct::Tensor &get(std::size_t index) const override { return m_tensors[index]; }
-	virtual ct::Tensor &get(std::size_t index) override { return m_tensors[index]; }
+	virtual Contractor::Span< const ct::Tensor > getTensorStorage() const override {
+		return Contractor::Span< const ct::Tensor >(m_tensors.data(), m_tensors.size());
+	}
+	virtual Contractor::Span< ct::Tensor > accessTensorStorage() override {
+		return Contractor::Span< ct::Tensor >(m_tensors.data(), m_tensors.size());
+	}
 
 	virtual void sort() override {}
 
@@ -109,3 +109,24 @@ TEST(IteratorTest, iterator_compare) {
 
 	ASSERT_EQ(it, iterable1.end());
 }
+
+TEST(IteratorTest, from_span) {
+	std::vector< std::string > vec = { "0", "1", "2" };
+
+	Contractor::Span< std::string > span(vec.data(), vec.size());
+	Contractor::Span< const std::string > constSpan = span;
+	ASSERT_EQ(constSpan.size(), vec.size());
+	ASSERT_EQ(constSpan.begin(), span.begin());
+	ASSERT_EQ(span[2], "2");
+
+	Contractor::Iterable< std::string > iterable = span;
+
+	std::size_t index = 0;
+	for (std::string &current : iterable) {
+		ASSERT_EQ(current, std::to_string(index));
+		current += "x";
+		index++;
+	}
+	ASSERT_EQ(index, vec.size());
+	ASSERT_EQ(vec[1], "1x");
+}
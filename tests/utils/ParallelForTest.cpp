@@ -0,0 +1,46 @@
+#include "utils/ParallelFor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace cu = Contractor::Utils;
+
+TEST(ParallelForTest, processesEveryIndexOnce) {
+	for (std::size_t jobs : { 0, 1, 2, 4, 32 }) {
+		std::vector< std::atomic< int > > counts(17);
+
+		cu::parallelFor(counts.size(), jobs, [&](std::size_t index, std::size_t threadIndex) {
+			ASSERT_LT(threadIndex, std::max< std::size_t >(jobs, 1));
+
+			counts[index]++;
+		});
+
+		for (const std::atomic< int > &currentCount : counts) {
+			ASSERT_EQ(currentCount, 1);
+		}
+	}
+}
+
+TEST(ParallelForTest, serialExecutionIsOrdered) {
+	std::vector< std::size_t > order;
+
+	cu::parallelFor(5, 1, [&](std::size_t index, std::size_t) { order.push_back(index); });
+
+	ASSERT_EQ(order, std::vector< std::size_t >({ 0, 1, 2, 3, 4 }));
+}
+
+TEST(ParallelForTest, propagatesExceptions) {
+	for (std::size_t jobs : { 1, 4 }) {
+		ASSERT_THROW(cu::parallelFor(10, jobs,
+									 [](std::size_t index, std::size_t) {
+										 if (index == 3) {
+											 throw std::runtime_error("Test");
+										 }
+									 }),
+					 std::runtime_error);
+	}
+}